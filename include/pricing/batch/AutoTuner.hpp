@@ -0,0 +1,65 @@
+#ifndef PRICING_BATCH_AUTO_TUNER_HPP
+#define PRICING_BATCH_AUTO_TUNER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "BatchEngine.hpp"
+#include "../core/OptionBatch.hpp"
+
+namespace pricing {
+namespace batch {
+
+// Batch engine configuration measured to be fastest on one host
+struct TuningProfile {
+    unsigned numThreads = 0;
+    std::size_t chunkSize = 4096;
+    BatchKernel kernel = BatchKernel::Grouped;
+    bool reorder = false;
+    double rowsPerSecond = 0.0;     // Calibration throughput of this configuration
+    std::string host;               // Host the profile was calibrated on
+    unsigned hardwareThreads = 0;
+
+    void apply(BatchSettings& settings) const;
+    // True if calibrated on a host with this name and core count
+    bool matchesHost() const;
+
+    // Plain key=value text, so profiles can be inspected and edited
+    void save(const std::string& path) const;
+    static TuningProfile load(const std::string& path);
+};
+
+struct AutotuneSettings {
+    std::size_t rows = 200000;      // Synthetic rows priced per trial
+    std::size_t repetitions = 3;    // Best time of this many runs per configuration
+    bool withGreeks = true;
+    std::uint32_t seed = 1;
+};
+
+// Short calibration of the batch engine on synthetic option chains.
+// Coordinate search: kernel and reordering at full parallelism first, then
+// the thread count, then the chunk size, each keeping the best so far.
+class AutoTuner {
+public:
+    explicit AutoTuner(const AutotuneSettings& settings = AutotuneSettings());
+
+    TuningProfile calibrate() const;
+
+    // Unordered chains on a few underlyings with shared maturities, the
+    // shape of a typical batch file
+    static core::OptionBatch syntheticBatch(std::size_t rows, std::uint32_t seed);
+
+    static std::string hostName();
+
+private:
+    void validate() const;
+    double throughput(const core::OptionBatch& batch, const BatchSettings& settings) const;
+
+    AutotuneSettings settings_;
+};
+
+} // namespace batch
+} // namespace pricing
+
+#endif // PRICING_BATCH_AUTO_TUNER_HPP
@@ -0,0 +1,62 @@
+#ifndef PRICING_BATCH_BATCH_ENGINE_HPP
+#define PRICING_BATCH_BATCH_ENGINE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "ExternalSorter.hpp"
+#include "../core/OptionBatch.hpp"
+#include "../core/PricingResult.hpp"
+
+namespace pricing {
+namespace batch {
+
+// Both kernels give identical results; which one is faster depends on the
+// host and on how often consecutive rows share maturity and volatility.
+enum class BatchKernel {
+    Grouped,    // BlackScholesModel::priceBatch, reuses terms shared by consecutive rows
+    PerRow      // BlackScholesModel::price / priceWithGreeks row by row
+};
+
+struct BatchSettings {
+    bool reorder = false;         // Price in (underlying, maturity, strike) order
+    bool withGreeks = false;
+    unsigned numThreads = 0;      // 0 = hardware concurrency
+    std::size_t chunkSize = 4096; // Rows priced per task
+    BatchKernel kernel = BatchKernel::Grouped;
+};
+
+// Prices a batch of European options with the Black-Scholes batch kernel,
+// chunk by chunk in parallel. With reorder, rows are first sorted so that
+// options on one underlying and maturity are adjacent (shared kernel terms,
+// hot caches); results always come back in input order.
+class BatchEngine {
+public:
+    explicit BatchEngine(const BatchSettings& settings = BatchSettings());
+
+    const BatchSettings& getSettings() const { return settings_; }
+
+    std::vector<core::PricingResult> price(const core::OptionBatch& batch) const;
+
+    // Streams the records of a finished sorter through the kernel in sorted
+    // order, numThreads * chunkSize rows at a time, and hands every result to
+    // sink together with its input row. For inputs larger than memory.
+    void priceSorted(ExternalSorter& sorter,
+                     const std::function<void(std::uint64_t row, const core::PricingResult&)>& sink) const;
+
+    // Row permutation sorted by spot (rows of one underlying share it),
+    // then maturity, then strike; ties keep input order.
+    static std::vector<std::uint32_t> localityOrder(const core::OptionBatch& batch, unsigned numThreads = 0);
+
+private:
+    void priceChunks(const core::OptionBatch& batch, core::PricingResult* results) const;
+
+    BatchSettings settings_;
+};
+
+} // namespace batch
+} // namespace pricing
+
+#endif // PRICING_BATCH_BATCH_ENGINE_HPP
@@ -0,0 +1,59 @@
+#ifndef PRICING_BATCH_DELTA_PUBLISHER_HPP
+#define PRICING_BATCH_DELTA_PUBLISHER_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "../core/PricingResult.hpp"
+#include "../util/Hash.hpp"
+
+namespace pricing {
+namespace batch {
+
+struct PublicationSettings {
+    double threshold = 1e-4;    // Absolute change of the price or any Greek that triggers publication
+    bool trackGreeks = true;    // Compare Greeks as well as the price
+};
+
+// Decides which results downstream consumers need to see: a result is
+// published when its instrument is new or when its price or a Greek moved
+// by more than the threshold since the instrument's last publication.
+// Comparing against the last published (not the last computed) values
+// means slow drifts are still published once they add up.
+//
+// State is a flat open-addressing table of instrument hash and published
+// values, persisted between runs with save() and load().
+class DeltaPublisher {
+public:
+    explicit DeltaPublisher(const PublicationSettings& settings = PublicationSettings());
+
+    // Returns true and records the result when it must be published
+    bool update(const util::ContentKey& instrument, const core::PricingResult& result);
+
+    // Replaces the state with the one saved in path; a missing file leaves it empty
+    void load(const std::string& path);
+    void save(const std::string& path) const;
+
+    std::size_t size() const { return count_; }
+
+private:
+    struct Slot {
+        util::ContentKey instrument;   // All-zero key marks an empty slot
+        double values[6];              // Price, delta, gamma, vega, theta, rho
+    };
+
+    static bool isEmpty(const util::ContentKey& key) { return key.low == 0 && key.high == 0; }
+    static util::ContentKey normalize(util::ContentKey key);
+    Slot& slot(const util::ContentKey& instrument);
+    void grow();
+
+    PublicationSettings settings_;
+    std::vector<Slot> slots_;
+    std::size_t count_ = 0;
+};
+
+} // namespace batch
+} // namespace pricing
+
+#endif // PRICING_BATCH_DELTA_PUBLISHER_HPP
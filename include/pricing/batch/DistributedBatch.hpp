@@ -0,0 +1,116 @@
+#ifndef PRICING_BATCH_DISTRIBUTED_BATCH_HPP
+#define PRICING_BATCH_DISTRIBUTED_BATCH_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "BatchEngine.hpp"
+#include "ModelDispatcher.hpp"
+#include "../core/OptionBatch.hpp"
+#include "../core/PricingResult.hpp"
+
+namespace pricing {
+namespace batch {
+
+struct WorkerAddress {
+    std::string host;
+    std::uint16_t port = 0;
+};
+
+// "host:port", or "port" alone with defaultHost. Throws std::invalid_argument.
+WorkerAddress parseWorkerAddress(const std::string& text, const std::string& defaultHost = "127.0.0.1");
+
+struct DistributedSettings {
+    // Largest shard a worker accepts; bounds the frames either side will read
+    static const std::size_t kMaxShardRows = 262144;
+
+    std::size_t shardRows = 65536;  // Rows sent to a worker at a time, at most kMaxShardRows
+    unsigned maxAttempts = 3;       // Workers a shard may fail on before the batch fails
+    // Longest a worker may stay silent, when connecting, sending or waiting
+    // for a shard; 0 = no limit. Workers report progress while pricing, so
+    // this does not bound how long a shard takes.
+    double timeoutSeconds = 30.0;
+
+    void validate() const;
+};
+
+// Prices shards for coordinators over TCP. The protocol has no
+// authentication: listen on loopback or a trusted network only. Frames
+// larger than a shard of kMaxShardRows rows can take are refused before
+// anything is allocated for them. Each shard arrives as one binary
+// frame holding the batch columns and the per-row model and outputs, and is
+// answered with the results of its rows and the messages of rows their
+// model rejected (or an error message for the whole shard) from a
+// ModelDispatcher with the worker's own batch settings. While a shard is
+// priced the worker sends progress frames at the interval the coordinator
+// asked for. Coordinators are
+// served one connection at a time.
+class ShardWorker {
+public:
+    // Binds and listens before returning; port 0 picks a free port
+    ShardWorker(const WorkerAddress& address, const BatchSettings& settings = BatchSettings());
+    ~ShardWorker();
+
+    ShardWorker(const ShardWorker&) = delete;
+    ShardWorker& operator=(const ShardWorker&) = delete;
+
+    std::uint16_t port() const { return port_; }
+
+    // Accepts and serves connections until stop()
+    void serve();
+    // Callable from any thread; drops the current connection
+    void stop();
+
+    std::size_t shardsPriced() const { return shardsPriced_; }
+
+private:
+    void handle(int connection);
+
+    BatchSettings settings_;
+    int listener_ = -1;
+    std::uint16_t port_ = 0;
+    std::atomic<int> connection_{-1};
+    std::atomic<bool> stopping_{false};
+    std::atomic<std::size_t> shardsPriced_{0};
+};
+
+// Splits a batch into shards of shardRows rows and prices them on remote
+// workers, one connection and one shard in flight per worker. The first
+// shards are dealt round-robin, the rest go to whichever worker is free.
+// A worker that cannot be reached, drops its connection, stays silent
+// longer than timeoutSeconds or answers with a malformed frame is retired
+// and its shard is handed to another worker. TCP keepalive also ends
+// connections to dead hosts. Results are merged back in input order.
+//
+// Rows a worker's model rejected get an empty result and, when errors is
+// given, their message, as in ModelDispatcher::price. Throws
+// std::runtime_error when no worker is left, when a shard has failed on
+// maxAttempts workers, or when a worker cannot price a shard at all (which
+// would recur anywhere).
+class ShardCoordinator {
+public:
+    explicit ShardCoordinator(const std::vector<WorkerAddress>& workers,
+                              const DistributedSettings& settings = DistributedSettings());
+
+    std::vector<core::PricingResult> price(const core::OptionBatch& batch,
+                                           const std::vector<RowRequest>& requests,
+                                           std::vector<std::string>* errors = nullptr);
+
+    // Counters of the last price() call
+    std::size_t reassignedShards() const { return reassignedShards_; }
+    std::size_t failedWorkers() const { return failedWorkers_; }
+
+private:
+    std::vector<WorkerAddress> workers_;
+    DistributedSettings settings_;
+    std::size_t reassignedShards_ = 0;
+    std::size_t failedWorkers_ = 0;
+};
+
+} // namespace batch
+} // namespace pricing
+
+#endif // PRICING_BATCH_DISTRIBUTED_BATCH_HPP
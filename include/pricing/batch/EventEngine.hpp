@@ -0,0 +1,101 @@
+#ifndef PRICING_BATCH_EVENT_ENGINE_HPP
+#define PRICING_BATCH_EVENT_ENGINE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "../core/MarketData.hpp"
+#include "../core/Option.hpp"
+#include "../core/PricingResult.hpp"
+
+namespace pricing {
+namespace batch {
+
+struct EventEngineSettings {
+    unsigned shards = 0;                // Worker threads; 0 = hardware concurrency
+    std::size_t tickCapacity = 4096;    // Ticks queued per shard
+    std::size_t quoteCapacity = 65536;  // Quotes waiting for poll() per shard
+    std::size_t maxBatch = 1024;        // Ticks taken per pass before repricing
+    bool withGreeks = true;
+    bool pinThreads = true;             // Worker i runs on the i-th CPU the process may use
+
+    void validate() const;
+};
+
+struct Tick {
+    std::uint32_t underlying = 0;
+    double spot = 0.0;
+};
+
+struct QuoteUpdate {
+    std::size_t option = 0;         // Index returned by addOption
+    std::uint64_t sequence = 0;     // Sequence of the last tick applied, from 1
+    double spot = 0.0;
+    core::PricingResult result;
+};
+
+// Tick-driven repricing on single-writer shards. Underlyings are split over
+// worker threads (underlying % shards); each worker alone owns the option
+// rows of its underlyings, so repricing takes no locks. publish() routes a
+// tick to its shard through a single-producer single-consumer queue; the
+// worker takes up to maxBatch ticks at once, keeps the last spot of every
+// underlying they touch and reprices each such underlying's rows with the
+// Black-Scholes batch kernel, then pushes one QuoteUpdate per option into
+// the shard's output ring for poll().
+//
+// publish() and flush() must be called from one producer thread and poll()
+// from one consumer thread. Quotes of one option arrive in tick order;
+// quotes of different shards are interleaved. Workers poll their queues
+// without sleeping.
+class EventEngine {
+public:
+    explicit EventEngine(const EventEngineSettings& settings = EventEngineSettings());
+    ~EventEngine();
+
+    EventEngine(const EventEngine&) = delete;
+    EventEngine& operator=(const EventEngine&) = delete;
+
+    // European options only; before start()
+    std::size_t addOption(std::uint32_t underlying, const core::Option& option,
+                          const core::MarketData& marketData);
+
+    void start();
+    // Prices the ticks already published, then joins the workers. Quotes that
+    // no longer fit into a full output ring are dropped and counted.
+    void stop();
+
+    // Waits while the shard's tick queue is full
+    void publish(const Tick& tick);
+    // Waits until every published tick is priced and its quotes queued; the
+    // output rings must have room for them
+    void flush();
+
+    // Next queued quote of any shard; false if none is ready
+    bool poll(QuoteUpdate& update);
+
+    unsigned shards() const { return static_cast<unsigned>(shards_.size()); }
+    unsigned shardOf(std::uint32_t underlying) const;
+    std::uint64_t ticksProcessed() const;
+    std::uint64_t droppedQuotes() const;
+
+private:
+    struct Shard;
+
+    void run(Shard& shard);
+
+    EventEngineSettings settings_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::size_t options_ = 0;
+    std::uint64_t sequence_ = 0;    // Producer side
+    std::size_t nextPoll_ = 0;      // Consumer side
+    std::atomic<bool> stopping_{false};
+    bool started_ = false;
+};
+
+} // namespace batch
+} // namespace pricing
+
+#endif // PRICING_BATCH_EVENT_ENGINE_HPP
@@ -0,0 +1,95 @@
+#ifndef PRICING_BATCH_EXTERNAL_SORTER_HPP
+#define PRICING_BATCH_EXTERNAL_SORTER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../core/MarketData.hpp"
+#include "../core/Option.hpp"
+
+namespace pricing {
+namespace batch {
+
+// One batch row as a fixed-size binary record. Records are ordered by key,
+// then by row, so the order is total and runs merge deterministically.
+struct SortRecord {
+    std::uint64_t key[3];   // Compared lexicographically
+    std::uint64_t row;      // Position in the input
+    double spot;
+    double strike;
+    double rate;
+    double volatility;
+    double maturity;
+    std::uint64_t type;     // core::OptionType
+
+    core::Option option() const;
+    core::MarketData marketData() const;
+};
+
+struct ExternalSortSettings {
+    std::size_t memoryLimit = 64u << 20; // Bytes of records held in memory
+    std::size_t mergeFanIn = 64;         // Runs merged at once
+    std::string tempDirectory;           // Empty = $TMPDIR or /tmp
+};
+
+// Sorts more records than fit in memory. Records are buffered up to
+// memoryLimit, sorted and spilled to anonymous temporary files as runs;
+// once mergeFanIn runs of one size exist they are merged into a larger run,
+// so at most a few fan-ins of files are open and every record is rewritten
+// only a logarithmic number of times. After finish() the remaining runs are
+// streamed through a loser-tree k-way merge by next(). Input that fits in
+// memory never touches the disk.
+class ExternalSorter {
+public:
+    explicit ExternalSorter(const ExternalSortSettings& settings = ExternalSortSettings());
+    ~ExternalSorter();
+
+    ExternalSorter(const ExternalSorter&) = delete;
+    ExternalSorter& operator=(const ExternalSorter&) = delete;
+
+    // Record that groups rows by underlying (spot), maturity and strike,
+    // the same order as BatchEngine::localityOrder
+    static SortRecord localityRecord(std::uint64_t row, const core::Option& option,
+                                     const core::MarketData& marketData);
+
+    void add(const SortRecord& record);
+    void finish();
+    // Next record in sorted order; false when all records were returned
+    bool next(SortRecord& record);
+
+    std::size_t size() const { return size_; }
+    std::size_t spilledRuns() const { return spilledRuns_; }
+
+private:
+    struct Run {
+        std::FILE* file;
+        std::uint64_t count;
+        unsigned level;         // Number of merges the records went through
+    };
+    class Merger;
+
+    void validate() const;
+    void spill();
+    void mergeRuns(std::vector<Run> inputs, unsigned level);
+    std::FILE* createTempFile() const;
+    std::size_t readerCapacity() const;
+
+    ExternalSortSettings settings_;
+    std::vector<SortRecord> buffer_;
+    std::size_t bufferCapacity_;
+    std::size_t bufferPosition_ = 0;    // next() position when nothing was spilled
+    std::vector<Run> runs_;
+    std::unique_ptr<Merger> merger_;
+    std::size_t size_ = 0;
+    std::size_t spilledRuns_ = 0;
+    bool finished_ = false;
+};
+
+} // namespace batch
+} // namespace pricing
+
+#endif // PRICING_BATCH_EXTERNAL_SORTER_HPP
@@ -0,0 +1,111 @@
+#ifndef PRICING_BATCH_LIVE_BOOK_STORE_HPP
+#define PRICING_BATCH_LIVE_BOOK_STORE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../core/MarketData.hpp"
+#include "../core/Option.hpp"
+#include "../core/OptionBatch.hpp"
+#include "../core/PricingResult.hpp"
+
+namespace pricing {
+namespace batch {
+
+// Black-Scholes terms of a row that depend only on rate, volatility and
+// maturity: d1 = (log(S / K) + drift) / volSqrtT
+struct RowInvariants {
+    double volSqrtT = 0.0;          // sigma * sqrt(T)
+    double drift = 0.0;             // (r + sigma^2 / 2) * T
+    double discount = 0.0;          // exp(-r T)
+};
+
+// State of a resident pricer kept in a memory-mapped file, so a restarted
+// process maps it and serves at once instead of rebuilding its book. Each
+// row holds a position (underlying, option terms, quantity), its market
+// data and invariants, and the last result with the market snapshot version
+// it was priced at. Writes go straight to the mapping; the kernel flushes
+// them, or sync() does.
+//
+// The header records the layout version and row size. A missing or empty
+// file starts an empty book and restored() is false; any other file that is
+// not a live book of this layout version is refused with std::runtime_error
+// rather than overwritten. The capacity is taken from the file size, so a
+// crash while the file grows keeps the book, and a growth that fails
+// leaves it at its current capacity. Every row write is bracketed
+// by a sequence number, so rows a crashed process left half-written are
+// found on open: they are listed by tornRows() and their results dropped.
+// Positions appended by an interrupted add() are not counted. Not safe for
+// concurrent writers.
+class LiveBookStore {
+public:
+    static const std::uint32_t kLayoutVersion = 1;
+
+    explicit LiveBookStore(const std::string& path, std::size_t initialCapacity = 1024);
+    ~LiveBookStore();
+
+    LiveBookStore(const LiveBookStore&) = delete;
+    LiveBookStore& operator=(const LiveBookStore&) = delete;
+
+    bool restored() const { return restored_; }
+    // Whether the process that last had the file open closed it
+    bool cleanShutdown() const { return cleanShutdown_; }
+    const std::vector<std::size_t>& tornRows() const { return tornRows_; }
+
+    std::size_t add(std::uint32_t underlying, const core::Option& option,
+                    const core::MarketData& marketData, double quantity);
+    void setQuantity(std::size_t row, double quantity);
+    // Recomputes the invariants and drops the result
+    void setMarketData(std::size_t row, const core::MarketData& marketData);
+    // Stamped with the current market version
+    void storeResult(std::size_t row, const core::PricingResult& result);
+
+    std::size_t size() const;
+    std::size_t capacity() const;
+    std::uint32_t underlying(std::size_t row) const;
+    core::Option option(std::size_t row) const;
+    core::MarketData marketData(std::size_t row) const;
+    double quantity(std::size_t row) const;
+    RowInvariants invariants(std::size_t row) const;
+    // False if the row has no result since its last market data change
+    bool result(std::size_t row, core::PricingResult& result, std::uint64_t* version = nullptr) const;
+
+    // Rows [begin, end) for the batch kernels
+    core::OptionBatch batch(std::size_t begin, std::size_t end) const;
+
+    std::uint64_t marketVersion() const;
+    void setMarketVersion(std::uint64_t version);
+
+    // Writes dirty pages back to the file (msync)
+    void sync();
+
+private:
+    struct Header;
+    struct Row;
+
+    void open(std::size_t initialCapacity);
+    void attach(int fd, std::size_t initialCapacity);
+    void create(int fd, std::size_t capacity);
+    void* map(int fd, std::size_t length) const;
+    void unmap();
+    void grow();
+    void recover();
+    Header* header() const;
+    Row& row(std::size_t index) const;
+    Row& beginWrite(std::size_t index);
+    void endWrite(Row& row);
+
+    std::string path_;
+    void* mapping_ = nullptr;
+    std::size_t length_ = 0;
+    bool restored_ = false;
+    bool cleanShutdown_ = false;
+    std::vector<std::size_t> tornRows_;
+};
+
+} // namespace batch
+} // namespace pricing
+
+#endif // PRICING_BATCH_LIVE_BOOK_STORE_HPP
@@ -0,0 +1,53 @@
+#ifndef PRICING_BATCH_MODEL_COMPARISON_HPP
+#define PRICING_BATCH_MODEL_COMPARISON_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "BatchEngine.hpp"
+#include "../core/HestonParameters.hpp"
+#include "../core/OptionBatch.hpp"
+#include "../core/PricingResult.hpp"
+#include "../models/PricingModel.hpp"
+
+namespace pricing {
+namespace batch {
+
+// One column of a model comparison
+struct ComparedModel {
+    std::string label;                                  // e.g. "binomial_american"
+    std::shared_ptr<const models::PricingModel> model;
+    core::ExerciseStyle exercise = core::ExerciseStyle::European;
+};
+
+// Prices every row of one batch with several models. All models read the
+// same structure-of-arrays batch; the work is split into (model, row range)
+// tasks that run concurrently, slow numerical models first. Black-Scholes
+// columns use the batch kernel with its shared per-maturity terms.
+class ModelComparison {
+public:
+    explicit ModelComparison(std::vector<ComparedModel> models,
+                             const BatchSettings& settings = BatchSettings());
+
+    // "name" or "name:american", name as in models::modelNames() or "heston".
+    // American exercise is available for binomial and finite_difference;
+    // heston needs parameters. Throws std::invalid_argument otherwise.
+    static ComparedModel fromSpec(const std::string& spec,
+                                  const core::HestonParameters* heston = nullptr);
+
+    const std::vector<ComparedModel>& models() const { return models_; }
+
+    // results[m][i]: row i priced by models()[m]. Rows a model rejects
+    // (e.g. zero volatility in a tree) get a NaN price.
+    std::vector<std::vector<core::PricingResult>> price(const core::OptionBatch& batch) const;
+
+private:
+    std::vector<ComparedModel> models_;
+    BatchSettings settings_;
+};
+
+} // namespace batch
+} // namespace pricing
+
+#endif // PRICING_BATCH_MODEL_COMPARISON_HPP
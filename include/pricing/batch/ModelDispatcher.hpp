@@ -0,0 +1,62 @@
+#ifndef PRICING_BATCH_MODEL_DISPATCHER_HPP
+#define PRICING_BATCH_MODEL_DISPATCHER_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "BatchEngine.hpp"
+#include "../core/OptionBatch.hpp"
+#include "../core/PricingResult.hpp"
+
+namespace pricing {
+namespace batch {
+
+// Results a row asks for, as a bit set
+enum OutputFlags : unsigned {
+    OutputPrice = 1u << 0,
+    OutputDelta = 1u << 1,
+    OutputGamma = 1u << 2,
+    OutputVega = 1u << 3,
+    OutputTheta = 1u << 4,
+    OutputRho = 1u << 5,
+    OutputGreeks = OutputDelta | OutputGamma | OutputVega | OutputTheta | OutputRho,
+    OutputAll = OutputPrice | OutputGreeks
+};
+
+// "price|delta|gamma", "greeks" or "all"; the price is always included.
+// Throws std::invalid_argument for unknown names.
+unsigned parseOutputs(const std::string& text);
+
+// Model and outputs of one batch row
+struct RowRequest {
+    std::string model = "black_scholes";
+    unsigned outputs = OutputPrice;
+
+    bool needsGreeks() const { return (outputs & OutputGreeks) != 0; }
+};
+
+// Prices a batch whose rows ask for different models and outputs in one
+// pass. Rows are partitioned into groups of one model and Greek setting;
+// Black-Scholes groups go through the batch kernel, other models price
+// their rows in parallel, one model instance per group.
+class ModelDispatcher {
+public:
+    explicit ModelDispatcher(const BatchSettings& settings = BatchSettings());
+
+    // Results in input order. Unknown models throw std::invalid_argument
+    // before any row is priced. A row its model rejects (e.g. zero
+    // volatility in a tree) gets an empty result; when errors is given it
+    // receives one message per row, empty for rows that were priced.
+    std::vector<core::PricingResult> price(const core::OptionBatch& batch,
+                                           const std::vector<RowRequest>& requests,
+                                           std::vector<std::string>* errors = nullptr) const;
+
+private:
+    BatchSettings settings_;
+};
+
+} // namespace batch
+} // namespace pricing
+
+#endif // PRICING_BATCH_MODEL_DISPATCHER_HPP
@@ -0,0 +1,77 @@
+#ifndef PRICING_BATCH_RESULT_CACHE_HPP
+#define PRICING_BATCH_RESULT_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "../core/PricingResult.hpp"
+#include "../util/Hash.hpp"
+
+namespace pricing {
+namespace batch {
+
+struct ResultCacheSettings {
+    std::size_t maxEntries = 1000000;   // Least recently used runs are evicted beyond this
+    std::size_t initialCapacity = 1024; // Slots of a new file; grows by doubling
+};
+
+// Persistent price/Greeks cache keyed by a content hash of the normalized
+// pricing inputs. The file is an open-addressing hash table mapped into
+// memory, so lookups in a warm run touch only the pages they need.
+//
+// Every open starts a new generation; entries remember the generation that
+// last used them. When the table is full, or on compact(), it is rebuilt
+// into a fresh file keeping the most recently used entries.
+//
+// A missing or empty file is initialized; any other file that is not an
+// intact cache is refused with std::runtime_error and left untouched. A
+// rebuild that fails keeps the current table. Not safe for concurrent writers.
+class ResultCache {
+public:
+    explicit ResultCache(const std::string& path, const ResultCacheSettings& settings = ResultCacheSettings());
+    ~ResultCache();
+
+    ResultCache(const ResultCache&) = delete;
+    ResultCache& operator=(const ResultCache&) = delete;
+
+    static util::ContentKey key(const std::string& normalizedInputs) { return util::contentKey(normalizedInputs); }
+
+    bool find(const util::ContentKey& key, core::PricingResult& result);
+    void store(const util::ContentKey& key, const core::PricingResult& result);
+
+    // Drops entries not used in the last maxAge generations (0 keeps all)
+    // and rewrites the file at the smallest capacity that fits.
+    void compact(std::uint64_t maxAge = 0);
+
+    std::size_t size() const;
+    std::size_t capacity() const;
+    std::uint64_t generation() const;
+    std::size_t hits() const { return hits_; }
+    std::size_t misses() const { return misses_; }
+
+private:
+    struct Header;
+    struct Entry;
+
+    void open();
+    void unmap();
+    static bool writeEmpty(int fd, std::size_t capacity, std::uint64_t generation);
+    void rebuild(std::size_t keep, std::uint64_t oldestGeneration);
+    static Entry* probe(Entry* table, std::size_t capacity, const util::ContentKey& key);
+    Entry* slot(const util::ContentKey& key) const;
+    Header* header() const;
+    Entry* entries() const;
+
+    std::string path_;
+    ResultCacheSettings settings_;
+    void* mapping_ = nullptr;
+    std::size_t length_ = 0;
+    std::size_t hits_ = 0;
+    std::size_t misses_ = 0;
+};
+
+} // namespace batch
+} // namespace pricing
+
+#endif // PRICING_BATCH_RESULT_CACHE_HPP
@@ -0,0 +1,71 @@
+#ifndef PRICING_BATCH_ROW_HASH_INDEX_HPP
+#define PRICING_BATCH_ROW_HASH_INDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../util/Hash.hpp"
+
+namespace pricing {
+namespace batch {
+
+// Where the output line of one input row lives in an output file
+struct RowLocation {
+    util::ContentKey key;     // Hash of the normalized row inputs
+    std::uint64_t offset = 0;
+    std::uint64_t length = 0;
+};
+
+// Sidecar of a batch output file: the content hash of every row together
+// with the byte range of its output line. An incremental run looks rows up
+// by hash and copies unchanged lines instead of repricing them. The size and
+// FNV-1a hash of the output itself tie the sidecar to the file it describes.
+class RowHashIndex {
+public:
+    static std::string sidecarPath(const std::string& outputPath) { return outputPath + ".rowhash"; }
+
+    // The configuration key covers everything that shapes an output line
+    // but is not part of the row hashes (columns, number format).
+    explicit RowHashIndex(const util::ContentKey& configuration = util::ContentKey())
+        : configuration_(configuration) {}
+
+    // Throws std::runtime_error if the file is missing or malformed
+    static RowHashIndex load(const std::string& path);
+    void save(const std::string& path) const;
+
+    void add(const util::ContentKey& key, std::uint64_t offset, std::uint64_t length);
+
+    // Records the output file the offsets point into
+    void setOutput(std::uint64_t size, std::uint64_t hash) {
+        outputSize_ = size;
+        outputHash_ = hash;
+    }
+
+    // True if data is the output file this index was written for
+    bool describes(const char* data, std::size_t size) const;
+
+    // First row with this hash, or nullptr
+    const RowLocation* find(const util::ContentKey& key) const;
+
+    const util::ContentKey& configuration() const { return configuration_; }
+    std::size_t size() const { return rows_.size(); }
+
+private:
+    struct KeyHasher {
+        std::size_t operator()(const util::ContentKey& key) const { return static_cast<std::size_t>(key.low); }
+    };
+
+    util::ContentKey configuration_;
+    std::uint64_t outputSize_ = 0;
+    std::uint64_t outputHash_ = util::kFnvOffsetBasis;
+    std::vector<RowLocation> rows_;
+    std::unordered_map<util::ContentKey, std::size_t, KeyHasher> lookup_;
+};
+
+} // namespace batch
+} // namespace pricing
+
+#endif // PRICING_BATCH_ROW_HASH_INDEX_HPP
@@ -0,0 +1,138 @@
+#ifndef PRICING_BATCH_SPOT_LADDER_CACHE_HPP
+#define PRICING_BATCH_SPOT_LADDER_CACHE_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "../core/MarketData.hpp"
+#include "../core/Option.hpp"
+#include "../core/PricingResult.hpp"
+#include "../numerics/MonotoneSpline.hpp"
+
+namespace pricing {
+namespace batch {
+
+struct SpotLadderSettings {
+    double bandWidth = 0.05;        // Ladder covers spot * (1 +- bandWidth)
+    std::size_t nodes = 65;         // Spots priced per ladder
+    double recenterAt = 0.6;        // Rebuild once the spot is this fraction of the band off centre
+
+    void validate() const;
+};
+
+// Price and delta of one option at a ladder of spots, for one volatility,
+// rate and maturity
+struct SpotLadder {
+    std::uint64_t generation = 0;   // Parameters of the cache it was built for
+    double center = 0.0;
+    numerics::MonotoneSpline price;
+    numerics::MonotoneSpline delta;
+};
+
+class SpotLadderCache;
+
+// Background thread that rebuilds the ladders of many caches. Requests that
+// queue up while it works are priced together in one Black-Scholes batch.
+class LadderRebuilder {
+public:
+    LadderRebuilder();
+    ~LadderRebuilder();
+
+    LadderRebuilder(const LadderRebuilder&) = delete;
+    LadderRebuilder& operator=(const LadderRebuilder&) = delete;
+
+    // Blocks until every queued ladder is installed
+    void waitIdle();
+
+    std::size_t laddersBuilt() const { return laddersBuilt_; }
+
+private:
+    friend class SpotLadderCache;
+
+    struct Request {
+        SpotLadderCache* cache;
+        core::Option option;
+        core::MarketData marketData;
+        std::uint64_t generation;
+    };
+
+    void request(const Request& request);
+    // No ladder is installed into the cache after this returns
+    void cancel(SpotLadderCache* cache);
+    void run();
+
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    std::deque<Request> queue_;
+    std::set<SpotLadderCache*> building_;
+    bool stopping_ = false;
+    std::atomic<std::size_t> laddersBuilt_{0};
+    std::thread thread_;
+};
+
+// Quotes one European option on every tick without running Black-Scholes.
+// Price and delta are precomputed with the batch kernel at a ladder of spots
+// around the current spot, and ticks are served by monotone spline
+// evaluation. When the spot drifts towards the edge of the band, or the
+// volatility, rate or maturity change, a new ladder is built in the
+// background (or on the spot without a rebuilder). Until it arrives, quotes
+// the ladder cannot serve are priced exactly.
+//
+// quote() and update() must be called from one thread at a time; ladders
+// are installed from the rebuilder's thread.
+class SpotLadderCache {
+public:
+    // The first ladder is built before the constructor returns
+    SpotLadderCache(const core::Option& option, const core::MarketData& marketData,
+                    const SpotLadderSettings& settings = SpotLadderSettings(),
+                    std::shared_ptr<LadderRebuilder> rebuilder = nullptr);
+    ~SpotLadderCache();
+
+    SpotLadderCache(const SpotLadderCache&) = delete;
+    SpotLadderCache& operator=(const SpotLadderCache&) = delete;
+
+    // Price and delta at this spot; the other Greeks are left at zero
+    core::PricingResult quote(double spot);
+
+    // New option terms or market data; a change of anything but the spot
+    // retires the current ladder
+    void update(const core::Option& option, const core::MarketData& marketData);
+
+    std::size_t ladderQuotes() const { return ladderQuotes_; }
+    std::size_t exactQuotes() const { return exactQuotes_; }
+    double ladderCenter() const;
+
+private:
+    friend class LadderRebuilder;
+
+    // Price and delta of requests[k] at their ladder spots, one batch for all
+    static std::vector<std::shared_ptr<const SpotLadder>> buildLadders(
+        const std::vector<LadderRebuilder::Request>& requests);
+
+    void requestLadder(double spot);
+    // A null ladder reports a failed build
+    void install(std::shared_ptr<const SpotLadder> ladder, std::uint64_t generation);
+
+    SpotLadderSettings settings_;
+    std::shared_ptr<LadderRebuilder> rebuilder_;
+    core::Option option_;
+    core::MarketData marketData_;
+    std::atomic<std::uint64_t> generation_{1};
+    std::atomic<bool> rebuildPending_{false};
+    std::shared_ptr<const SpotLadder> ladder_;   // Accessed through std::atomic_load/atomic_store
+    std::atomic<std::size_t> ladderQuotes_{0};
+    std::atomic<std::size_t> exactQuotes_{0};
+};
+
+} // namespace batch
+} // namespace pricing
+
+#endif // PRICING_BATCH_SPOT_LADDER_CACHE_HPP
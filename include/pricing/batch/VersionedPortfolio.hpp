@@ -0,0 +1,97 @@
+#ifndef PRICING_BATCH_VERSIONED_PORTFOLIO_HPP
+#define PRICING_BATCH_VERSIONED_PORTFOLIO_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "../core/MarketData.hpp"
+#include "../core/Option.hpp"
+#include "../core/OptionBatch.hpp"
+
+namespace pricing {
+namespace batch {
+
+struct PortfolioRoot;
+
+// Immutable view of one committed version of a VersionedPortfolio. Copying
+// a snapshot is O(1) and it stays valid, unchanged, however the portfolio
+// is modified afterwards; it may be read from any number of threads.
+class PortfolioSnapshot {
+public:
+    PortfolioSnapshot() = default;     // Empty, version 0
+
+    std::uint64_t version() const;
+    std::size_t size() const;
+
+    // Throw std::out_of_range for rows beyond size()
+    core::Option option(std::size_t row) const;
+    core::MarketData marketData(std::size_t row) const;
+
+    // Rows [begin, end) as a batch for the pricing engines
+    core::OptionBatch batch(std::size_t begin, std::size_t end) const;
+
+private:
+    friend class VersionedPortfolio;
+    explicit PortfolioSnapshot(std::shared_ptr<const PortfolioRoot> root) : root_(std::move(root)) {}
+
+    std::shared_ptr<const PortfolioRoot> root_;
+};
+
+// Book of positions that writers change while risk runs price pinned
+// versions of it. Rows are stored in column chunks of kChunkRows rows, the
+// chunks in segments of kSegmentChunks, all shared between versions. A
+// chunk or segment is copied only the first time a write touches it after
+// a commit, so appending or amending a row copies at most one chunk, one
+// segment and the short segment list, never the book.
+//
+// Writes are serialized internally and never wait for readers; commit()
+// publishes them as the next version and snapshot() pins the latest one.
+class VersionedPortfolio {
+public:
+    static constexpr std::size_t kChunkRows = 1024;
+    static constexpr std::size_t kSegmentChunks = 1024;
+
+    VersionedPortfolio();
+    ~VersionedPortfolio();
+
+    VersionedPortfolio(const VersionedPortfolio&) = delete;
+    VersionedPortfolio& operator=(const VersionedPortfolio&) = delete;
+
+    // Returns the row index; visible to snapshots after the next commit
+    std::size_t append(const core::Option& option, const core::MarketData& marketData);
+    // Throws std::out_of_range for rows not appended yet
+    void amend(std::size_t row, const core::Option& option, const core::MarketData& marketData);
+    void amendMarketData(std::size_t row, const core::MarketData& marketData);
+
+    // Publishes the writes so far; returns the new version, or the current
+    // one if nothing changed since the last commit
+    std::uint64_t commit();
+
+    // Latest committed version, O(1)
+    PortfolioSnapshot snapshot() const;
+
+    std::size_t size() const;                 // Rows including uncommitted appends
+    std::size_t copiedChunks() const;         // Chunks copied by writes so far
+
+private:
+    struct Location;
+    Location locate(std::size_t row);
+    PortfolioRoot& workingRoot();
+
+    mutable std::mutex writeMutex_;
+    std::shared_ptr<PortfolioRoot> working_;
+    std::uint64_t edit_ = 1;                  // Nodes tagged with it belong to the pending version
+    bool dirty_ = false;
+    std::size_t copiedChunks_ = 0;
+
+    mutable std::mutex publishMutex_;
+    std::shared_ptr<const PortfolioRoot> published_;
+};
+
+} // namespace batch
+} // namespace pricing
+
+#endif // PRICING_BATCH_VERSIONED_PORTFOLIO_HPP
@@ -0,0 +1,39 @@
+#ifndef PRICING_BATCH_WORK_PLANNER_HPP
+#define PRICING_BATCH_WORK_PLANNER_HPP
+
+#include <cstddef>
+#include <vector>
+
+namespace pricing {
+namespace batch {
+
+// Size of one file of a multi-file batch, in units a span can split at
+// (bytes of a file being parsed, rows of a file being priced)
+struct WorkFile {
+    std::size_t units = 0;
+    double unitCost = 1.0;          // Relative cost of one unit
+};
+
+// Units [begin, end) of one file
+struct WorkSpan {
+    std::size_t file = 0;
+    std::size_t begin = 0;
+    std::size_t end = 0;
+};
+
+struct WorkItem {
+    std::vector<WorkSpan> spans;
+    double cost = 0.0;
+};
+
+// Turns the files of a batch into work items of similar cost for one shared
+// pool: a file costing more than targetCost is split into equal spans, and
+// smaller files are packed together in input order. Items are returned most
+// expensive first, so the last items a pool picks up are the small ones.
+// Throws std::invalid_argument if targetCost is not positive.
+std::vector<WorkItem> planWork(const std::vector<WorkFile>& files, double targetCost);
+
+} // namespace batch
+} // namespace pricing
+
+#endif // PRICING_BATCH_WORK_PLANNER_HPP
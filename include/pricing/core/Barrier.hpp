@@ -0,0 +1,60 @@
+#ifndef PRICING_CORE_BARRIER_HPP
+#define PRICING_CORE_BARRIER_HPP
+
+#include <cstddef>
+#include <stdexcept>
+
+namespace pricing {
+namespace core {
+
+enum class BarrierType {
+    UpAndOut,
+    UpAndIn,
+    DownAndOut,
+    DownAndIn
+};
+
+enum class BarrierMonitoring {
+    Continuous,
+    Discrete
+};
+
+class Barrier {
+public:
+    Barrier(BarrierType type, double level,
+            BarrierMonitoring monitoring = BarrierMonitoring::Continuous,
+            std::size_t monitoringDates = 0)
+        : type_(type), level_(level), monitoring_(monitoring), monitoringDates_(monitoringDates) {
+        validate();
+    }
+
+    BarrierType getType() const { return type_; }
+    double getLevel() const { return level_; }
+    BarrierMonitoring getMonitoring() const { return monitoring_; }
+    // Number of equally spaced monitoring dates up to expiration (discrete monitoring only)
+    std::size_t getMonitoringDates() const { return monitoringDates_; }
+
+    bool isUp() const { return type_ == BarrierType::UpAndOut || type_ == BarrierType::UpAndIn; }
+    bool isKnockOut() const { return type_ == BarrierType::UpAndOut || type_ == BarrierType::DownAndOut; }
+    bool isContinuous() const { return monitoring_ == BarrierMonitoring::Continuous; }
+
+private:
+    void validate() const {
+        if (level_ <= 0.0) {
+            throw std::invalid_argument("Barrier level must be positive");
+        }
+        if (monitoring_ == BarrierMonitoring::Discrete && monitoringDates_ == 0) {
+            throw std::invalid_argument("Discretely monitored barrier requires at least one monitoring date");
+        }
+    }
+
+    BarrierType type_;
+    double level_;
+    BarrierMonitoring monitoring_;
+    std::size_t monitoringDates_;
+};
+
+} // namespace core
+} // namespace pricing
+
+#endif // PRICING_CORE_BARRIER_HPP
@@ -0,0 +1,55 @@
+#ifndef PRICING_CORE_HESTON_PARAMETERS_HPP
+#define PRICING_CORE_HESTON_PARAMETERS_HPP
+
+#include <stdexcept>
+
+namespace pricing {
+namespace core {
+
+// Stochastic variance dynamics dv = kappa (theta - v) dt + xi sqrt(v) dW,
+// with corr(dW, dW_spot) = rho.
+class HestonParameters {
+public:
+    HestonParameters(double initialVariance, double meanReversion, double longTermVariance,
+                     double volOfVol, double correlation)
+        : initialVariance_(initialVariance), meanReversion_(meanReversion),
+          longTermVariance_(longTermVariance), volOfVol_(volOfVol), correlation_(correlation) {
+        validate();
+    }
+
+    double getInitialVariance() const { return initialVariance_; }
+    double getMeanReversion() const { return meanReversion_; }
+    double getLongTermVariance() const { return longTermVariance_; }
+    double getVolOfVol() const { return volOfVol_; }
+    double getCorrelation() const { return correlation_; }
+
+private:
+    void validate() const {
+        if (initialVariance_ < 0.0) {
+            throw std::invalid_argument("Initial variance cannot be negative");
+        }
+        if (meanReversion_ <= 0.0) {
+            throw std::invalid_argument("Mean reversion speed must be positive");
+        }
+        if (longTermVariance_ < 0.0) {
+            throw std::invalid_argument("Long-term variance cannot be negative");
+        }
+        if (volOfVol_ <= 0.0) {
+            throw std::invalid_argument("Volatility of variance must be positive");
+        }
+        if (correlation_ < -1.0 || correlation_ > 1.0) {
+            throw std::invalid_argument("Correlation must be in [-1, 1]");
+        }
+    }
+
+    double initialVariance_;
+    double meanReversion_;
+    double longTermVariance_;
+    double volOfVol_;
+    double correlation_;
+};
+
+} // namespace core
+} // namespace pricing
+
+#endif // PRICING_CORE_HESTON_PARAMETERS_HPP
@@ -11,19 +11,27 @@ enum class OptionType {
     Put
 };
 
+enum class ExerciseStyle {
+    European,
+    American
+};
+
 class Option {
 public:
-    Option(OptionType type, double strike, double timeToExpiration)
-        : type_(type), strike_(strike), timeToExpiration_(timeToExpiration) {
+    Option(OptionType type, double strike, double timeToExpiration,
+           ExerciseStyle exercise = ExerciseStyle::European)
+        : type_(type), strike_(strike), timeToExpiration_(timeToExpiration), exercise_(exercise) {
         validate();
     }
 
     OptionType getType() const { return type_; }
     double getStrike() const { return strike_; }
     double getTimeToExpiration() const { return timeToExpiration_; }
+    ExerciseStyle getExerciseStyle() const { return exercise_; }
 
     bool isCall() const { return type_ == OptionType::Call; }
     bool isPut() const { return type_ == OptionType::Put; }
+    bool isAmerican() const { return exercise_ == ExerciseStyle::American; }
 
 private:
     void validate() const {
@@ -38,6 +46,7 @@ private:
     OptionType type_;
     double strike_;
     double timeToExpiration_;
+    ExerciseStyle exercise_;
 };
 
 } // namespace core
@@ -0,0 +1,75 @@
+#ifndef PRICING_CORE_OPTION_BATCH_HPP
+#define PRICING_CORE_OPTION_BATCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "MarketData.hpp"
+#include "Option.hpp"
+#include "../util/PageAllocator.hpp"
+
+namespace pricing {
+namespace core {
+
+// Many European options with their market data, stored as structure of
+// arrays so batch kernels stream through each field. Rows are validated on
+// insertion by the Option and MarketData they come from. Large fields are
+// allocated according to util::memoryPolicy().
+struct OptionBatch {
+    util::BatchVector<OptionType> types;
+    util::BatchVector<double> spots;
+    util::BatchVector<double> strikes;
+    util::BatchVector<double> rates;
+    util::BatchVector<double> volatilities;
+    util::BatchVector<double> maturities;
+
+    std::size_t size() const { return types.size(); }
+
+    void reserve(std::size_t count) {
+        types.reserve(count);
+        spots.reserve(count);
+        strikes.reserve(count);
+        rates.reserve(count);
+        volatilities.reserve(count);
+        maturities.reserve(count);
+    }
+
+    void clear() {
+        types.clear();
+        spots.clear();
+        strikes.clear();
+        rates.clear();
+        volatilities.clear();
+        maturities.clear();
+    }
+
+    void add(const Option& option, const MarketData& marketData) {
+        types.push_back(option.getType());
+        spots.push_back(marketData.getSpot());
+        strikes.push_back(option.getStrike());
+        rates.push_back(marketData.getRiskFreeRate());
+        volatilities.push_back(marketData.getVolatility());
+        maturities.push_back(option.getTimeToExpiration());
+    }
+
+    // Row k of the result is row order[k] of this batch
+    OptionBatch permuted(const std::vector<std::uint32_t>& order) const {
+        OptionBatch result;
+        result.reserve(order.size());
+        for (std::uint32_t index : order) {
+            result.types.push_back(types[index]);
+            result.spots.push_back(spots[index]);
+            result.strikes.push_back(strikes[index]);
+            result.rates.push_back(rates[index]);
+            result.volatilities.push_back(volatilities[index]);
+            result.maturities.push_back(maturities[index]);
+        }
+        return result;
+    }
+};
+
+} // namespace core
+} // namespace pricing
+
+#endif // PRICING_CORE_OPTION_BATCH_HPP
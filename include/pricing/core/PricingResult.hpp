@@ -14,6 +14,9 @@ struct PricingResult {
     double theta = 0.0;
     double rho = 0.0;
 
+    // Standard error of the price estimate (simulation models only)
+    double standardError = 0.0;
+
     bool hasGreeks() const {
         return delta != 0.0 || gamma != 0.0 || vega != 0.0 || 
                theta != 0.0 || rho != 0.0;
@@ -0,0 +1,48 @@
+#ifndef PRICING_MODELS_BINOMIAL_TREE_MODEL_HPP
+#define PRICING_MODELS_BINOMIAL_TREE_MODEL_HPP
+
+#include <cstddef>
+
+#include "PricingModel.hpp"
+
+namespace pricing {
+namespace models {
+
+enum class BinomialTree {
+    CoxRossRubinstein,
+    LeisenReimer       // Peizer-Pratt inversion, odd step counts; second-order convergence
+};
+
+struct BinomialTreeSettings {
+    std::size_t steps = 101;                      // Rounded up to an odd number for Leisen-Reimer
+    BinomialTree tree = BinomialTree::LeisenReimer;
+};
+
+// Binomial lattice for European and American calls and puts. Delta, gamma
+// and theta are read off the first nodes of the same tree; vega and rho are
+// left at zero.
+class BinomialTreeModel : public PricingModel {
+public:
+    BinomialTreeModel() = default;
+    explicit BinomialTreeModel(const BinomialTreeSettings& settings);
+
+    const BinomialTreeSettings& getSettings() const { return settings_; }
+
+    core::PricingResult price(
+        const core::Option& option,
+        const core::MarketData& marketData) const override;
+
+private:
+    void validate() const;
+    std::size_t effectiveSteps() const;
+
+    // Peizer-Pratt method 2 inversion of the normal CDF onto a binomial distribution
+    static double peizerPratt(double z, std::size_t steps);
+
+    BinomialTreeSettings settings_;
+};
+
+} // namespace models
+} // namespace pricing
+
+#endif // PRICING_MODELS_BINOMIAL_TREE_MODEL_HPP
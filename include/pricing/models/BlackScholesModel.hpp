@@ -1,7 +1,10 @@
 #ifndef PRICING_MODELS_BLACK_SCHOLES_MODEL_HPP
 #define PRICING_MODELS_BLACK_SCHOLES_MODEL_HPP
 
+#include <cstddef>
+
 #include "PricingModel.hpp"
+#include "../core/OptionBatch.hpp"
 
 namespace pricing {
 namespace models {
@@ -14,7 +17,14 @@ public:
 
     core::PricingResult priceWithGreeks(
         const core::Option& option,
-        const core::MarketData& marketData) const;
+        const core::MarketData& marketData) const override;
+
+    // Prices rows [begin, end) of a batch into results[begin, end). Terms
+    // depending only on rate, volatility and maturity are reused while
+    // consecutive rows share them, so batches grouped by maturity price
+    // faster. Every result equals price() / priceWithGreeks() of its row.
+    void priceBatch(const core::OptionBatch& batch, std::size_t begin, std::size_t end,
+                    bool withGreeks, core::PricingResult* results) const;
 
 private:
     static double normalCDF(double x);
@@ -0,0 +1,71 @@
+#ifndef PRICING_MODELS_CHEBYSHEV_PROXY_HPP
+#define PRICING_MODELS_CHEBYSHEV_PROXY_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "PricingModel.hpp"
+#include "../numerics/ChebyshevTensor.hpp"
+
+namespace pricing {
+namespace models {
+
+enum class ProxyParameter {
+    Spot,
+    Strike,
+    Maturity,
+    Rate,
+    Volatility
+};
+
+struct ProxyDimension {
+    ProxyParameter parameter;
+    double lower;
+    double upper;
+    std::size_t nodes = 16;    // Chebyshev points along this parameter
+};
+
+// Chebyshev interpolant of an expensive model over a box of option and
+// market parameters. Built once offline, then evaluated without calling the
+// model. Parameters that are not proxy dimensions are fixed to the values of
+// the reference option and market data. Only the price is interpolated.
+class ChebyshevProxy : public PricingModel {
+public:
+    static ChebyshevProxy build(
+        const PricingModel& model,
+        const core::Option& referenceOption,
+        const core::MarketData& referenceMarketData,
+        const std::vector<ProxyDimension>& dimensions,
+        unsigned numThreads = 0);
+
+    // Maps the coefficients of a file written by save() into memory
+    static ChebyshevProxy load(const std::string& path);
+    void save(const std::string& path) const;
+
+    const std::vector<ProxyParameter>& getParameters() const { return parameters_; }
+    const numerics::ChebyshevTensor& getTensor() const { return tensor_; }
+
+    // Throws std::invalid_argument outside the proxy domain
+    core::PricingResult price(
+        const core::Option& option,
+        const core::MarketData& marketData) const override;
+
+private:
+    ChebyshevProxy(std::vector<ProxyParameter> parameters, numerics::ChebyshevTensor tensor,
+                   core::OptionType type, core::ExerciseStyle exercise, const double* reference);
+
+    static double parameterValue(ProxyParameter parameter, const core::Option& option,
+                                 const core::MarketData& marketData);
+
+    std::vector<ProxyParameter> parameters_;
+    numerics::ChebyshevTensor tensor_;
+    core::OptionType type_;
+    core::ExerciseStyle exercise_;
+    double reference_[5];   // Spot, strike, maturity, rate and volatility of the reference
+};
+
+} // namespace models
+} // namespace pricing
+
+#endif // PRICING_MODELS_CHEBYSHEV_PROXY_HPP
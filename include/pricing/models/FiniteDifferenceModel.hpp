@@ -0,0 +1,59 @@
+#ifndef PRICING_MODELS_FINITE_DIFFERENCE_MODEL_HPP
+#define PRICING_MODELS_FINITE_DIFFERENCE_MODEL_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "PricingModel.hpp"
+
+namespace pricing {
+namespace models {
+
+struct FiniteDifferenceSettings {
+    std::size_t spotSteps = 200;
+    std::size_t timeSteps = 100;
+    double maxSpotMultiple = 4.0;    // Upper boundary relative to max(strike, spot)
+    double concentration = 0.1;      // Sinh grid scale relative to the strike (smaller = denser)
+    std::size_t rannacherSteps = 2;  // Crank-Nicolson steps replaced by implicit half steps at the payoff kink
+};
+
+// Crank-Nicolson solver of the Black-Scholes PDE for European and American
+// options. The grid is concentrated around both the strike and the spot.
+class FiniteDifferenceModel : public PricingModel {
+public:
+    FiniteDifferenceModel() = default;
+    explicit FiniteDifferenceModel(const FiniteDifferenceSettings& settings);
+
+    const FiniteDifferenceSettings& getSettings() const { return settings_; }
+
+    core::PricingResult price(
+        const core::Option& option,
+        const core::MarketData& marketData) const override;
+
+    // Options differing only by strike share one grid: the PDE is solved once
+    // in moneyness S/K and every price is rescaled, V(S, K) = K * v(S / K).
+    std::vector<core::PricingResult> priceStrikes(
+        core::OptionType type,
+        core::ExerciseStyle exercise,
+        const std::vector<double>& strikes,
+        double timeToExpiration,
+        const core::MarketData& marketData) const;
+
+private:
+    struct Solution {
+        std::vector<double> grid;
+        std::vector<double> values;
+    };
+
+    void validate() const;
+    Solution solveMoneyness(bool isCall, bool isAmerican, double r, double sigma, double T,
+                            const std::vector<double>& centers, double upper) const;
+    static double interpolate(const Solution& solution, double moneyness);
+
+    FiniteDifferenceSettings settings_;
+};
+
+} // namespace models
+} // namespace pricing
+
+#endif // PRICING_MODELS_FINITE_DIFFERENCE_MODEL_HPP
@@ -0,0 +1,48 @@
+#ifndef PRICING_MODELS_HESTON_ADI_MODEL_HPP
+#define PRICING_MODELS_HESTON_ADI_MODEL_HPP
+
+#include <cstddef>
+
+#include "PricingModel.hpp"
+#include "../core/HestonParameters.hpp"
+#include "../numerics/AdiSolver2D.hpp"
+
+namespace pricing {
+namespace models {
+
+struct HestonAdiSettings {
+    std::size_t spotSteps = 100;
+    std::size_t varianceSteps = 50;
+    std::size_t timeSteps = 50;
+    double maxSpotMultiple = 8.0;       // Upper spot boundary as a multiple of the strike
+    double maxVariance = 5.0;
+    numerics::AdiScheme scheme = numerics::AdiScheme::HundsdorferVerwer;
+    unsigned numThreads = 0;            // 0 = hardware concurrency
+};
+
+// Finite-difference Heston pricer on a spot x variance grid concentrated
+// around the strike and zero variance. Supports European and American
+// exercise; the volatility in MarketData is ignored.
+class HestonAdiModel : public PricingModel {
+public:
+    explicit HestonAdiModel(const core::HestonParameters& parameters,
+                            const HestonAdiSettings& settings = HestonAdiSettings());
+
+    const core::HestonParameters& getParameters() const { return parameters_; }
+    const HestonAdiSettings& getSettings() const { return settings_; }
+
+    core::PricingResult price(
+        const core::Option& option,
+        const core::MarketData& marketData) const override;
+
+private:
+    void validate() const;
+
+    core::HestonParameters parameters_;
+    HestonAdiSettings settings_;
+};
+
+} // namespace models
+} // namespace pricing
+
+#endif // PRICING_MODELS_HESTON_ADI_MODEL_HPP
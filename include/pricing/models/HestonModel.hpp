@@ -0,0 +1,33 @@
+#ifndef PRICING_MODELS_HESTON_MODEL_HPP
+#define PRICING_MODELS_HESTON_MODEL_HPP
+
+#include "PricingModel.hpp"
+#include "../core/HestonParameters.hpp"
+
+namespace pricing {
+namespace models {
+
+// Semi-closed-form Heston price of European options (characteristic function
+// in the "little trap" form, integrated numerically). The volatility in
+// MarketData is ignored: the variance process comes from HestonParameters.
+// American options throw std::invalid_argument (HestonAdiModel prices them).
+class HestonModel : public PricingModel {
+public:
+    explicit HestonModel(const core::HestonParameters& parameters);
+
+    const core::HestonParameters& getParameters() const { return parameters_; }
+
+    core::PricingResult price(
+        const core::Option& option,
+        const core::MarketData& marketData) const override;
+
+private:
+    double probability(int index, double logSpot, double logStrike, double r, double T) const;
+
+    core::HestonParameters parameters_;
+};
+
+} // namespace models
+} // namespace pricing
+
+#endif // PRICING_MODELS_HESTON_MODEL_HPP
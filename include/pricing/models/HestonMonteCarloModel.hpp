@@ -0,0 +1,64 @@
+#ifndef PRICING_MODELS_HESTON_MONTE_CARLO_MODEL_HPP
+#define PRICING_MODELS_HESTON_MONTE_CARLO_MODEL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "PathBlock.hpp"
+#include "PricingModel.hpp"
+#include "../core/HestonParameters.hpp"
+
+namespace pricing {
+namespace models {
+
+enum class HestonScheme {
+    QuadraticExponential,   // Andersen (2008), accurate on coarse time grids
+    EulerFullTruncation     // Needs much finer steps for the same bias
+};
+
+struct HestonMonteCarloSettings {
+    std::size_t numPaths = 100000;
+    std::size_t numSteps = 50;
+    std::uint64_t seed = 42;
+    unsigned numThreads = 0;        // 0 = hardware concurrency
+    std::size_t blockSize = 4096;   // Paths simulated together; results do not depend on thread count
+    HestonScheme scheme = HestonScheme::QuadraticExponential;
+};
+
+// Monte Carlo simulator of the Heston model. Each block of paths keeps its
+// state as structure of arrays and advances step-major, so every time step
+// is a straight loop over the block; blocks are simulated in parallel.
+// European exercise only; American options throw std::invalid_argument.
+class HestonMonteCarloModel : public PricingModel {
+public:
+    explicit HestonMonteCarloModel(const core::HestonParameters& parameters,
+                                   const HestonMonteCarloSettings& settings = HestonMonteCarloSettings());
+
+    const core::HestonParameters& getParameters() const { return parameters_; }
+    const HestonMonteCarloSettings& getSettings() const { return settings_; }
+
+    // European call or put; the volatility in MarketData is ignored.
+    core::PricingResult price(
+        const core::Option& option,
+        const core::MarketData& marketData) const override;
+
+    // Discounted expectation of an arbitrary path-dependent payoff, evaluated
+    // block by block on the simulated spot paths.
+    core::PricingResult pricePayoff(
+        const PathPayoff& payoff,
+        const core::MarketData& marketData,
+        double maturity) const;
+
+private:
+    void validate() const;
+    void simulateBlock(std::size_t block, double spot, double rate, PathBlock& paths) const;
+
+    core::HestonParameters parameters_;
+    HestonMonteCarloSettings settings_;
+};
+
+} // namespace models
+} // namespace pricing
+
+#endif // PRICING_MODELS_HESTON_MONTE_CARLO_MODEL_HPP
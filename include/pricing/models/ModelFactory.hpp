@@ -0,0 +1,27 @@
+#ifndef PRICING_MODELS_MODEL_FACTORY_HPP
+#define PRICING_MODELS_MODEL_FACTORY_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "PricingModel.hpp"
+
+namespace pricing {
+namespace models {
+
+// Names of the models that price a plain option from spot, rate and
+// volatility alone: black_scholes, monte_carlo, binomial, finite_difference
+const std::vector<std::string>& modelNames();
+
+bool isModelName(const std::string& name);
+
+// Model with default settings. numThreads is passed to models that
+// parallelize internally (0 = hardware concurrency); callers pricing many
+// rows in parallel pass 1. Throws std::invalid_argument for unknown names.
+std::unique_ptr<PricingModel> createModel(const std::string& name, unsigned numThreads = 0);
+
+} // namespace models
+} // namespace pricing
+
+#endif // PRICING_MODELS_MODEL_FACTORY_HPP
@@ -0,0 +1,98 @@
+#ifndef PRICING_MODELS_MONTE_CARLO_MODEL_HPP
+#define PRICING_MODELS_MONTE_CARLO_MODEL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "PathBlock.hpp"
+#include "PricingModel.hpp"
+#include "../core/Barrier.hpp"
+
+namespace pricing {
+namespace models {
+
+struct MonteCarloSettings {
+    std::size_t numPaths = 100000;
+    std::size_t numSteps = 50;       // Time steps per path (path-dependent payoffs only)
+    std::uint64_t seed = 42;
+    unsigned numThreads = 0;         // 0 = hardware concurrency
+    std::size_t blockSize = 4096;    // Paths simulated together; results do not depend on thread count
+    bool brownianBridge = true;      // Barrier crossing correction between time steps
+    bool importanceSampling = false; // Shift the terminal normal towards the payoff region
+    bool stratified = false;         // One stratum of the terminal normal per path of a block
+};
+
+// Monte Carlo pricer under geometric Brownian motion.
+// Paths are generated in independent blocks (one RNG stream per block),
+// laid out step-major so that every time step is a loop over the block.
+// European exercise only; American options throw std::invalid_argument.
+class MonteCarloModel : public PricingModel {
+public:
+    MonteCarloModel() = default;
+    explicit MonteCarloModel(const MonteCarloSettings& settings);
+
+    const MonteCarloSettings& getSettings() const { return settings_; }
+
+    // European call or put from the terminal distribution, optionally with
+    // importance sampling (drift shift solved up front) and stratification.
+    core::PricingResult price(
+        const core::Option& option,
+        const core::MarketData& marketData) const override;
+
+    // Price and Greeks from one simulation: delta, vega and rho by
+    // pathwise differentiation, gamma by the likelihood-ratio/pathwise mixed
+    // estimator and theta from the Black-Scholes PDE.
+    core::PricingResult priceWithGreeks(
+        const core::Option& option,
+        const core::MarketData& marketData) const override;
+
+    // Knock-out / knock-in barrier option on a European call or put.
+    // Continuous barriers use the Brownian-bridge crossing probability between
+    // steps. Discrete barriers whose monitoring dates do not coincide with the
+    // simulation grid are priced as continuous ones with the
+    // Broadie-Glasserman-Kou shifted level.
+    core::PricingResult priceBarrier(
+        const core::Option& option,
+        const core::Barrier& barrier,
+        const core::MarketData& marketData) const;
+
+    // Discounted expectation of an arbitrary path-dependent payoff (for
+    // example a PayoffScript) on numSteps exact log-normal steps.
+    core::PricingResult pricePayoff(
+        const PathPayoff& payoff,
+        const core::MarketData& marketData,
+        double maturity) const;
+
+private:
+    struct BlockSums {
+        double sum = 0.0;
+        double sumSquares = 0.0;
+    };
+
+    struct GreekSums {
+        BlockSums price;
+        double delta = 0.0;
+        double gamma = 0.0;
+        double vega = 0.0;
+    };
+
+    void validate() const;
+    std::size_t blockCount() const;
+    std::size_t blockPaths(std::size_t block) const;
+    core::PricingResult aggregate(const std::vector<BlockSums>& blocks, double discountFactor,
+                                  bool fromBlockMeans) const;
+    void sampleTerminalShocks(std::size_t block, double shift,
+                              std::vector<double>& shocks, std::vector<double>& weights) const;
+
+    static double importanceShift(const core::Option& option, double logMean, double volSqrtT);
+    static double inverseNormalCDF(double p);
+    static double intrinsicValue(const core::Option& option, double spot);
+
+    MonteCarloSettings settings_;
+};
+
+} // namespace models
+} // namespace pricing
+
+#endif // PRICING_MODELS_MONTE_CARLO_MODEL_HPP
@@ -0,0 +1,30 @@
+#ifndef PRICING_MODELS_PATH_BLOCK_HPP
+#define PRICING_MODELS_PATH_BLOCK_HPP
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace pricing {
+namespace models {
+
+// Simulated spot paths of one block, stored step-major (structure of arrays):
+// spots[step * numPaths + path], where step 0 is today and step numSteps is expiry.
+struct PathBlock {
+    std::size_t numPaths = 0;
+    std::size_t numSteps = 0;
+    double timeStep = 0.0;
+    std::vector<double> spots;
+
+    const double* step(std::size_t index) const { return spots.data() + index * numPaths; }
+    double* step(std::size_t index) { return spots.data() + index * numPaths; }
+};
+
+// Writes the undiscounted payoff of every path of the block into payoffs[path].
+// May be called concurrently for different blocks.
+using PathPayoff = std::function<void(const PathBlock& block, std::vector<double>& payoffs)>;
+
+} // namespace models
+} // namespace pricing
+
+#endif // PRICING_MODELS_PATH_BLOCK_HPP
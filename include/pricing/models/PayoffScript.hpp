@@ -0,0 +1,63 @@
+#ifndef PRICING_MODELS_PAYOFF_SCRIPT_HPP
+#define PRICING_MODELS_PAYOFF_SCRIPT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "PathBlock.hpp"
+
+namespace pricing {
+namespace models {
+
+// Payoff written as an expression over path observations, compiled once to
+// stack bytecode. Every instruction is applied to all paths of a block at
+// once, so interpretation costs one dispatch per instruction and block.
+//
+//   Observations: spot (at expiry), initial, average (steps 1..n),
+//                 maximum, minimum (steps 0..n), at(k) (spot at step k)
+//   Operators:    + - * /  < <= > >= == !=  && || !  (comparisons give 1 or 0)
+//   Functions:    max(a, b, ...), min(a, b, ...), abs, exp, log, sqrt, if(c, a, b)
+//
+// Named parameters (e.g. strike, barrier levels) are bound at compile time:
+//   PayoffScript("(maximum < B) * max(spot - K, 0)", {{"K", 100.0}, {"B", 130.0}})
+//
+// Usable directly as a PathPayoff.
+class PayoffScript {
+public:
+    explicit PayoffScript(const std::string& source,
+                          const std::map<std::string, double>& parameters = {});
+
+    void operator()(const PathBlock& block, std::vector<double>& payoffs) const;
+
+    const std::string& getSource() const { return source_; }
+    std::size_t instructionCount() const { return code_.size(); }
+
+    enum class OpCode : std::uint8_t {
+        Constant, Spot, Initial, Average, Maximum, Minimum, At,
+        Add, Subtract, Multiply, Divide, Negate, Not,
+        Less, LessEqual, Greater, GreaterEqual, Equal, NotEqual, And, Or,
+        Max, Min, Abs, Exp, Log, Sqrt, Select
+    };
+
+    struct Instruction {
+        OpCode op;
+        std::uint32_t operand;   // Constant pool index or step index
+    };
+
+private:
+    class Compiler;
+
+    std::string source_;
+    std::vector<Instruction> code_;
+    std::vector<double> constants_;
+    std::size_t stackDepth_ = 0;
+    std::size_t maxStep_ = 0;   // Largest step addressed by at(k)
+};
+
+} // namespace models
+} // namespace pricing
+
+#endif // PRICING_MODELS_PAYOFF_SCRIPT_HPP
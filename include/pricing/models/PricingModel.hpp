@@ -1,6 +1,9 @@
 #ifndef PRICING_MODELS_PRICING_MODEL_HPP
 #define PRICING_MODELS_PRICING_MODEL_HPP
 
+#include <stdexcept>
+#include <string>
+
 #include "../core/Option.hpp"
 #include "../core/MarketData.hpp"
 #include "../core/PricingResult.hpp"
@@ -15,6 +18,23 @@ public:
     virtual core::PricingResult price(
         const core::Option& option,
         const core::MarketData& marketData) const = 0;
+
+    // Price with every Greek the model can provide; models without a
+    // dedicated method return price(), with whatever Greeks it fills in
+    virtual core::PricingResult priceWithGreeks(
+        const core::Option& option,
+        const core::MarketData& marketData) const {
+        return price(option, marketData);
+    }
+
+protected:
+    // For models without early exercise: rather than quietly pricing an
+    // American option as European, reject it with std::invalid_argument
+    static void requireEuropean(const core::Option& option, const std::string& model) {
+        if (option.isAmerican()) {
+            throw std::invalid_argument(model + " prices European options only");
+        }
+    }
 };
 
 } // namespace models
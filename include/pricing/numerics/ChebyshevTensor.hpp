@@ -0,0 +1,52 @@
+#ifndef PRICING_NUMERICS_CHEBYSHEV_TENSOR_HPP
+#define PRICING_NUMERICS_CHEBYSHEV_TENSOR_HPP
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace pricing {
+namespace numerics {
+
+// Tensor-product Chebyshev interpolant on a box. Values are sampled at the
+// Chebyshev-Lobatto points of every dimension and stored as coefficients in
+// row-major order (last dimension fastest).
+class ChebyshevTensor {
+public:
+    ChebyshevTensor(std::vector<double> lower, std::vector<double> upper, std::vector<std::size_t> nodes);
+
+    // Wraps coefficients owned elsewhere (e.g. a memory-mapped file)
+    ChebyshevTensor(std::vector<double> lower, std::vector<double> upper, std::vector<std::size_t> nodes,
+                    std::shared_ptr<const double> coefficients);
+
+    std::size_t dimensions() const { return nodes_.size(); }
+    std::size_t size() const { return size_; }
+    const std::vector<double>& lower() const { return lower_; }
+    const std::vector<double>& upper() const { return upper_; }
+    const std::vector<std::size_t>& nodeCounts() const { return nodes_; }
+    const double* coefficients() const { return coefficients_.get(); }
+
+    // Chebyshev-Lobatto points of one dimension mapped onto [lower, upper], descending
+    std::vector<double> points(std::size_t dimension) const;
+
+    // Fits the coefficients to values sampled at the tensor of points()
+    void fit(const std::vector<double>& values);
+
+    // Clenshaw recurrence, one dimension at a time. Every step of the
+    // recurrence is a contiguous loop over the remaining dimensions.
+    double evaluate(const double* point) const;
+
+private:
+    void validate() const;
+
+    std::vector<double> lower_;
+    std::vector<double> upper_;
+    std::vector<std::size_t> nodes_;
+    std::size_t size_ = 1;
+    std::shared_ptr<const double> coefficients_;
+};
+
+} // namespace numerics
+} // namespace pricing
+
+#endif // PRICING_NUMERICS_CHEBYSHEV_TENSOR_HPP
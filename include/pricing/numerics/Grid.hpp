@@ -0,0 +1,33 @@
+#ifndef PRICING_NUMERICS_GRID_HPP
+#define PRICING_NUMERICS_GRID_HPP
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace pricing {
+namespace numerics {
+
+// Non-uniform grid x_k = center + scale * sinh(u_k) with u_k uniform, so that
+// points concentrate around center. Smaller scale means stronger concentration.
+// Returns intervals + 1 points from lower to upper inclusive.
+std::vector<double> sinhGrid(double lower, double upper, double center, double scale, std::size_t intervals);
+
+// Grid concentrated around several centers at once: points are uniform in
+// u(x) = sum_k asinh((x - center_k) / scale). With one center this is sinhGrid.
+std::vector<double> concentratedGrid(double lower, double upper, const std::vector<double>& centers,
+                                     double scale, std::size_t intervals);
+
+// Three-point Lagrange interpolation stencil around x: value(x) ~
+// sum_k weights[k] * f(grid[first + k]). The grid needs at least three points.
+struct InterpolationStencil {
+    std::size_t first = 0;
+    std::array<double, 3> weights{};
+};
+
+InterpolationStencil interpolationStencil(const std::vector<double>& grid, double x);
+
+} // namespace numerics
+} // namespace pricing
+
+#endif // PRICING_NUMERICS_GRID_HPP
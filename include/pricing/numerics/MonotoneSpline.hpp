@@ -0,0 +1,47 @@
+#ifndef PRICING_NUMERICS_MONOTONE_SPLINE_HPP
+#define PRICING_NUMERICS_MONOTONE_SPLINE_HPP
+
+#include <cstddef>
+#include <vector>
+
+namespace pricing {
+namespace numerics {
+
+// Monotone cubic Hermite interpolant (Fritsch-Carlson) of values on a
+// uniform grid from lower to upper inclusive: wherever the data are
+// monotone, so is the spline, with no overshoot between knots. Each interval
+// is stored as a cubic in the local coordinate, so evaluation is one index
+// computation and a Horner step. Outside [lower, upper] the end intervals
+// are extrapolated.
+class MonotoneSpline {
+public:
+    MonotoneSpline() = default;
+    // Throws std::invalid_argument for fewer than two values or lower >= upper
+    MonotoneSpline(double lower, double upper, const std::vector<double>& values);
+
+    double lower() const { return lower_; }
+    double upper() const { return upper_; }
+    bool contains(double x) const { return x >= lower_ && x <= upper_; }
+
+    double operator()(double x) const {
+        double position = (x - lower_) * inverseStep_;
+        std::size_t intervals = coefficients_.size() / 4;
+        std::size_t interval = position <= 0.0 ? 0
+            : position >= static_cast<double>(intervals) ? intervals - 1
+            : static_cast<std::size_t>(position);
+        double t = position - static_cast<double>(interval);
+        const double* c = &coefficients_[4 * interval];
+        return c[0] + t * (c[1] + t * (c[2] + t * c[3]));
+    }
+
+private:
+    double lower_ = 0.0;
+    double upper_ = 0.0;
+    double inverseStep_ = 0.0;
+    std::vector<double> coefficients_;    // a, b, c, d of a + b t + c t^2 + d t^3 per interval
+};
+
+} // namespace numerics
+} // namespace pricing
+
+#endif // PRICING_NUMERICS_MONOTONE_SPLINE_HPP
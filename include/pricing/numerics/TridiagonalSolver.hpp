@@ -0,0 +1,30 @@
+#ifndef PRICING_NUMERICS_TRIDIAGONAL_SOLVER_HPP
+#define PRICING_NUMERICS_TRIDIAGONAL_SOLVER_HPP
+
+#include <cstddef>
+#include <vector>
+
+namespace pricing {
+namespace numerics {
+
+// Thomas algorithm with a preallocated workspace, so repeated line solves
+// do not allocate. Not thread-safe: use one solver per thread.
+class TridiagonalSolver {
+public:
+    explicit TridiagonalSolver(std::size_t size);
+
+    std::size_t size() const { return scratch_.size(); }
+
+    // Solves lower[k] x[k-1] + diag[k] x[k] + upper[k] x[k+1] = rhs[k].
+    // rhs and x may alias.
+    void solve(const double* lower, const double* diag, const double* upper,
+               const double* rhs, double* x);
+
+private:
+    std::vector<double> scratch_;
+};
+
+} // namespace numerics
+} // namespace pricing
+
+#endif // PRICING_NUMERICS_TRIDIAGONAL_SOLVER_HPP
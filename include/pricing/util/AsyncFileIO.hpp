@@ -0,0 +1,69 @@
+#ifndef PRICING_UTIL_ASYNC_FILE_IO_HPP
+#define PRICING_UTIL_ASYNC_FILE_IO_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace pricing {
+namespace util {
+
+enum class IoBackend {
+    Auto,       // io_uring where the kernel supports it, threads otherwise
+    IoUring,
+    Threads
+};
+
+struct AsyncIoSettings {
+    IoBackend backend = IoBackend::Auto;
+    std::size_t queueDepth = 64;    // Files open at once
+    unsigned ioThreads = 4;         // Blocking I/O threads of the fallback backend
+
+    void validate() const;
+};
+
+struct IoCompletion {
+    std::uint64_t tag = 0;
+    bool write = false;
+    std::string data;               // Whole file contents of a read
+    std::string error;              // Empty on success
+};
+
+// Whole-file reads and writes that complete in the background while the
+// caller does other work. With io_uring an I/O thread submits the open, read,
+// write and close of up to queueDepth files to the kernel in batches; without
+// it a small pool of threads performs the same blocking calls. Completions are
+// returned in the order they finish, identified by the caller's tag.
+class AsyncFileIO {
+public:
+    explicit AsyncFileIO(const AsyncIoSettings& settings = AsyncIoSettings());
+    ~AsyncFileIO();
+
+    AsyncFileIO(const AsyncFileIO&) = delete;
+    AsyncFileIO& operator=(const AsyncFileIO&) = delete;
+
+    void read(const std::string& path, std::uint64_t tag);
+    // Creates or truncates the file
+    void write(const std::string& path, std::string data, std::uint64_t tag);
+
+    // Waits for the next finished request; false once nothing is outstanding
+    bool next(IoCompletion& completion);
+    // Returns a finished request without waiting; false if none is ready
+    bool poll(IoCompletion& completion);
+
+    std::size_t outstanding() const;
+    IoBackend backend() const;      // IoUring or Threads, never Auto
+
+    static bool ioUringAvailable();
+
+    class Backend;
+
+private:
+    std::unique_ptr<Backend> backend_;
+};
+
+} // namespace util
+} // namespace pricing
+
+#endif // PRICING_UTIL_ASYNC_FILE_IO_HPP
@@ -0,0 +1,54 @@
+#ifndef PRICING_UTIL_HASH_HPP
+#define PRICING_UTIL_HASH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace pricing {
+namespace util {
+
+const std::uint64_t kFnvOffsetBasis = 14695981039346656037ULL;
+
+// 64-bit FNV-1a; pass the previous hash to continue hashing across buffers
+inline std::uint64_t fnv1a(const void* data, std::size_t size, std::uint64_t hash = kFnvOffsetBasis) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+inline std::uint64_t fnv1a(const std::string& text, std::uint64_t hash = kFnvOffsetBasis) {
+    return fnv1a(text.data(), text.size(), hash);
+}
+
+// 128-bit content key: two differently seeded FNV-1a passes, the second one
+// finalized with the SplitMix64 mixer
+struct ContentKey {
+    std::uint64_t low = 0;
+    std::uint64_t high = 0;
+
+    bool operator==(const ContentKey& other) const { return low == other.low && high == other.high; }
+    bool operator!=(const ContentKey& other) const { return !(*this == other); }
+};
+
+inline ContentKey contentKey(const void* data, std::size_t size) {
+    ContentKey key;
+    key.low = fnv1a(data, size);
+    std::uint64_t z = fnv1a(data, size, 0x84222325CBF29CE4ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    key.high = z ^ (z >> 31);
+    return key;
+}
+
+inline ContentKey contentKey(const std::string& text) {
+    return contentKey(text.data(), text.size());
+}
+
+} // namespace util
+} // namespace pricing
+
+#endif // PRICING_UTIL_HASH_HPP
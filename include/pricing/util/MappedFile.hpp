@@ -0,0 +1,38 @@
+#ifndef PRICING_UTIL_MAPPED_FILE_HPP
+#define PRICING_UTIL_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string>
+
+#include "PageAllocator.hpp"
+
+namespace pricing {
+namespace util {
+
+// Read-only memory mapping of a whole file. An empty file maps to no data.
+// The policy can prefault the whole file and ask for huge pages where the
+// file system supports them.
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path, const MemoryPolicy& policy = MemoryPolicy());
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return data_; }
+    std::size_t size() const { return size_; }
+
+private:
+    void release();
+
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+} // namespace util
+} // namespace pricing
+
+#endif // PRICING_UTIL_MAPPED_FILE_HPP
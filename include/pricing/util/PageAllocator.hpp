@@ -0,0 +1,82 @@
+#ifndef PRICING_UTIL_PAGE_ALLOCATOR_HPP
+#define PRICING_UTIL_PAGE_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace pricing {
+namespace util {
+
+// How large batch buffers and mapped input files are backed by memory.
+// Both requests fall back silently where the system does not support them.
+struct MemoryPolicy {
+    bool hugePages = false;     // MAP_HUGETLB, else madvise(MADV_HUGEPAGE)
+    bool prefault = false;      // MAP_POPULATE, else touch every page up front
+};
+
+// Process-wide policy of BatchAllocator; set once at startup
+void setMemoryPolicy(const MemoryPolicy& policy);
+MemoryPolicy memoryPolicy();
+
+// Allocations of at least this size are mapped directly and follow the
+// policy; mappings are rounded up to whole 2 MB pages
+const std::size_t kLargeAllocation = std::size_t(2) << 20;
+
+void* allocateLarge(std::size_t bytes);
+void deallocateLarge(void* pointer, std::size_t bytes) noexcept;
+
+// How the large allocations so far were backed
+struct LargeAllocationStats {
+    std::size_t hugeTlb = 0;        // Reserved huge pages (MAP_HUGETLB)
+    std::size_t transparent = 0;    // Regular mapping advised for transparent huge pages
+    std::size_t regular = 0;
+};
+
+LargeAllocationStats largeAllocationStats();
+
+// Standard allocator for batch buffers: small blocks come from operator new,
+// large ones from allocateLarge. Stateless, so all instances are equal.
+template <typename T>
+class BatchAllocator {
+public:
+    using value_type = T;
+
+    BatchAllocator() = default;
+    template <typename U>
+    BatchAllocator(const BatchAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t count) {
+        std::size_t bytes = count * sizeof(T);
+        if (bytes >= kLargeAllocation) {
+            return static_cast<T*>(allocateLarge(bytes));
+        }
+        return static_cast<T*>(::operator new(bytes));
+    }
+
+    void deallocate(T* pointer, std::size_t count) noexcept {
+        std::size_t bytes = count * sizeof(T);
+        if (bytes >= kLargeAllocation) {
+            deallocateLarge(pointer, bytes);
+        } else {
+            ::operator delete(pointer);
+        }
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const BatchAllocator<T>&, const BatchAllocator<U>&) { return true; }
+
+template <typename T, typename U>
+bool operator!=(const BatchAllocator<T>&, const BatchAllocator<U>&) { return false; }
+
+template <typename T>
+using BatchVector = std::vector<T, BatchAllocator<T>>;
+
+// Touches one byte per page so the kernel maps the whole range now
+void prefaultPages(const void* data, std::size_t bytes, bool write);
+
+} // namespace util
+} // namespace pricing
+
+#endif // PRICING_UTIL_PAGE_ALLOCATOR_HPP
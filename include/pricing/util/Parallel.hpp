@@ -0,0 +1,174 @@
+#ifndef PRICING_UTIL_PARALLEL_HPP
+#define PRICING_UTIL_PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pricing {
+namespace util {
+
+inline unsigned resolveThreadCount(unsigned requested) {
+    if (requested != 0) {
+        return requested;
+    }
+    unsigned hardware = std::thread::hardware_concurrency();
+    return hardware == 0 ? 1 : hardware;
+}
+
+// Calls fn(index) for every index in [0, count), distributing indices
+// dynamically over up to numThreads threads (0 = hardware concurrency).
+// The first exception thrown by fn is rethrown on the calling thread.
+template <typename Fn>
+void parallelFor(std::size_t count, unsigned numThreads, Fn&& fn) {
+    unsigned threads = static_cast<unsigned>(
+        std::min<std::size_t>(resolveThreadCount(numThreads), count));
+    if (threads <= 1) {
+        for (std::size_t i = 0; i < count; ++i) {
+            fn(i);
+        }
+        return;
+    }
+
+    std::atomic<std::size_t> next{0};
+    std::exception_ptr error;
+    std::mutex errorMutex;
+
+    auto worker = [&]() {
+        try {
+            for (std::size_t i = next++; i < count; i = next++) {
+                fn(i);
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+            next = count;
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (unsigned t = 1; t < threads; ++t) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+// Fixed set of threads for many short parallel sections in a row, such as
+// the line sweeps of every time step of a PDE solver: run() wakes threads
+// that are already there, where parallelFor would start and join new ones
+// each call. The calling thread works as member 0. One run() at a time.
+class ThreadTeam {
+public:
+    explicit ThreadTeam(unsigned size) {
+        unsigned members = resolveThreadCount(size);
+        threads_.reserve(members - 1);
+        for (unsigned member = 1; member < members; ++member) {
+            threads_.emplace_back([this, member]() { serve(member); });
+        }
+    }
+
+    ~ThreadTeam() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+    }
+
+    ThreadTeam(const ThreadTeam&) = delete;
+    ThreadTeam& operator=(const ThreadTeam&) = delete;
+
+    unsigned size() const { return static_cast<unsigned>(threads_.size()) + 1; }
+
+    // Calls fn(member) for every member in [0, size()) and returns when all
+    // calls have finished. The first exception thrown by fn is rethrown.
+    template <typename Fn>
+    void run(Fn&& fn) {
+        std::function<void(unsigned)> task = std::ref(fn);
+        if (threads_.empty()) {
+            task(0);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            task_ = &task;
+            error_ = nullptr;
+            pending_ = threads_.size();
+            ++generation_;
+        }
+        wake_.notify_all();
+        execute(0);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        finished_.wait(lock, [this]() { return pending_ == 0; });
+        task_ = nullptr;
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+    }
+
+private:
+    void serve(unsigned member) {
+        std::uint64_t seen = 0;
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            wake_.wait(lock, [&]() { return stopping_ || generation_ != seen; });
+            if (stopping_) {
+                return;
+            }
+            seen = generation_;
+            lock.unlock();
+            execute(member);
+            lock.lock();
+            if (--pending_ == 0) {
+                finished_.notify_one();
+            }
+        }
+    }
+
+    void execute(unsigned member) {
+        try {
+            (*task_)(member);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!error_) {
+                error_ = std::current_exception();
+            }
+        }
+    }
+
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable finished_;
+    const std::function<void(unsigned)>* task_ = nullptr;
+    std::exception_ptr error_;
+    std::size_t pending_ = 0;
+    std::uint64_t generation_ = 0;
+    bool stopping_ = false;
+};
+
+} // namespace util
+} // namespace pricing
+
+#endif // PRICING_UTIL_PARALLEL_HPP
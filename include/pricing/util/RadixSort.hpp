@@ -0,0 +1,32 @@
+#ifndef PRICING_UTIL_RADIX_SORT_HPP
+#define PRICING_UTIL_RADIX_SORT_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace pricing {
+namespace util {
+
+// Unsigned key with the same order as the double (-0.0 and 0.0 are equal)
+inline std::uint64_t sortableKey(double value) {
+    if (value == 0.0) {
+        value = 0.0;
+    }
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits >> 63) ? ~bits : bits | (1ULL << 63);
+}
+
+// Stable LSD radix sort of the indices in order by keys[index], 11 bits per
+// pass. Passes whose digit is the same for every key are skipped. Histogram
+// and scatter run in parallel over contiguous chunks of the input, so the
+// result does not depend on numThreads (0 = hardware concurrency).
+// Sorting by several keys: call once per key, least significant first.
+void radixSortIndices(std::vector<std::uint32_t>& order, const std::vector<std::uint64_t>& keys,
+                      unsigned numThreads = 0);
+
+} // namespace util
+} // namespace pricing
+
+#endif // PRICING_UTIL_RADIX_SORT_HPP
@@ -0,0 +1,21 @@
+#ifndef PRICING_UTIL_RANDOM_HPP
+#define PRICING_UTIL_RANDOM_HPP
+
+#include <cstdint>
+
+namespace pricing {
+namespace util {
+
+// Seed of an independent random stream (e.g. one per block of paths).
+// The SplitMix64 finalizer decorrelates the streams of neighbouring indices.
+inline std::uint64_t streamSeed(std::uint64_t seed, std::uint64_t stream) {
+    std::uint64_t z = seed + 0x9E3779B97F4A7C15ULL * (stream + 1);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+} // namespace util
+} // namespace pricing
+
+#endif // PRICING_UTIL_RANDOM_HPP
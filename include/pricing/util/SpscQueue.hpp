@@ -0,0 +1,88 @@
+#ifndef PRICING_UTIL_SPSC_QUEUE_HPP
+#define PRICING_UTIL_SPSC_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace pricing {
+namespace util {
+
+const std::size_t kCacheLine = 64;
+
+// Bounded lock-free queue between exactly one producer thread and one
+// consumer thread. The ring holds a power-of-two number of slots; each side
+// owns one index on its own cache line and keeps a cached copy of the
+// other's, so the shared lines are only touched when the cached view says the
+// ring looks full or empty.
+template <typename T>
+class SpscQueue {
+public:
+    // Capacity is rounded up to a power of two
+    explicit SpscQueue(std::size_t capacity) {
+        if (capacity == 0) {
+            throw std::invalid_argument("Queue capacity must be positive");
+        }
+        std::size_t slots = 1;
+        while (slots < capacity) {
+            slots <<= 1;
+        }
+        slots_.resize(slots);
+        mask_ = slots - 1;
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    std::size_t capacity() const { return slots_.size(); }
+
+    // Producer side; false if the ring is full
+    bool tryPush(const T& value) {
+        std::size_t tail = producer_.index.load(std::memory_order_relaxed);
+        if (tail - producer_.cached == slots_.size()) {
+            producer_.cached = consumer_.index.load(std::memory_order_acquire);
+            if (tail - producer_.cached == slots_.size()) {
+                return false;
+            }
+        }
+        slots_[tail & mask_] = value;
+        producer_.index.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side; false if the ring is empty
+    bool tryPop(T& value) {
+        std::size_t head = consumer_.index.load(std::memory_order_relaxed);
+        if (head == consumer_.cached) {
+            consumer_.cached = producer_.index.load(std::memory_order_acquire);
+            if (head == consumer_.cached) {
+                return false;
+            }
+        }
+        value = slots_[head & mask_];
+        consumer_.index.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Either side; exact only while the other side is idle
+    bool empty() const {
+        return consumer_.index.load(std::memory_order_acquire) == producer_.index.load(std::memory_order_acquire);
+    }
+
+private:
+    struct alignas(kCacheLine) Side {
+        std::atomic<std::size_t> index{0};
+        std::size_t cached = 0;     // Last seen index of the other side
+    };
+
+    Side producer_;                 // Next slot to write
+    Side consumer_;                 // Next slot to read
+    std::vector<T> slots_;
+    std::size_t mask_ = 0;
+};
+
+} // namespace util
+} // namespace pricing
+
+#endif // PRICING_UTIL_SPSC_QUEUE_HPP
@@ -0,0 +1,242 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <unistd.h>
+
+#include "../../include/pricing/batch/AutoTuner.hpp"
+#include "../../include/pricing/util/Parallel.hpp"
+
+namespace pricing {
+namespace batch {
+
+namespace {
+    const char* const kProfileHeader = "# option-pricing tuning profile v1";
+
+    const char* kernelName(BatchKernel kernel) {
+        return kernel == BatchKernel::Grouped ? "grouped" : "per_row";
+    }
+
+    BatchKernel parseKernel(const std::string& name, const std::string& path) {
+        if (name == "grouped") {
+            return BatchKernel::Grouped;
+        }
+        if (name == "per_row") {
+            return BatchKernel::PerRow;
+        }
+        throw std::runtime_error("Invalid kernel in tuning profile: " + path);
+    }
+
+    unsigned long long parseUnsigned(const std::string& value, const std::string& path) {
+        std::size_t consumed = 0;
+        unsigned long long result = 0;
+        try {
+            result = std::stoull(value, &consumed);
+        } catch (const std::exception&) {
+            consumed = 0;
+        }
+        if (consumed == 0 || consumed != value.size() || value[0] == '-') {
+            throw std::runtime_error("Invalid value in tuning profile: " + path);
+        }
+        return result;
+    }
+}
+
+void TuningProfile::apply(BatchSettings& settings) const {
+    settings.numThreads = numThreads;
+    settings.chunkSize = chunkSize;
+    settings.kernel = kernel;
+    settings.reorder = reorder;
+}
+
+bool TuningProfile::matchesHost() const {
+    return host == AutoTuner::hostName() && hardwareThreads == util::resolveThreadCount(0);
+}
+
+void TuningProfile::save(const std::string& path) const {
+    std::string temporary = path + ".tmp";
+    std::ofstream file(temporary, std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open file: " + temporary);
+    }
+    file << kProfileHeader << "\n"
+         << "host=" << host << "\n"
+         << "hardware_threads=" << hardwareThreads << "\n"
+         << "threads=" << numThreads << "\n"
+         << "chunk_size=" << chunkSize << "\n"
+         << "kernel=" << kernelName(kernel) << "\n"
+         << "reorder=" << (reorder ? 1 : 0) << "\n"
+         << "rows_per_second=" << static_cast<unsigned long long>(rowsPerSecond) << "\n";
+    file.close();
+    if (!file || std::rename(temporary.c_str(), path.c_str()) != 0) {
+        throw std::runtime_error("Cannot write file: " + path);
+    }
+}
+
+TuningProfile TuningProfile::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open file: " + path);
+    }
+    std::string line;
+    if (!std::getline(file, line) || line != kProfileHeader) {
+        throw std::runtime_error("Invalid tuning profile: " + path);
+    }
+
+    TuningProfile profile;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::size_t separator = line.find('=');
+        if (separator == std::string::npos) {
+            throw std::runtime_error("Invalid tuning profile: " + path);
+        }
+        std::string key = line.substr(0, separator);
+        std::string value = line.substr(separator + 1);
+        if (key == "host") {
+            profile.host = value;
+        } else if (key == "hardware_threads") {
+            profile.hardwareThreads = static_cast<unsigned>(parseUnsigned(value, path));
+        } else if (key == "threads") {
+            profile.numThreads = static_cast<unsigned>(parseUnsigned(value, path));
+        } else if (key == "chunk_size") {
+            profile.chunkSize = static_cast<std::size_t>(parseUnsigned(value, path));
+        } else if (key == "kernel") {
+            profile.kernel = parseKernel(value, path);
+        } else if (key == "reorder") {
+            profile.reorder = parseUnsigned(value, path) != 0;
+        } else if (key == "rows_per_second") {
+            profile.rowsPerSecond = static_cast<double>(parseUnsigned(value, path));
+        }
+        // Keys of newer versions are ignored
+    }
+    if (profile.chunkSize == 0) {
+        throw std::runtime_error("Invalid chunk size in tuning profile: " + path);
+    }
+    return profile;
+}
+
+AutoTuner::AutoTuner(const AutotuneSettings& settings)
+    : settings_(settings) {
+    validate();
+}
+
+void AutoTuner::validate() const {
+    if (settings_.rows == 0) {
+        throw std::invalid_argument("Calibration needs at least one row");
+    }
+    if (settings_.repetitions == 0) {
+        throw std::invalid_argument("Calibration needs at least one repetition");
+    }
+}
+
+std::string AutoTuner::hostName() {
+    char name[256] = {};
+    if (::gethostname(name, sizeof(name) - 1) != 0) {
+        return "unknown";
+    }
+    return name;
+}
+
+core::OptionBatch AutoTuner::syntheticBatch(std::size_t rows, std::uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    const double maturities[] = {0.083, 0.25, 0.5, 1.0, 2.0};
+    const std::size_t underlyings = 20;
+
+    std::vector<double> spots(underlyings);
+    for (auto& spot : spots) {
+        spot = 20.0 + 480.0 * uniform(rng);
+    }
+
+    core::OptionBatch batch;
+    batch.reserve(rows);
+    for (std::size_t i = 0; i < rows; ++i) {
+        std::size_t underlying = static_cast<std::size_t>(uniform(rng) * underlyings) % underlyings;
+        std::size_t expiry = static_cast<std::size_t>(uniform(rng) * 5) % 5;
+        double spot = spots[underlying];
+        double strike = spot * (0.7 + 0.6 * uniform(rng));
+        double vol = 0.15 + 0.02 * static_cast<double>(underlying % 10) + 0.01 * static_cast<double>(expiry);
+        core::OptionType type = uniform(rng) < 0.5 ? core::OptionType::Call : core::OptionType::Put;
+        batch.add(core::Option(type, strike, maturities[expiry]), core::MarketData(spot, 0.03, vol));
+    }
+    return batch;
+}
+
+double AutoTuner::throughput(const core::OptionBatch& batch, const BatchSettings& settings) const {
+    BatchEngine engine(settings);
+    double best = 0.0;
+    for (std::size_t run = 0; run < settings_.repetitions; ++run) {
+        auto start = std::chrono::steady_clock::now();
+        auto results = engine.price(batch);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        if (results.size() != batch.size()) {
+            throw std::runtime_error("Calibration run lost rows");
+        }
+        best = std::max(best, static_cast<double>(batch.size()) / std::max(elapsed.count(), 1e-9));
+    }
+    return best;
+}
+
+TuningProfile AutoTuner::calibrate() const {
+    core::OptionBatch batch = syntheticBatch(settings_.rows, settings_.seed);
+    unsigned hardware = util::resolveThreadCount(0);
+
+    BatchSettings best;
+    best.withGreeks = settings_.withGreeks;
+    best.numThreads = hardware;
+    double bestRate = 0.0;
+    auto trial = [&](const BatchSettings& candidate) {
+        double rate = throughput(batch, candidate);
+        if (rate > bestRate) {
+            bestRate = rate;
+            best = candidate;
+        }
+    };
+
+    BatchSettings start = best;
+    for (BatchKernel kernel : {BatchKernel::Grouped, BatchKernel::PerRow}) {
+        for (bool reorder : {false, true}) {
+            BatchSettings candidate = start;
+            candidate.kernel = kernel;
+            candidate.reorder = reorder;
+            trial(candidate);
+        }
+    }
+
+    std::vector<unsigned> threadCounts;
+    for (unsigned threads = 1; threads < hardware; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    start = best;
+    for (unsigned threads : threadCounts) {
+        BatchSettings candidate = start;
+        candidate.numThreads = threads;
+        trial(candidate);
+    }
+
+    start = best;
+    for (std::size_t chunkSize : {256u, 1024u, 16384u, 65536u}) {
+        BatchSettings candidate = start;
+        candidate.chunkSize = chunkSize;
+        trial(candidate);
+    }
+
+    TuningProfile profile;
+    profile.numThreads = best.numThreads;
+    profile.chunkSize = best.chunkSize;
+    profile.kernel = best.kernel;
+    profile.reorder = best.reorder;
+    profile.rowsPerSecond = bestRate;
+    profile.host = hostName();
+    profile.hardwareThreads = hardware;
+    return profile;
+}
+
+} // namespace batch
+} // namespace pricing
@@ -0,0 +1,109 @@
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include "../../include/pricing/batch/BatchEngine.hpp"
+#include "../../include/pricing/models/BlackScholesModel.hpp"
+#include "../../include/pricing/util/Parallel.hpp"
+#include "../../include/pricing/util/RadixSort.hpp"
+
+namespace pricing {
+namespace batch {
+
+BatchEngine::BatchEngine(const BatchSettings& settings)
+    : settings_(settings) {
+    if (settings_.chunkSize == 0) {
+        throw std::invalid_argument("Batch chunk size must be positive");
+    }
+}
+
+std::vector<std::uint32_t> BatchEngine::localityOrder(const core::OptionBatch& batch, unsigned numThreads) {
+    std::size_t n = batch.size();
+    if (n > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::invalid_argument("Batch too large to reorder");
+    }
+    std::vector<std::uint32_t> order(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        order[i] = static_cast<std::uint32_t>(i);
+    }
+
+    // Least significant key first; each pass is stable
+    std::vector<std::uint64_t> keys(n);
+    for (const util::BatchVector<double>* field : {&batch.strikes, &batch.maturities, &batch.spots}) {
+        for (std::size_t i = 0; i < n; ++i) {
+            keys[i] = util::sortableKey((*field)[i]);
+        }
+        util::radixSortIndices(order, keys, numThreads);
+    }
+    return order;
+}
+
+void BatchEngine::priceChunks(const core::OptionBatch& batch, core::PricingResult* results) const {
+    models::BlackScholesModel model;
+    std::size_t n = batch.size();
+    std::size_t chunks = (n + settings_.chunkSize - 1) / settings_.chunkSize;
+    util::parallelFor(chunks, settings_.numThreads, [&](std::size_t c) {
+        std::size_t begin = c * settings_.chunkSize;
+        std::size_t end = std::min(n, begin + settings_.chunkSize);
+        if (settings_.kernel == BatchKernel::Grouped) {
+            model.priceBatch(batch, begin, end, settings_.withGreeks, results);
+            return;
+        }
+        for (std::size_t k = begin; k < end; ++k) {
+            core::Option option(batch.types[k], batch.strikes[k], batch.maturities[k]);
+            core::MarketData marketData(batch.spots[k], batch.rates[k], batch.volatilities[k]);
+            results[k] = settings_.withGreeks ? model.priceWithGreeks(option, marketData)
+                                              : model.price(option, marketData);
+        }
+    });
+}
+
+std::vector<core::PricingResult> BatchEngine::price(const core::OptionBatch& batch) const {
+    std::vector<core::PricingResult> results(batch.size());
+    if (!settings_.reorder) {
+        priceChunks(batch, results.data());
+        return results;
+    }
+
+    std::vector<std::uint32_t> order = localityOrder(batch, settings_.numThreads);
+    core::OptionBatch sorted = batch.permuted(order);
+    std::vector<core::PricingResult> sortedResults(batch.size());
+    priceChunks(sorted, sortedResults.data());
+
+    // Restore input order
+    for (std::size_t k = 0; k < order.size(); ++k) {
+        results[order[k]] = sortedResults[k];
+    }
+    return results;
+}
+
+void BatchEngine::priceSorted(
+    ExternalSorter& sorter,
+    const std::function<void(std::uint64_t row, const core::PricingResult&)>& sink) const {
+    std::size_t blockRows = settings_.chunkSize * util::resolveThreadCount(settings_.numThreads);
+    core::OptionBatch block;
+    std::vector<std::uint64_t> rows;
+    std::vector<core::PricingResult> results;
+    block.reserve(blockRows);
+    rows.reserve(blockRows);
+
+    SortRecord record;
+    bool more = true;
+    while (more) {
+        block.clear();
+        rows.clear();
+        while (rows.size() < blockRows && (more = sorter.next(record))) {
+            block.add(record.option(), record.marketData());
+            rows.push_back(record.row);
+        }
+
+        results.assign(rows.size(), core::PricingResult());
+        priceChunks(block, results.data());
+        for (std::size_t k = 0; k < rows.size(); ++k) {
+            sink(rows[k], results[k]);
+        }
+    }
+}
+
+} // namespace batch
+} // namespace pricing
@@ -0,0 +1,130 @@
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include "../../include/pricing/batch/DeltaPublisher.hpp"
+
+namespace pricing {
+namespace batch {
+
+namespace {
+    const char stateMagic[8] = {'P', 'R', 'P', 'U', 'B', 'S', 'T', '1'};
+    const std::size_t initialSlots = 1024;
+}
+
+DeltaPublisher::DeltaPublisher(const PublicationSettings& settings)
+    : settings_(settings), slots_(initialSlots) {
+    if (!(settings_.threshold >= 0.0)) {
+        throw std::invalid_argument("Publication threshold must be non-negative");
+    }
+}
+
+util::ContentKey DeltaPublisher::normalize(util::ContentKey key) {
+    if (isEmpty(key)) {
+        key.high = 1;
+    }
+    return key;
+}
+
+DeltaPublisher::Slot& DeltaPublisher::slot(const util::ContentKey& instrument) {
+    std::size_t mask = slots_.size() - 1;
+    for (std::size_t index = instrument.low & mask;; index = (index + 1) & mask) {
+        Slot& candidate = slots_[index];
+        if (isEmpty(candidate.instrument) || candidate.instrument == instrument) {
+            return candidate;
+        }
+    }
+}
+
+void DeltaPublisher::grow() {
+    std::vector<Slot> old(slots_.size() * 2);
+    old.swap(slots_);
+    for (const Slot& entry : old) {
+        if (!isEmpty(entry.instrument)) {
+            slot(entry.instrument) = entry;
+        }
+    }
+}
+
+bool DeltaPublisher::update(const util::ContentKey& instrument, const core::PricingResult& result) {
+    util::ContentKey key = normalize(instrument);
+    double values[6] = {result.price, result.delta, result.gamma, result.vega, result.theta, result.rho};
+    std::size_t tracked = settings_.trackGreeks ? 6 : 1;
+
+    Slot* entry = &slot(key);
+    if (!isEmpty(entry->instrument)) {
+        bool changed = false;
+        for (std::size_t k = 0; k < tracked && !changed; ++k) {
+            changed = !(std::abs(values[k] - entry->values[k]) <= settings_.threshold);
+        }
+        if (!changed) {
+            return false;
+        }
+    } else {
+        if (2 * (count_ + 1) > slots_.size()) {
+            grow();
+            entry = &slot(key);
+        }
+        entry->instrument = key;
+        ++count_;
+    }
+    std::memcpy(entry->values, values, sizeof(values));
+    return true;
+}
+
+// Written through a temporary file renamed into place, so a crash mid-save
+// leaves the previous state intact
+void DeltaPublisher::save(const std::string& path) const {
+    std::string temporary = path + ".tmp";
+    std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Cannot open file: " + temporary);
+    }
+    std::uint64_t count = count_;
+    out.write(stateMagic, sizeof(stateMagic));
+    out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    for (const Slot& entry : slots_) {
+        if (!isEmpty(entry.instrument)) {
+            out.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+        }
+    }
+    out.close();
+    if (!out || std::rename(temporary.c_str(), path.c_str()) != 0) {
+        throw std::runtime_error("Cannot write file: " + path);
+    }
+}
+
+void DeltaPublisher::load(const std::string& path) {
+    slots_.assign(initialSlots, Slot());
+    count_ = 0;
+
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return;
+    }
+    char magic[sizeof(stateMagic)];
+    std::uint64_t count = 0;
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, stateMagic, sizeof(stateMagic)) != 0
+        || !in.read(reinterpret_cast<char*>(&count), sizeof(count))) {
+        throw std::runtime_error("Invalid publication state file: " + path);
+    }
+    for (std::uint64_t i = 0; i < count; ++i) {
+        Slot entry;
+        if (!in.read(reinterpret_cast<char*>(&entry), sizeof(entry)) || isEmpty(entry.instrument)) {
+            throw std::runtime_error("Invalid publication state file: " + path);
+        }
+        if (2 * (count_ + 1) > slots_.size()) {
+            grow();
+        }
+        Slot& target = slot(entry.instrument);
+        if (isEmpty(target.instrument)) {
+            ++count_;
+        }
+        target = entry;
+    }
+}
+
+} // namespace batch
+} // namespace pricing
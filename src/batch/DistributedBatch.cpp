@@ -0,0 +1,749 @@
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "../../include/pricing/batch/DistributedBatch.hpp"
+
+namespace pricing {
+namespace batch {
+
+namespace {
+    // Every message is one frame: FrameHeader, then length payload bytes.
+    // Numbers are in the byte order of the hosts, which must agree; the
+    // version field tells a swapped or older peer apart.
+    const char frameMagic[4] = {'P', 'R', 'S', 'H'};
+    const std::uint16_t protocolVersion = 3;
+
+    // Task rows are type, model index, outputs and five doubles; result rows
+    // are six doubles plus, when rejected, an index and a message
+    const std::size_t taskRowBytes = sizeof(std::uint8_t) + sizeof(std::uint16_t) + sizeof(std::uint32_t)
+        + 5 * sizeof(double);
+    const std::size_t maxMessageLength = 256;
+    const std::size_t resultRowBytes = 6 * sizeof(double) + sizeof(std::uint64_t) + sizeof(std::uint32_t)
+        + maxMessageLength;
+    // A full shard of the larger kind plus room for the model names
+    const std::uint64_t maxFrameLength = DistributedSettings::kMaxShardRows * resultRowBytes + (1 << 20);
+
+    enum FrameType : std::uint16_t {
+        TaskFrame = 1,      // shard, progress interval, rows, model names, then the row columns
+        ResultFrame = 2,    // shard, rows, six values per row, then the rejected rows
+        ErrorFrame = 3,     // shard, message
+        ProgressFrame = 4   // shard; sent while the shard is being priced
+    };
+
+    struct FrameHeader {
+        char magic[4];
+        std::uint16_t version;
+        std::uint16_t type;
+        std::uint64_t length;
+    };
+
+    // A worker could not price a shard; retrying elsewhere would not help
+    struct RemoteError : std::runtime_error {
+        using std::runtime_error::runtime_error;
+    };
+
+    class FrameWriter {
+    public:
+        explicit FrameWriter(FrameType type) : type_(type), data_(sizeof(FrameHeader), '\0') {}
+
+        template <typename T>
+        void put(const T& value) {
+            data_.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        template <typename T>
+        void putArray(const T* values, std::size_t count) {
+            data_.append(reinterpret_cast<const char*>(values), count * sizeof(T));
+        }
+
+        void putString(const std::string& text) {
+            put(static_cast<std::uint32_t>(text.size()));
+            data_.append(text);
+        }
+
+        const std::string& finish() {
+            FrameHeader header;
+            std::memcpy(header.magic, frameMagic, sizeof(frameMagic));
+            header.version = protocolVersion;
+            header.type = type_;
+            header.length = data_.size() - sizeof(FrameHeader);
+            std::memcpy(&data_[0], &header, sizeof(header));
+            return data_;
+        }
+
+    private:
+        FrameType type_;
+        std::string data_;
+    };
+
+    class FrameReader {
+    public:
+        explicit FrameReader(const std::string& payload)
+            : cursor_(payload.data()), end_(payload.data() + payload.size()) {}
+
+        template <typename T>
+        T get() {
+            T value;
+            take(&value, sizeof(T));
+            return value;
+        }
+
+        template <typename T>
+        void getArray(T* values, std::size_t count) {
+            if (count > static_cast<std::size_t>(end_ - cursor_) / sizeof(T)) {
+                throw std::runtime_error("Truncated shard frame");
+            }
+            take(values, count * sizeof(T));
+        }
+
+        std::string getString() {
+            std::uint32_t size = get<std::uint32_t>();
+            if (size > static_cast<std::size_t>(end_ - cursor_)) {
+                throw std::runtime_error("Truncated shard frame");
+            }
+            std::string text(cursor_, size);
+            cursor_ += size;
+            return text;
+        }
+
+        bool finished() const { return cursor_ == end_; }
+        std::size_t remaining() const { return static_cast<std::size_t>(end_ - cursor_); }
+
+    private:
+        void take(void* target, std::size_t size) {
+            if (size > static_cast<std::size_t>(end_ - cursor_)) {
+                throw std::runtime_error("Truncated shard frame");
+            }
+            if (size > 0) {
+                std::memcpy(target, cursor_, size);
+            }
+            cursor_ += size;
+        }
+
+        const char* cursor_;
+        const char* end_;
+    };
+
+    void sendAll(int fd, const std::string& data) {
+        const char* cursor = data.data();
+        std::size_t remaining = data.size();
+        while (remaining > 0) {
+            ssize_t sent = ::send(fd, cursor, remaining, MSG_NOSIGNAL);
+            if (sent < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw std::runtime_error(std::string("Send failed: ") + std::strerror(errno));
+            }
+            cursor += sent;
+            remaining -= static_cast<std::size_t>(sent);
+        }
+    }
+
+    // False if the peer closed the connection before the first byte
+    bool receiveAll(int fd, char* data, std::size_t size) {
+        std::size_t received = 0;
+        while (received < size) {
+            ssize_t count = ::recv(fd, data + received, size - received, 0);
+            if (count < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw std::runtime_error(std::string("Receive failed: ") + std::strerror(errno));
+            }
+            if (count == 0) {
+                if (received == 0) {
+                    return false;
+                }
+                throw std::runtime_error("Connection closed inside a frame");
+            }
+            received += static_cast<std::size_t>(count);
+        }
+        return true;
+    }
+
+    bool receiveFrame(int fd, FrameType& type, std::string& payload) {
+        FrameHeader header;
+        if (!receiveAll(fd, reinterpret_cast<char*>(&header), sizeof(header))) {
+            return false;
+        }
+        if (std::memcmp(header.magic, frameMagic, sizeof(frameMagic)) != 0 || header.version != protocolVersion
+            || header.length > maxFrameLength) {
+            throw std::runtime_error("Peer does not speak shard protocol version " + std::to_string(protocolVersion));
+        }
+        type = static_cast<FrameType>(header.type);
+        payload.resize(static_cast<std::size_t>(header.length));
+        if (header.length > 0 && !receiveAll(fd, &payload[0], payload.size())) {
+            throw std::runtime_error("Connection closed inside a frame");
+        }
+        return true;
+    }
+
+    void setTimeouts(int fd, double seconds) {
+        if (seconds <= 0.0) {
+            return;
+        }
+        timeval limit;
+        limit.tv_sec = static_cast<time_t>(seconds);
+        limit.tv_usec = static_cast<suseconds_t>((seconds - static_cast<double>(limit.tv_sec)) * 1e6);
+        ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &limit, sizeof(limit));
+        ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &limit, sizeof(limit));     // Also bounds connect()
+    }
+
+    void disableNagle(int fd) {
+        int enable = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+    }
+
+    // Probes an idle connection after 10 s and gives it up after three
+    // unanswered probes 5 s apart, so a dead host or network path ends the
+    // call even without a timeout
+    void enableKeepAlive(int fd) {
+        int enable = 1;
+        ::setsockopt(fd, SOL_SOCKET, SO_KEEPALIVE, &enable, sizeof(enable));
+#ifdef TCP_KEEPIDLE
+        int idle = 10, interval = 5, probes = 3;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_KEEPIDLE, &idle, sizeof(idle));
+        ::setsockopt(fd, IPPROTO_TCP, TCP_KEEPINTVL, &interval, sizeof(interval));
+        ::setsockopt(fd, IPPROTO_TCP, TCP_KEEPCNT, &probes, sizeof(probes));
+#endif
+    }
+
+    std::string describe(const WorkerAddress& address) {
+        return address.host + ":" + std::to_string(address.port);
+    }
+
+    struct AddressList {
+        addrinfo* head = nullptr;
+        ~AddressList() {
+            if (head != nullptr) {
+                ::freeaddrinfo(head);
+            }
+        }
+    };
+
+    void resolve(const WorkerAddress& address, bool passive, AddressList& list) {
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_flags = passive ? AI_PASSIVE : 0;
+        std::string port = std::to_string(address.port);
+        int status = ::getaddrinfo(address.host.empty() ? nullptr : address.host.c_str(), port.c_str(), &hints, &list.head);
+        if (status != 0) {
+            throw std::runtime_error("Cannot resolve " + describe(address) + ": " + ::gai_strerror(status));
+        }
+    }
+
+    int connectTo(const WorkerAddress& address, double timeoutSeconds) {
+        AddressList list;
+        resolve(address, false, list);
+        for (addrinfo* candidate = list.head; candidate != nullptr; candidate = candidate->ai_next) {
+            int fd = ::socket(candidate->ai_family, candidate->ai_socktype, candidate->ai_protocol);
+            if (fd < 0) {
+                continue;
+            }
+            setTimeouts(fd, timeoutSeconds);
+            if (::connect(fd, candidate->ai_addr, candidate->ai_addrlen) == 0) {
+                disableNagle(fd);
+                enableKeepAlive(fd);
+                return fd;
+            }
+            ::close(fd);
+        }
+        throw std::runtime_error("Cannot connect to worker " + describe(address));
+    }
+
+    std::string encodeTask(std::uint64_t shard, std::uint32_t progressMillis, const core::OptionBatch& batch,
+                           const std::vector<RowRequest>& requests, std::size_t begin, std::size_t end) {
+        std::vector<std::string> models;
+        std::map<std::string, std::uint16_t> modelIndex;
+        std::vector<std::uint16_t> rowModels;
+        std::vector<std::uint32_t> rowOutputs;
+        std::vector<std::uint8_t> rowTypes;
+        for (std::size_t i = begin; i < end; ++i) {
+            auto found = modelIndex.find(requests[i].model);
+            if (found == modelIndex.end()) {
+                found = modelIndex.emplace(requests[i].model, static_cast<std::uint16_t>(models.size())).first;
+                models.push_back(requests[i].model);
+            }
+            rowModels.push_back(found->second);
+            rowOutputs.push_back(requests[i].outputs);
+            rowTypes.push_back(static_cast<std::uint8_t>(batch.types[i]));
+        }
+
+        std::size_t rows = end - begin;
+        FrameWriter frame(TaskFrame);
+        frame.put<std::uint64_t>(shard);
+        frame.put<std::uint32_t>(progressMillis);
+        frame.put<std::uint64_t>(rows);
+        frame.put<std::uint32_t>(static_cast<std::uint32_t>(models.size()));
+        for (const auto& model : models) {
+            frame.putString(model);
+        }
+        frame.putArray(rowTypes.data(), rows);
+        frame.putArray(rowModels.data(), rows);
+        frame.putArray(rowOutputs.data(), rows);
+        frame.putArray(batch.spots.data() + begin, rows);
+        frame.putArray(batch.strikes.data() + begin, rows);
+        frame.putArray(batch.rates.data() + begin, rows);
+        frame.putArray(batch.volatilities.data() + begin, rows);
+        frame.putArray(batch.maturities.data() + begin, rows);
+        return frame.finish();
+    }
+
+    // Rows are rebuilt through Option and MarketData, so they are validated
+    // as if they had been read locally
+    void decodeTask(FrameReader& reader, core::OptionBatch& batch, std::vector<RowRequest>& requests) {
+        std::uint64_t rows = reader.get<std::uint64_t>();
+        std::uint32_t modelCount = reader.get<std::uint32_t>();
+        if (rows > DistributedSettings::kMaxShardRows || modelCount > rows) {
+            throw std::runtime_error("Malformed shard frame");
+        }
+        std::vector<std::string> models;
+        for (std::uint32_t m = 0; m < modelCount; ++m) {
+            models.push_back(reader.getString());
+        }
+        // Nothing is allocated for rows the payload does not hold
+        std::size_t count = static_cast<std::size_t>(rows);
+        if (count * taskRowBytes != reader.remaining()) {
+            throw std::runtime_error("Malformed shard frame");
+        }
+        std::vector<std::uint8_t> types(count);
+        std::vector<std::uint16_t> rowModels(count);
+        std::vector<std::uint32_t> outputs(count);
+        std::vector<double> spots(count), strikes(count), rates(count), volatilities(count), maturities(count);
+        reader.getArray(types.data(), count);
+        reader.getArray(rowModels.data(), count);
+        reader.getArray(outputs.data(), count);
+        reader.getArray(spots.data(), count);
+        reader.getArray(strikes.data(), count);
+        reader.getArray(rates.data(), count);
+        reader.getArray(volatilities.data(), count);
+        reader.getArray(maturities.data(), count);
+        if (!reader.finished()) {
+            throw std::runtime_error("Trailing bytes in shard frame");
+        }
+
+        batch.reserve(count);
+        requests.resize(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            if (types[i] > static_cast<std::uint8_t>(core::OptionType::Put) || rowModels[i] >= models.size()) {
+                throw std::runtime_error("Malformed shard row");
+            }
+            batch.add(core::Option(static_cast<core::OptionType>(types[i]), strikes[i], maturities[i]),
+                      core::MarketData(spots[i], rates[i], volatilities[i]));
+            requests[i].model = models[rowModels[i]];
+            requests[i].outputs = outputs[i];
+        }
+    }
+
+    std::string encodeResult(std::uint64_t shard, const std::vector<core::PricingResult>& results,
+                             const std::vector<std::string>& errors) {
+        FrameWriter frame(ResultFrame);
+        frame.put<std::uint64_t>(shard);
+        frame.put<std::uint64_t>(results.size());
+        for (const auto& result : results) {
+            const double values[6] = {result.price, result.delta, result.gamma,
+                                      result.vega, result.theta, result.rho};
+            frame.putArray(values, 6);
+        }
+        std::uint64_t rejected = static_cast<std::uint64_t>(
+            std::count_if(errors.begin(), errors.end(), [](const std::string& e) { return !e.empty(); }));
+        frame.put<std::uint64_t>(rejected);
+        for (std::size_t i = 0; i < errors.size(); ++i) {
+            if (!errors[i].empty()) {
+                frame.put<std::uint64_t>(i);
+                frame.putString(errors[i].substr(0, maxMessageLength));
+            }
+        }
+        return frame.finish();
+    }
+
+    std::string encodeProgress(std::uint64_t shard) {
+        FrameWriter frame(ProgressFrame);
+        frame.put<std::uint64_t>(shard);
+        return frame.finish();
+    }
+
+    // Sends progress frames for a shard every interval until destroyed, so
+    // the coordinator's timeout bounds the silence of a worker rather than
+    // the time its shard takes. The reply is sent after it is gone.
+    class ProgressReporter {
+    public:
+        ProgressReporter(int connection, std::uint64_t shard, std::uint32_t intervalMillis) {
+            if (intervalMillis == 0) {
+                return;
+            }
+            thread_ = std::thread([this, connection, shard, intervalMillis]() {
+                std::string frame = encodeProgress(shard);
+                std::unique_lock<std::mutex> lock(mutex_);
+                while (!changed_.wait_for(lock, std::chrono::milliseconds(intervalMillis), [this]() { return done_; })) {
+                    try {
+                        sendAll(connection, frame);
+                    } catch (const std::exception&) {
+                        return;     // The reply will fail the same way
+                    }
+                }
+            });
+        }
+
+        ~ProgressReporter() {
+            if (!thread_.joinable()) {
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                done_ = true;
+            }
+            changed_.notify_one();
+            thread_.join();
+        }
+
+        ProgressReporter(const ProgressReporter&) = delete;
+        ProgressReporter& operator=(const ProgressReporter&) = delete;
+
+    private:
+        std::thread thread_;
+        std::mutex mutex_;
+        std::condition_variable changed_;
+        bool done_ = false;
+    };
+
+    std::string encodeError(std::uint64_t shard, const std::string& message) {
+        FrameWriter frame(ErrorFrame);
+        frame.put<std::uint64_t>(shard);
+        frame.putString(message);
+        return frame.finish();
+    }
+
+    void decodeResult(FrameReader& reader, std::uint64_t shard, core::PricingResult* results, std::string* errors,
+                      std::size_t rows) {
+        if (reader.get<std::uint64_t>() != shard || reader.get<std::uint64_t>() != rows) {
+            throw std::runtime_error("Worker answered another shard");
+        }
+        for (std::size_t i = 0; i < rows; ++i) {
+            double values[6];
+            reader.getArray(values, 6);
+            results[i].price = values[0];
+            results[i].delta = values[1];
+            results[i].gamma = values[2];
+            results[i].vega = values[3];
+            results[i].theta = values[4];
+            results[i].rho = values[5];
+        }
+        std::uint64_t rejected = reader.get<std::uint64_t>();
+        if (rejected > rows) {
+            throw std::runtime_error("Malformed result frame");
+        }
+        for (std::uint64_t k = 0; k < rejected; ++k) {
+            std::uint64_t row = reader.get<std::uint64_t>();
+            std::string message = reader.getString();
+            if (row >= rows) {
+                throw std::runtime_error("Malformed result frame");
+            }
+            if (errors != nullptr) {
+                errors[row] = message;
+            }
+        }
+        if (!reader.finished()) {
+            throw std::runtime_error("Trailing bytes in result frame");
+        }
+    }
+}
+
+WorkerAddress parseWorkerAddress(const std::string& text, const std::string& defaultHost) {
+    WorkerAddress address;
+    std::string port = text;
+    std::size_t colon = text.rfind(':');
+    address.host = defaultHost;
+    if (colon != std::string::npos) {
+        address.host = text.substr(0, colon);
+        port = text.substr(colon + 1);
+        if (address.host.size() >= 2 && address.host.front() == '[' && address.host.back() == ']') {
+            address.host = address.host.substr(1, address.host.size() - 2);
+        }
+    }
+    if (address.host.empty() || port.empty() || port.size() > 5
+        || port.find_first_not_of("0123456789") != std::string::npos || std::stoul(port) > 65535) {
+        throw std::invalid_argument("Invalid worker address: " + text);
+    }
+    address.port = static_cast<std::uint16_t>(std::stoul(port));
+    return address;
+}
+
+void DistributedSettings::validate() const {
+    if (shardRows == 0 || shardRows > kMaxShardRows) {
+        throw std::invalid_argument("Shard size must be between 1 and " + std::to_string(kMaxShardRows) + " rows");
+    }
+    if (maxAttempts == 0) {
+        throw std::invalid_argument("Shard attempts must be positive");
+    }
+    if (timeoutSeconds < 0.0) {
+        throw std::invalid_argument("Worker timeout must be non-negative");
+    }
+}
+
+ShardWorker::ShardWorker(const WorkerAddress& address, const BatchSettings& settings)
+    : settings_(settings) {
+    AddressList list;
+    resolve(address, true, list);
+    for (addrinfo* candidate = list.head; candidate != nullptr && listener_ < 0; candidate = candidate->ai_next) {
+        int fd = ::socket(candidate->ai_family, candidate->ai_socktype, candidate->ai_protocol);
+        if (fd < 0) {
+            continue;
+        }
+        int reuse = 1;
+        ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        if (::bind(fd, candidate->ai_addr, candidate->ai_addrlen) == 0 && ::listen(fd, 16) == 0) {
+            listener_ = fd;
+        } else {
+            ::close(fd);
+        }
+    }
+    if (listener_ < 0) {
+        throw std::runtime_error("Cannot listen on " + describe(address));
+    }
+
+    sockaddr_storage bound{};
+    socklen_t length = sizeof(bound);
+    ::getsockname(listener_, reinterpret_cast<sockaddr*>(&bound), &length);
+    port_ = bound.ss_family == AF_INET6
+        ? ntohs(reinterpret_cast<sockaddr_in6*>(&bound)->sin6_port)
+        : ntohs(reinterpret_cast<sockaddr_in*>(&bound)->sin_port);
+}
+
+ShardWorker::~ShardWorker() {
+    if (listener_ >= 0) {
+        ::close(listener_);
+    }
+}
+
+void ShardWorker::stop() {
+    stopping_ = true;
+    ::shutdown(listener_, SHUT_RDWR);
+    int connection = connection_.load();
+    if (connection >= 0) {
+        ::shutdown(connection, SHUT_RDWR);
+    }
+}
+
+void ShardWorker::serve() {
+    while (!stopping_) {
+        int connection = ::accept(listener_, nullptr, nullptr);
+        if (connection < 0) {
+            if (stopping_) {
+                break;
+            }
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            throw std::runtime_error(std::string("Accept failed: ") + std::strerror(errno));
+        }
+        connection_ = connection;
+        if (stopping_) {
+            ::shutdown(connection, SHUT_RDWR);
+        }
+        disableNagle(connection);
+        try {
+            handle(connection);
+        } catch (const std::exception&) {
+            // A broken connection only ends this coordinator's session
+        }
+        connection_ = -1;
+        ::close(connection);
+    }
+}
+
+void ShardWorker::handle(int connection) {
+    FrameType type;
+    std::string payload;
+    while (receiveFrame(connection, type, payload)) {
+        if (type != TaskFrame) {
+            throw std::runtime_error("Unexpected frame from coordinator");
+        }
+        FrameReader reader(payload);
+        std::uint64_t shard = reader.get<std::uint64_t>();
+        std::string reply;
+        try {
+            std::uint32_t progressMillis = reader.get<std::uint32_t>();
+            core::OptionBatch batch;
+            std::vector<RowRequest> requests;
+            decodeTask(reader, batch, requests);
+            std::vector<std::string> errors;
+            std::vector<core::PricingResult> results;
+            {
+                ProgressReporter progress(connection, shard, progressMillis);
+                results = ModelDispatcher(settings_).price(batch, requests, &errors);
+            }
+            reply = encodeResult(shard, results, errors);
+            ++shardsPriced_;
+        } catch (const std::exception& e) {
+            reply = encodeError(shard, e.what());
+        }
+        sendAll(connection, reply);
+    }
+}
+
+ShardCoordinator::ShardCoordinator(const std::vector<WorkerAddress>& workers, const DistributedSettings& settings)
+    : workers_(workers), settings_(settings) {
+    settings_.validate();
+    if (workers_.empty()) {
+        throw std::invalid_argument("At least one worker is required");
+    }
+}
+
+std::vector<core::PricingResult> ShardCoordinator::price(const core::OptionBatch& batch,
+                                                         const std::vector<RowRequest>& requests,
+                                                         std::vector<std::string>* errors) {
+    if (requests.size() != batch.size()) {
+        throw std::invalid_argument("Expected one request per batch row");
+    }
+    reassignedShards_ = 0;
+    failedWorkers_ = 0;
+    std::vector<core::PricingResult> results(batch.size());
+    if (errors != nullptr) {
+        errors->assign(batch.size(), std::string());
+    }
+    std::size_t shards = (batch.size() + settings_.shardRows - 1) / settings_.shardRows;
+    if (shards == 0) {
+        return results;
+    }
+
+    // Workers report progress four times per timeout
+    std::uint32_t progressMillis = settings_.timeoutSeconds > 0.0
+        ? static_cast<std::uint32_t>(std::max(1.0, std::min(settings_.timeoutSeconds * 250.0, 3600e3))) : 0;
+    std::vector<int> connections;
+    std::vector<std::size_t> addresses;     // Worker of each connection
+    for (std::size_t k = 0; k < workers_.size(); ++k) {
+        try {
+            connections.push_back(connectTo(workers_[k], settings_.timeoutSeconds));
+            addresses.push_back(k);
+        } catch (const std::exception&) {
+            ++failedWorkers_;
+        }
+    }
+    if (connections.empty()) {
+        throw std::runtime_error("No worker could be reached");
+    }
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<std::size_t> queue;
+    for (std::size_t shard = std::min(connections.size(), shards); shard < shards; ++shard) {
+        queue.push_back(shard);
+    }
+    std::vector<unsigned> attempts(shards, 0);
+    std::size_t done = 0;
+    std::size_t live = connections.size();
+    std::string error;
+
+    auto run = [&](std::size_t connection) {
+        int fd = connections[connection];
+        const WorkerAddress& worker = workers_[addresses[connection]];
+        std::size_t shard = connection < shards ? connection : shards;
+        for (;;) {
+            if (shard == shards) {
+                std::unique_lock<std::mutex> lock(mutex);
+                changed.wait(lock, [&]() { return !queue.empty() || done == shards || !error.empty(); });
+                if (done == shards || !error.empty()) {
+                    return;
+                }
+                shard = queue.front();
+                queue.pop_front();
+            }
+
+            std::size_t begin = shard * settings_.shardRows;
+            std::size_t end = std::min(batch.size(), begin + settings_.shardRows);
+            try {
+                sendAll(fd, encodeTask(shard, progressMillis, batch, requests, begin, end));
+                FrameType type;
+                std::string payload;
+                for (;;) {
+                    if (!receiveFrame(fd, type, payload)) {
+                        throw std::runtime_error("Worker closed the connection");
+                    }
+                    if (type != ProgressFrame) {
+                        break;
+                    }
+                    if (FrameReader(payload).get<std::uint64_t>() != shard) {
+                        throw std::runtime_error("Worker answered another shard");
+                    }
+                }
+                FrameReader reader(payload);
+                if (type == ErrorFrame) {
+                    reader.get<std::uint64_t>();
+                    throw RemoteError("Worker " + describe(worker) + " failed shard "
+                                      + std::to_string(shard) + ": " + reader.getString());
+                }
+                if (type != ResultFrame) {
+                    throw std::runtime_error("Unexpected frame from worker");
+                }
+                decodeResult(reader, shard, results.data() + begin,
+                             errors != nullptr ? errors->data() + begin : nullptr, end - begin);
+
+                std::lock_guard<std::mutex> lock(mutex);
+                if (++done == shards) {
+                    changed.notify_all();
+                }
+            } catch (const RemoteError& e) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (error.empty()) {
+                    error = e.what();
+                }
+                changed.notify_all();
+                return;
+            } catch (const std::exception& e) {
+                // The worker is retired; its shard goes to the front of the queue
+                std::lock_guard<std::mutex> lock(mutex);
+                ++failedWorkers_;
+                --live;
+                if (++attempts[shard] >= settings_.maxAttempts) {
+                    error = "Shard " + std::to_string(shard) + " failed on " + std::to_string(attempts[shard])
+                        + " workers, last " + describe(worker) + ": " + e.what();
+                } else if (live == 0) {
+                    error = std::string("All workers failed, last ") + describe(worker) + ": " + e.what();
+                } else {
+                    queue.push_front(shard);
+                    ++reassignedShards_;
+                }
+                changed.notify_all();
+                return;
+            }
+            shard = shards;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(connections.size());
+    for (std::size_t k = 0; k < connections.size(); ++k) {
+        threads.emplace_back(run, k);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (int fd : connections) {
+        ::close(fd);
+    }
+    if (!error.empty()) {
+        throw std::runtime_error(error);
+    }
+    return results;
+}
+
+} // namespace batch
+} // namespace pricing
@@ -0,0 +1,304 @@
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "../../include/pricing/batch/EventEngine.hpp"
+#include "../../include/pricing/core/OptionBatch.hpp"
+#include "../../include/pricing/models/BlackScholesModel.hpp"
+#include "../../include/pricing/util/Parallel.hpp"
+#include "../../include/pricing/util/SpscQueue.hpp"
+
+namespace pricing {
+namespace batch {
+
+namespace {
+    // Empty passes over the tick queue before a worker starts yielding
+    const unsigned kSpinPasses = 256;
+
+    std::vector<int> allowedCpus() {
+        std::vector<int> cpus;
+#ifdef __linux__
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                if (CPU_ISSET(cpu, &allowed)) {
+                    cpus.push_back(cpu);
+                }
+            }
+        }
+#endif
+        return cpus;
+    }
+
+    // Best effort: a worker that cannot be pinned runs unpinned
+    void pinCurrentThread(int cpu) {
+#ifdef __linux__
+        cpu_set_t single;
+        CPU_ZERO(&single);
+        CPU_SET(cpu, &single);
+        pthread_setaffinity_np(pthread_self(), sizeof(single), &single);
+#else
+        (void)cpu;
+#endif
+    }
+}
+
+struct EventEngine::Shard {
+    struct Event {
+        std::uint32_t underlying;
+        double spot;
+        std::uint64_t sequence;
+    };
+
+    // Rows [begin, end) of the batch belong to one underlying
+    struct Group {
+        std::size_t begin;
+        std::size_t end;
+        double spot;
+        std::uint64_t sequence;
+        bool dirty;
+    };
+
+    struct Pending {
+        std::uint32_t underlying;
+        core::Option option;
+        core::MarketData marketData;
+        std::size_t id;
+    };
+
+    explicit Shard(const EventEngineSettings& settings)
+        : ticks(settings.tickCapacity), quotes(settings.quoteCapacity) {
+    }
+
+    util::SpscQueue<Event> ticks;
+    util::SpscQueue<QuoteUpdate> quotes;
+
+    std::vector<Pending> pending;               // Options added before start()
+    core::OptionBatch batch;                    // Owned by the worker once started
+    std::vector<std::size_t> ids;               // Option index of each batch row
+    std::vector<Group> groups;
+    std::unordered_map<std::uint32_t, std::size_t> groupOf;
+    std::vector<core::PricingResult> results;
+
+    std::uint64_t published = 0;                // Producer side
+    std::atomic<std::uint64_t> processed{0};
+    std::atomic<std::uint64_t> dropped{0};
+    std::thread thread;
+};
+
+void EventEngineSettings::validate() const {
+    if (tickCapacity == 0 || quoteCapacity == 0) {
+        throw std::invalid_argument("Event engine queue capacities must be positive");
+    }
+    if (maxBatch == 0) {
+        throw std::invalid_argument("Event engine batch size must be positive");
+    }
+}
+
+EventEngine::EventEngine(const EventEngineSettings& settings)
+    : settings_(settings) {
+    settings_.validate();
+    unsigned count = util::resolveThreadCount(settings_.shards);
+    shards_.reserve(count);
+    for (unsigned i = 0; i < count; ++i) {
+        shards_.push_back(std::make_unique<Shard>(settings_));
+    }
+}
+
+EventEngine::~EventEngine() {
+    stop();
+}
+
+unsigned EventEngine::shardOf(std::uint32_t underlying) const {
+    return underlying % static_cast<unsigned>(shards_.size());
+}
+
+std::size_t EventEngine::addOption(std::uint32_t underlying, const core::Option& option,
+                                   const core::MarketData& marketData) {
+    if (started_) {
+        throw std::logic_error("Options must be added before the event engine starts");
+    }
+    if (option.isAmerican()) {
+        throw std::invalid_argument("Event engine prices European options only");
+    }
+    shards_[shardOf(underlying)]->pending.push_back(Shard::Pending{underlying, option, marketData, options_});
+    return options_++;
+}
+
+// Rows of an underlying are made adjacent, sorted by maturity and strike so
+// the batch kernel reuses its terms along each group
+void EventEngine::start() {
+    if (started_) {
+        throw std::logic_error("Event engine already started");
+    }
+    started_ = true;
+    for (auto& shard : shards_) {
+        const auto& pending = shard->pending;
+        std::vector<std::size_t> order(pending.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+            const auto& x = pending[a];
+            const auto& y = pending[b];
+            if (x.underlying != y.underlying) {
+                return x.underlying < y.underlying;
+            }
+            if (x.option.getTimeToExpiration() != y.option.getTimeToExpiration()) {
+                return x.option.getTimeToExpiration() < y.option.getTimeToExpiration();
+            }
+            return x.option.getStrike() < y.option.getStrike();
+        });
+
+        shard->batch.reserve(order.size());
+        for (std::size_t k = 0; k < order.size(); ++k) {
+            const auto& row = pending[order[k]];
+            if (k == 0 || pending[order[k - 1]].underlying != row.underlying) {
+                shard->groupOf[row.underlying] = shard->groups.size();
+                shard->groups.push_back(Shard::Group{k, k, row.marketData.getSpot(), 0, false});
+            }
+            shard->groups.back().end = k + 1;
+            shard->batch.add(row.option, row.marketData);
+            shard->ids.push_back(row.id);
+        }
+        shard->results.resize(order.size());
+        shard->pending.clear();
+        shard->pending.shrink_to_fit();
+    }
+
+    std::vector<int> cpus = settings_.pinThreads ? allowedCpus() : std::vector<int>();
+    for (std::size_t i = 0; i < shards_.size(); ++i) {
+        int cpu = cpus.empty() ? -1 : cpus[i % cpus.size()];
+        Shard& shard = *shards_[i];
+        shard.thread = std::thread([this, &shard, cpu]() {
+            if (cpu >= 0) {
+                pinCurrentThread(cpu);
+            }
+            run(shard);
+        });
+    }
+}
+
+void EventEngine::stop() {
+    stopping_.store(true, std::memory_order_release);
+    for (auto& shard : shards_) {
+        if (shard->thread.joinable()) {
+            shard->thread.join();
+        }
+    }
+}
+
+void EventEngine::publish(const Tick& tick) {
+    if (!started_ || stopping_.load(std::memory_order_relaxed)) {
+        throw std::logic_error("Ticks are published between start() and stop()");
+    }
+    if (!(tick.spot > 0.0)) {
+        throw std::invalid_argument("Tick spot must be positive");
+    }
+    Shard& shard = *shards_[shardOf(tick.underlying)];
+    Shard::Event event{tick.underlying, tick.spot, ++sequence_};
+    while (!shard.ticks.tryPush(event)) {
+        std::this_thread::yield();
+    }
+    ++shard.published;
+}
+
+void EventEngine::flush() {
+    for (auto& shard : shards_) {
+        while (shard->processed.load(std::memory_order_acquire) < shard->published) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool EventEngine::poll(QuoteUpdate& update) {
+    for (std::size_t k = 0; k < shards_.size(); ++k) {
+        std::size_t index = (nextPoll_ + k) % shards_.size();
+        if (shards_[index]->quotes.tryPop(update)) {
+            nextPoll_ = index + 1;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::uint64_t EventEngine::ticksProcessed() const {
+    std::uint64_t total = 0;
+    for (const auto& shard : shards_) {
+        total += shard->processed.load(std::memory_order_acquire);
+    }
+    return total;
+}
+
+std::uint64_t EventEngine::droppedQuotes() const {
+    std::uint64_t total = 0;
+    for (const auto& shard : shards_) {
+        total += shard->dropped.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+// Worker loop: conflate a pass of ticks to the last spot per underlying,
+// then reprice and publish every underlying the pass touched
+void EventEngine::run(Shard& shard) {
+    models::BlackScholesModel model;
+    std::vector<std::size_t> dirty;
+    unsigned idle = 0;
+    for (;;) {
+        std::size_t taken = 0;
+        Shard::Event event;
+        while (taken < settings_.maxBatch && shard.ticks.tryPop(event)) {
+            ++taken;
+            auto found = shard.groupOf.find(event.underlying);
+            if (found == shard.groupOf.end()) {
+                continue;
+            }
+            Shard::Group& group = shard.groups[found->second];
+            if (!group.dirty) {
+                group.dirty = true;
+                dirty.push_back(found->second);
+            }
+            group.spot = event.spot;
+            group.sequence = event.sequence;
+        }
+
+        if (taken == 0) {
+            if (stopping_.load(std::memory_order_acquire) && shard.ticks.empty()) {
+                return;
+            }
+            if (++idle > kSpinPasses) {
+                std::this_thread::yield();
+            }
+            continue;
+        }
+        idle = 0;
+
+        for (std::size_t index : dirty) {
+            Shard::Group& group = shard.groups[index];
+            group.dirty = false;
+            std::fill(shard.batch.spots.begin() + group.begin, shard.batch.spots.begin() + group.end, group.spot);
+            model.priceBatch(shard.batch, group.begin, group.end, settings_.withGreeks, shard.results.data());
+            for (std::size_t row = group.begin; row < group.end; ++row) {
+                QuoteUpdate update{shard.ids[row], group.sequence, group.spot, shard.results[row]};
+                while (!shard.quotes.tryPush(update)) {
+                    if (stopping_.load(std::memory_order_acquire)) {
+                        shard.dropped.fetch_add(1, std::memory_order_relaxed);
+                        break;
+                    }
+                    std::this_thread::yield();
+                }
+            }
+        }
+        dirty.clear();
+        shard.processed.fetch_add(taken, std::memory_order_release);
+    }
+}
+
+} // namespace batch
+} // namespace pricing
@@ -0,0 +1,323 @@
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+
+#include <unistd.h>
+
+#include "../../include/pricing/batch/ExternalSorter.hpp"
+#include "../../include/pricing/util/RadixSort.hpp"
+
+namespace pricing {
+namespace batch {
+
+namespace {
+    bool recordLess(const SortRecord& a, const SortRecord& b) {
+        for (int k = 0; k < 3; ++k) {
+            if (a.key[k] != b.key[k]) {
+                return a.key[k] < b.key[k];
+            }
+        }
+        return a.row < b.row;
+    }
+
+    // Buffered sequential reader of one run
+    class RunReader {
+    public:
+        RunReader(std::FILE* file, std::uint64_t count, std::size_t capacity)
+            : file_(file), remaining_(count), buffer_(capacity) {
+            if (std::fseek(file_, 0, SEEK_SET) != 0) {
+                throw std::runtime_error("Cannot rewind sort run");
+            }
+            refill();
+        }
+
+        bool done() const { return position_ == filled_; }
+        const SortRecord& current() const { return buffer_[position_]; }
+
+        void advance() {
+            if (++position_ == filled_) {
+                refill();
+            }
+        }
+
+    private:
+        void refill() {
+            std::size_t wanted = static_cast<std::size_t>(std::min<std::uint64_t>(remaining_, buffer_.size()));
+            if (wanted > 0 && std::fread(buffer_.data(), sizeof(SortRecord), wanted, file_) != wanted) {
+                throw std::runtime_error("Cannot read sort run");
+            }
+            remaining_ -= wanted;
+            position_ = 0;
+            filled_ = wanted;
+        }
+
+        std::FILE* file_;
+        std::uint64_t remaining_;
+        std::vector<SortRecord> buffer_;
+        std::size_t position_ = 0;
+        std::size_t filled_ = 0;
+    };
+
+    void writeRecords(std::FILE* file, const SortRecord* records, std::size_t count) {
+        if (count > 0 && std::fwrite(records, sizeof(SortRecord), count, file) != count) {
+            throw std::runtime_error("Cannot write sort run");
+        }
+    }
+}
+
+// Loser tree over the run readers: node 0 holds the current winner, every
+// inner node the loser of the match played there. Replacing the winner
+// replays only its path to the root, log2(k) comparisons per record.
+class ExternalSorter::Merger {
+public:
+    Merger(const std::vector<Run>& runs, std::size_t capacity) {
+        readers_.reserve(runs.size());
+        for (const Run& run : runs) {
+            readers_.emplace_back(run.file, run.count, capacity);
+        }
+        leaves_ = 1;
+        while (leaves_ < readers_.size()) {
+            leaves_ *= 2;
+        }
+        tree_.assign(leaves_, 0);
+        tree_[0] = build(1);
+    }
+
+    bool next(SortRecord& record) {
+        std::size_t winner = tree_[0];
+        if (!alive(winner)) {
+            return false;
+        }
+        record = readers_[winner].current();
+        readers_[winner].advance();
+
+        for (std::size_t node = (winner + leaves_) / 2; node >= 1; node /= 2) {
+            if (beats(tree_[node], winner)) {
+                std::swap(tree_[node], winner);
+            }
+        }
+        tree_[0] = winner;
+        return true;
+    }
+
+private:
+    bool alive(std::size_t leaf) const {
+        return leaf < readers_.size() && !readers_[leaf].done();
+    }
+
+    // Exhausted and padding leaves lose every match
+    bool beats(std::size_t a, std::size_t b) const {
+        if (!alive(a)) {
+            return false;
+        }
+        if (!alive(b)) {
+            return true;
+        }
+        return recordLess(readers_[a].current(), readers_[b].current());
+    }
+
+    std::size_t build(std::size_t node) {
+        if (node >= leaves_) {
+            return node - leaves_;
+        }
+        std::size_t left = build(2 * node);
+        std::size_t right = build(2 * node + 1);
+        bool leftWins = beats(left, right) || !alive(right);
+        tree_[node] = leftWins ? right : left;
+        return leftWins ? left : right;
+    }
+
+    std::vector<RunReader> readers_;
+    std::vector<std::size_t> tree_;
+    std::size_t leaves_ = 1;
+};
+
+core::Option SortRecord::option() const {
+    return core::Option(static_cast<core::OptionType>(type), strike, maturity);
+}
+
+core::MarketData SortRecord::marketData() const {
+    return core::MarketData(spot, rate, volatility);
+}
+
+ExternalSorter::ExternalSorter(const ExternalSortSettings& settings)
+    : settings_(settings) {
+    validate();
+    bufferCapacity_ = settings_.memoryLimit / sizeof(SortRecord);
+    buffer_.reserve(std::min<std::size_t>(bufferCapacity_, 1u << 16));
+}
+
+ExternalSorter::~ExternalSorter() {
+    merger_.reset();
+    for (const Run& run : runs_) {
+        std::fclose(run.file);
+    }
+}
+
+void ExternalSorter::validate() const {
+    if (settings_.memoryLimit < 64 * sizeof(SortRecord)) {
+        throw std::invalid_argument("External sort memory limit is too small");
+    }
+    if (settings_.mergeFanIn < 2) {
+        throw std::invalid_argument("External sort must merge at least two runs at once");
+    }
+}
+
+SortRecord ExternalSorter::localityRecord(std::uint64_t row, const core::Option& option,
+                                          const core::MarketData& marketData) {
+    SortRecord record;
+    record.key[0] = util::sortableKey(marketData.getSpot());
+    record.key[1] = util::sortableKey(option.getTimeToExpiration());
+    record.key[2] = util::sortableKey(option.getStrike());
+    record.row = row;
+    record.spot = marketData.getSpot();
+    record.strike = option.getStrike();
+    record.rate = marketData.getRiskFreeRate();
+    record.volatility = marketData.getVolatility();
+    record.maturity = option.getTimeToExpiration();
+    record.type = static_cast<std::uint64_t>(option.getType());
+    return record;
+}
+
+void ExternalSorter::add(const SortRecord& record) {
+    if (finished_) {
+        throw std::runtime_error("Cannot add records to a finished sort");
+    }
+    buffer_.push_back(record);
+    ++size_;
+    if (buffer_.size() == bufferCapacity_) {
+        spill();
+    }
+}
+
+std::FILE* ExternalSorter::createTempFile() const {
+    std::string directory = settings_.tempDirectory;
+    if (directory.empty()) {
+        const char* environment = std::getenv("TMPDIR");
+        directory = environment != nullptr && *environment != '\0' ? environment : "/tmp";
+    }
+    std::string pattern = directory + "/pricing-sort-XXXXXX";
+    std::vector<char> path(pattern.begin(), pattern.end());
+    path.push_back('\0');
+
+    int fd = ::mkstemp(path.data());
+    if (fd < 0) {
+        throw std::runtime_error("Cannot create sort run in " + directory);
+    }
+    // Unlinked right away: the space is released when the file is closed,
+    // even if the process dies
+    ::unlink(path.data());
+    std::FILE* file = ::fdopen(fd, "w+b");
+    if (file == nullptr) {
+        ::close(fd);
+        throw std::runtime_error("Cannot create sort run in " + directory);
+    }
+    return file;
+}
+
+std::size_t ExternalSorter::readerCapacity() const {
+    std::size_t perReader = settings_.memoryLimit / ((settings_.mergeFanIn + 1) * sizeof(SortRecord));
+    return std::max<std::size_t>(perReader, 64);
+}
+
+void ExternalSorter::spill() {
+    std::sort(buffer_.begin(), buffer_.end(), recordLess);
+    std::FILE* file = createTempFile();
+    runs_.push_back(Run{file, 0, 0});
+    writeRecords(file, buffer_.data(), buffer_.size());
+    runs_.back().count = buffer_.size();
+    buffer_.clear();
+    ++spilledRuns_;
+
+    // Merge runs of one level as soon as a full fan-in of them exists
+    for (unsigned level = 0;; ++level) {
+        std::vector<Run> sameLevel;
+        for (const Run& run : runs_) {
+            if (run.level == level) {
+                sameLevel.push_back(run);
+            }
+        }
+        if (sameLevel.size() < settings_.mergeFanIn) {
+            break;
+        }
+        runs_.erase(std::remove_if(runs_.begin(), runs_.end(),
+                                   [level](const Run& run) { return run.level == level; }),
+                    runs_.end());
+        mergeRuns(sameLevel, level + 1);
+    }
+}
+
+void ExternalSorter::mergeRuns(std::vector<Run> inputs, unsigned level) {
+    Run output{createTempFile(), 0, level};
+    try {
+        Merger merger(inputs, readerCapacity());
+        std::vector<SortRecord> pending;
+        pending.reserve(readerCapacity());
+        SortRecord record;
+        while (merger.next(record)) {
+            pending.push_back(record);
+            if (pending.size() == pending.capacity()) {
+                writeRecords(output.file, pending.data(), pending.size());
+                output.count += pending.size();
+                pending.clear();
+            }
+        }
+        writeRecords(output.file, pending.data(), pending.size());
+        output.count += pending.size();
+    } catch (...) {
+        std::fclose(output.file);
+        runs_.insert(runs_.end(), inputs.begin(), inputs.end());
+        throw;
+    }
+    for (const Run& run : inputs) {
+        std::fclose(run.file);
+    }
+    runs_.push_back(output);
+}
+
+void ExternalSorter::finish() {
+    if (finished_) {
+        return;
+    }
+    finished_ = true;
+    if (runs_.empty()) {
+        std::sort(buffer_.begin(), buffer_.end(), recordLess);
+        return;
+    }
+    if (!buffer_.empty()) {
+        spill();
+    }
+    std::vector<SortRecord>().swap(buffer_);
+
+    // Runs left on several levels: merge the smallest until one fan-in remains
+    while (runs_.size() > settings_.mergeFanIn) {
+        std::sort(runs_.begin(), runs_.end(),
+                  [](const Run& a, const Run& b) { return a.count < b.count; });
+        std::size_t count = runs_.size() - settings_.mergeFanIn + 1;
+        std::vector<Run> smallest(runs_.begin(), runs_.begin() + static_cast<std::ptrdiff_t>(count));
+        runs_.erase(runs_.begin(), runs_.begin() + static_cast<std::ptrdiff_t>(count));
+        unsigned level = 0;
+        for (const Run& run : smallest) {
+            level = std::max(level, run.level + 1);
+        }
+        mergeRuns(smallest, level);
+    }
+    merger_.reset(new Merger(runs_, readerCapacity()));
+}
+
+bool ExternalSorter::next(SortRecord& record) {
+    if (!finished_) {
+        throw std::runtime_error("External sort must be finished before reading");
+    }
+    if (merger_) {
+        return merger_->next(record);
+    }
+    if (bufferPosition_ == buffer_.size()) {
+        return false;
+    }
+    record = buffer_[bufferPosition_++];
+    return true;
+}
+
+} // namespace batch
+} // namespace pricing
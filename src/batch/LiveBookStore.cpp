@@ -0,0 +1,371 @@
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../../include/pricing/batch/LiveBookStore.hpp"
+
+namespace pricing {
+namespace batch {
+
+namespace {
+    const char bookMagic[8] = {'P', 'R', 'L', 'I', 'V', 'E', 'B', 'K'};
+
+    const std::uint16_t hasResult = 1;
+
+    RowInvariants computeInvariants(double rate, double volatility, double maturity) {
+        RowInvariants invariants;
+        invariants.volSqrtT = volatility * std::sqrt(maturity);
+        invariants.drift = (rate + 0.5 * volatility * volatility) * maturity;
+        invariants.discount = std::exp(-rate * maturity);
+        return invariants;
+    }
+
+    // Keeps the compiler from moving row stores across the sequence updates;
+    // enough for a process crash, where the mapping itself survives
+    void orderStores() {
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+    }
+}
+
+// On-disk layout: Header, then capacity Rows
+struct LiveBookStore::Header {
+    char magic[8];
+    std::uint32_t layoutVersion;
+    std::uint32_t rowSize;
+    std::uint64_t capacity;
+    std::uint64_t count;
+    std::uint64_t marketVersion;
+    std::uint64_t open;         // Nonzero while a process has the file mapped
+    std::uint64_t reserved[2];
+};
+
+struct LiveBookStore::Row {
+    std::uint64_t sequence;     // Odd while the row is being written
+    std::uint32_t underlying;
+    std::uint8_t type;
+    std::uint8_t exercise;
+    std::uint16_t flags;
+    double quantity;
+    double strike;
+    double maturity;
+    double spot;
+    double rate;
+    double volatility;
+    RowInvariants invariants;
+    std::uint64_t resultVersion;
+    double values[6];           // Price, delta, gamma, vega, theta, rho
+};
+
+LiveBookStore::LiveBookStore(const std::string& path, std::size_t initialCapacity)
+    : path_(path) {
+    // Any change to Header or Row needs a new kLayoutVersion
+    static_assert(sizeof(Header) == 64, "Live book header layout changed");
+    static_assert(sizeof(Row) == 144, "Live book row layout changed");
+    if (initialCapacity == 0) {
+        throw std::invalid_argument("Live book capacity must be positive");
+    }
+    open(initialCapacity);
+    cleanShutdown_ = restored_ && header()->open == 0;
+    recover();
+    header()->open = 1;
+}
+
+LiveBookStore::~LiveBookStore() {
+    if (mapping_ != nullptr) {
+        header()->open = 0;
+        ::msync(mapping_, length_, MS_SYNC);
+    }
+    unmap();
+}
+
+LiveBookStore::Header* LiveBookStore::header() const {
+    return static_cast<Header*>(mapping_);
+}
+
+LiveBookStore::Row& LiveBookStore::row(std::size_t index) const {
+    if (index >= size()) {
+        throw std::out_of_range("Live book row out of range");
+    }
+    return reinterpret_cast<Row*>(static_cast<char*>(mapping_) + sizeof(Header))[index];
+}
+
+std::size_t LiveBookStore::size() const {
+    return static_cast<std::size_t>(header()->count);
+}
+
+std::size_t LiveBookStore::capacity() const {
+    return static_cast<std::size_t>(header()->capacity);
+}
+
+void LiveBookStore::open(std::size_t initialCapacity) {
+    int fd = ::open(path_.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open live book file: " + path_);
+    }
+    try {
+        attach(fd, initialCapacity);
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+    ::close(fd);
+}
+
+void LiveBookStore::attach(int fd, std::size_t initialCapacity) {
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        throw std::runtime_error("Cannot open live book file: " + path_);
+    }
+    if (info.st_size == 0) {
+        create(fd, initialCapacity);
+        return;
+    }
+
+    // Anything else must be a live book: a mistyped path must not wipe a file
+    Header stored;
+    std::string problem;
+    if (static_cast<std::size_t>(info.st_size) < sizeof(Header)
+        || ::pread(fd, &stored, sizeof(stored), 0) != static_cast<ssize_t>(sizeof(stored))
+        || std::memcmp(stored.magic, bookMagic, sizeof(bookMagic)) != 0) {
+        problem = "is not a live book";
+    } else if (stored.layoutVersion != kLayoutVersion) {
+        problem = "has layout version " + std::to_string(stored.layoutVersion)
+            + ", expected " + std::to_string(kLayoutVersion);
+    } else if (stored.rowSize != sizeof(Row)) {
+        problem = "has rows of " + std::to_string(stored.rowSize) + " bytes";
+    }
+
+    // The capacity follows the file size: grow() extends the file before
+    // it records the new capacity, and a crash in between must not cost
+    // the book
+    std::uint64_t rows = problem.empty()
+        ? (static_cast<std::uint64_t>(info.st_size) - sizeof(Header)) / sizeof(Row) : 0;
+    if (problem.empty() && rows == 0 && stored.count == 0) {
+        create(fd, initialCapacity);        // Creation was interrupted
+        return;
+    }
+    if (problem.empty() && (rows == 0 || stored.count > rows)) {
+        problem = "is truncated";
+    }
+    if (!problem.empty()) {
+        throw std::runtime_error("Live book file " + path_ + " " + problem);
+    }
+    std::size_t length = static_cast<std::size_t>(sizeof(Header) + rows * sizeof(Row));
+    mapping_ = map(fd, length);
+    length_ = length;
+    header()->capacity = rows;
+    restored_ = true;
+}
+
+void LiveBookStore::create(int fd, std::size_t capacity) {
+    Header fresh{};
+    std::memcpy(fresh.magic, bookMagic, sizeof(bookMagic));
+    fresh.layoutVersion = kLayoutVersion;
+    fresh.rowSize = sizeof(Row);
+    fresh.capacity = capacity;
+
+    std::size_t length = sizeof(Header) + capacity * sizeof(Row);
+    // Header first: a file cut short after it still reads as an empty book
+    bool written = ::pwrite(fd, &fresh, sizeof(fresh), 0) == static_cast<ssize_t>(sizeof(fresh))
+        && ::ftruncate(fd, static_cast<off_t>(length)) == 0;
+    if (!written) {
+        throw std::runtime_error("Cannot write live book file: " + path_);
+    }
+    mapping_ = map(fd, length);
+    length_ = length;
+}
+
+void* LiveBookStore::map(int fd, std::size_t length) const {
+    void* mapping = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Cannot map live book file: " + path_);
+    }
+    return mapping;
+}
+
+void LiveBookStore::unmap() {
+    if (mapping_ != nullptr) {
+        ::munmap(mapping_, length_);
+        mapping_ = nullptr;
+        length_ = 0;
+    }
+}
+
+// Doubles the row capacity in place; new rows are zero. The grown file is
+// mapped before the old mapping is released, so a failure keeps the book
+// usable at its current capacity.
+void LiveBookStore::grow() {
+    std::size_t capacity = 2 * this->capacity();
+    std::size_t length = sizeof(Header) + capacity * sizeof(Row);
+    int fd = ::open(path_.c_str(), O_RDWR);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open live book file: " + path_);
+    }
+    void* mapping = nullptr;
+    try {
+        if (::ftruncate(fd, static_cast<off_t>(length)) != 0) {
+            throw std::runtime_error("Cannot extend live book file: " + path_);
+        }
+        mapping = map(fd, length);
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+    ::close(fd);
+    unmap();
+    mapping_ = mapping;
+    length_ = length;
+    header()->capacity = capacity;
+}
+
+// Rows left odd by a crash keep whatever fields reached the mapping; their
+// results cannot be trusted
+void LiveBookStore::recover() {
+    for (std::size_t i = 0; i < size(); ++i) {
+        Row& torn = row(i);
+        if (torn.sequence % 2 != 0) {
+            torn.flags &= static_cast<std::uint16_t>(~hasResult);
+            torn.sequence += 1;
+            tornRows_.push_back(i);
+        }
+    }
+}
+
+LiveBookStore::Row& LiveBookStore::beginWrite(std::size_t index) {
+    Row& target = row(index);
+    target.sequence += 1;
+    orderStores();
+    return target;
+}
+
+void LiveBookStore::endWrite(Row& target) {
+    orderStores();
+    target.sequence += 1;
+}
+
+std::size_t LiveBookStore::add(std::uint32_t underlying, const core::Option& option,
+                               const core::MarketData& marketData, double quantity) {
+    if (size() == capacity()) {
+        grow();
+    }
+    std::size_t index = size();
+    Row& target = reinterpret_cast<Row*>(static_cast<char*>(mapping_) + sizeof(Header))[index];
+    target = Row{};
+    target.underlying = underlying;
+    target.type = static_cast<std::uint8_t>(option.getType());
+    target.exercise = static_cast<std::uint8_t>(option.getExerciseStyle());
+    target.quantity = quantity;
+    target.strike = option.getStrike();
+    target.maturity = option.getTimeToExpiration();
+    target.spot = marketData.getSpot();
+    target.rate = marketData.getRiskFreeRate();
+    target.volatility = marketData.getVolatility();
+    target.invariants = computeInvariants(target.rate, target.volatility, target.maturity);
+    orderStores();
+    header()->count = index + 1;
+    return index;
+}
+
+void LiveBookStore::setQuantity(std::size_t index, double quantity) {
+    Row& target = beginWrite(index);
+    target.quantity = quantity;
+    endWrite(target);
+}
+
+void LiveBookStore::setMarketData(std::size_t index, const core::MarketData& marketData) {
+    Row& target = beginWrite(index);
+    target.flags &= static_cast<std::uint16_t>(~hasResult);
+    target.spot = marketData.getSpot();
+    target.rate = marketData.getRiskFreeRate();
+    target.volatility = marketData.getVolatility();
+    target.invariants = computeInvariants(target.rate, target.volatility, target.maturity);
+    endWrite(target);
+}
+
+void LiveBookStore::storeResult(std::size_t index, const core::PricingResult& result) {
+    Row& target = beginWrite(index);
+    target.resultVersion = header()->marketVersion;
+    target.values[0] = result.price;
+    target.values[1] = result.delta;
+    target.values[2] = result.gamma;
+    target.values[3] = result.vega;
+    target.values[4] = result.theta;
+    target.values[5] = result.rho;
+    target.flags |= hasResult;
+    endWrite(target);
+}
+
+std::uint32_t LiveBookStore::underlying(std::size_t index) const {
+    return row(index).underlying;
+}
+
+core::Option LiveBookStore::option(std::size_t index) const {
+    const Row& source = row(index);
+    return core::Option(static_cast<core::OptionType>(source.type), source.strike, source.maturity,
+                        static_cast<core::ExerciseStyle>(source.exercise));
+}
+
+core::MarketData LiveBookStore::marketData(std::size_t index) const {
+    const Row& source = row(index);
+    return core::MarketData(source.spot, source.rate, source.volatility);
+}
+
+double LiveBookStore::quantity(std::size_t index) const {
+    return row(index).quantity;
+}
+
+RowInvariants LiveBookStore::invariants(std::size_t index) const {
+    return row(index).invariants;
+}
+
+bool LiveBookStore::result(std::size_t index, core::PricingResult& result, std::uint64_t* version) const {
+    const Row& source = row(index);
+    if (!(source.flags & hasResult)) {
+        return false;
+    }
+    result.price = source.values[0];
+    result.delta = source.values[1];
+    result.gamma = source.values[2];
+    result.vega = source.values[3];
+    result.theta = source.values[4];
+    result.rho = source.values[5];
+    if (version != nullptr) {
+        *version = source.resultVersion;
+    }
+    return true;
+}
+
+core::OptionBatch LiveBookStore::batch(std::size_t begin, std::size_t end) const {
+    if (begin > end || end > size()) {
+        throw std::out_of_range("Live book rows out of range");
+    }
+    core::OptionBatch result;
+    result.reserve(end - begin);
+    for (std::size_t i = begin; i < end; ++i) {
+        result.add(option(i), marketData(i));
+    }
+    return result;
+}
+
+std::uint64_t LiveBookStore::marketVersion() const {
+    return header()->marketVersion;
+}
+
+void LiveBookStore::setMarketVersion(std::uint64_t version) {
+    header()->marketVersion = version;
+}
+
+void LiveBookStore::sync() {
+    if (::msync(mapping_, length_, MS_SYNC) != 0) {
+        throw std::runtime_error("Cannot sync live book file: " + path_);
+    }
+}
+
+} // namespace batch
+} // namespace pricing
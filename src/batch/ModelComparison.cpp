@@ -0,0 +1,119 @@
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "../../include/pricing/batch/ModelComparison.hpp"
+#include "../../include/pricing/models/BlackScholesModel.hpp"
+#include "../../include/pricing/models/HestonModel.hpp"
+#include "../../include/pricing/models/ModelFactory.hpp"
+#include "../../include/pricing/util/Parallel.hpp"
+
+namespace pricing {
+namespace batch {
+
+namespace {
+    // Rows per task of numerical models, which take far longer per row
+    const std::size_t kNumericalChunk = 16;
+
+    struct Task {
+        std::size_t model;
+        std::size_t begin;
+        std::size_t end;
+    };
+}
+
+ModelComparison::ModelComparison(std::vector<ComparedModel> models, const BatchSettings& settings)
+    : models_(std::move(models)), settings_(settings) {
+    if (models_.empty()) {
+        throw std::invalid_argument("Model comparison needs at least one model");
+    }
+    if (settings_.chunkSize == 0) {
+        throw std::invalid_argument("Batch chunk size must be positive");
+    }
+    for (const auto& compared : models_) {
+        if (!compared.model) {
+            throw std::invalid_argument("Model comparison column without a model: " + compared.label);
+        }
+    }
+}
+
+ComparedModel ModelComparison::fromSpec(const std::string& spec, const core::HestonParameters* heston) {
+    ComparedModel compared;
+    std::string name = spec;
+    std::size_t separator = spec.find(':');
+    if (separator != std::string::npos) {
+        name = spec.substr(0, separator);
+        if (spec.substr(separator + 1) != "american") {
+            throw std::invalid_argument("Unknown exercise in model spec: " + spec);
+        }
+        if (name != "binomial" && name != "finite_difference") {
+            throw std::invalid_argument("American exercise needs binomial or finite_difference: " + spec);
+        }
+        compared.exercise = core::ExerciseStyle::American;
+        compared.label = name + "_american";
+    } else {
+        compared.label = name;
+    }
+
+    if (name == "heston") {
+        if (heston == nullptr) {
+            throw std::invalid_argument("heston needs Heston parameters");
+        }
+        compared.model = std::make_shared<models::HestonModel>(*heston);
+    } else {
+        // Tasks already run in parallel, so models do not spawn threads
+        compared.model = models::createModel(name, 1);
+    }
+    return compared;
+}
+
+std::vector<std::vector<core::PricingResult>> ModelComparison::price(const core::OptionBatch& batch) const {
+    std::size_t n = batch.size();
+    std::vector<std::vector<core::PricingResult>> results(models_.size(),
+                                                          std::vector<core::PricingResult>(n));
+
+    // Numerical models first so that they do not end up as the tail
+    std::vector<Task> tasks;
+    std::vector<const models::BlackScholesModel*> closedForms(models_.size(), nullptr);
+    for (std::size_t m = 0; m < models_.size(); ++m) {
+        closedForms[m] = dynamic_cast<const models::BlackScholesModel*>(models_[m].model.get());
+        if (closedForms[m] == nullptr) {
+            for (std::size_t begin = 0; begin < n; begin += kNumericalChunk) {
+                tasks.push_back(Task{m, begin, std::min(n, begin + kNumericalChunk)});
+            }
+        }
+    }
+    for (std::size_t m = 0; m < models_.size(); ++m) {
+        if (closedForms[m] != nullptr) {
+            for (std::size_t begin = 0; begin < n; begin += settings_.chunkSize) {
+                tasks.push_back(Task{m, begin, std::min(n, begin + settings_.chunkSize)});
+            }
+        }
+    }
+
+    util::parallelFor(tasks.size(), settings_.numThreads, [&](std::size_t t) {
+        const Task& task = tasks[t];
+        const ComparedModel& compared = models_[task.model];
+        core::PricingResult* out = results[task.model].data();
+        if (closedForms[task.model] != nullptr) {
+            closedForms[task.model]->priceBatch(batch, task.begin, task.end, settings_.withGreeks, out);
+            return;
+        }
+        for (std::size_t i = task.begin; i < task.end; ++i) {
+            try {
+                core::Option option(batch.types[i], batch.strikes[i], batch.maturities[i], compared.exercise);
+                core::MarketData marketData(batch.spots[i], batch.rates[i], batch.volatilities[i]);
+                out[i] = settings_.withGreeks ? compared.model->priceWithGreeks(option, marketData)
+                                              : compared.model->price(option, marketData);
+            } catch (const std::invalid_argument&) {
+                out[i] = core::PricingResult();
+                out[i].price = std::numeric_limits<double>::quiet_NaN();
+            }
+        }
+    });
+    return results;
+}
+
+} // namespace batch
+} // namespace pricing
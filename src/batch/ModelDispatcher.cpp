@@ -0,0 +1,106 @@
+#include <map>
+#include <stdexcept>
+#include <utility>
+
+#include "../../include/pricing/batch/ModelDispatcher.hpp"
+#include "../../include/pricing/models/ModelFactory.hpp"
+#include "../../include/pricing/util/Parallel.hpp"
+
+namespace pricing {
+namespace batch {
+
+unsigned parseOutputs(const std::string& text) {
+    unsigned outputs = OutputPrice;
+    std::size_t start = 0;
+    while (start <= text.size()) {
+        std::size_t end = text.find('|', start);
+        if (end == std::string::npos) {
+            end = text.size();
+        }
+        std::string name = text.substr(start, end - start);
+        if (name == "price") {
+            outputs |= OutputPrice;
+        } else if (name == "delta") {
+            outputs |= OutputDelta;
+        } else if (name == "gamma") {
+            outputs |= OutputGamma;
+        } else if (name == "vega") {
+            outputs |= OutputVega;
+        } else if (name == "theta") {
+            outputs |= OutputTheta;
+        } else if (name == "rho") {
+            outputs |= OutputRho;
+        } else if (name == "greeks" || name == "all") {
+            outputs |= OutputGreeks;
+        } else {
+            throw std::invalid_argument("Unknown output: " + name);
+        }
+        start = end + 1;
+    }
+    return outputs;
+}
+
+ModelDispatcher::ModelDispatcher(const BatchSettings& settings)
+    : settings_(settings) {
+}
+
+std::vector<core::PricingResult> ModelDispatcher::price(const core::OptionBatch& batch,
+                                                        const std::vector<RowRequest>& requests,
+                                                        std::vector<std::string>* errors) const {
+    if (requests.size() != batch.size()) {
+        throw std::invalid_argument("Every batch row needs a request");
+    }
+    if (errors != nullptr) {
+        errors->assign(batch.size(), std::string());
+    }
+
+    std::map<std::pair<std::string, bool>, std::vector<std::uint32_t>> groups;
+    for (std::size_t i = 0; i < requests.size(); ++i) {
+        if (!models::isModelName(requests[i].model)) {
+            throw std::invalid_argument("Unknown model: " + requests[i].model);
+        }
+        groups[{requests[i].model, requests[i].needsGreeks()}].push_back(static_cast<std::uint32_t>(i));
+    }
+
+    std::vector<core::PricingResult> results(batch.size());
+    for (const auto& group : groups) {
+        const std::string& name = group.first.first;
+        bool withGreeks = group.first.second;
+        const std::vector<std::uint32_t>& rows = group.second;
+        core::OptionBatch rowsBatch = batch.permuted(rows);
+
+        std::vector<core::PricingResult> groupResults;
+        if (name == "black_scholes") {
+            BatchSettings settings = settings_;
+            settings.withGreeks = withGreeks;
+            groupResults = BatchEngine(settings).price(rowsBatch);
+        } else {
+            // Numerical models are slow per row: rows are the parallel
+            // tasks and the model itself runs single-threaded
+            auto model = models::createModel(name, 1);
+            groupResults.resize(rows.size());
+            util::parallelFor(rows.size(), settings_.numThreads, [&](std::size_t k) {
+                try {
+                    core::Option option(rowsBatch.types[k], rowsBatch.strikes[k], rowsBatch.maturities[k]);
+                    core::MarketData marketData(rowsBatch.spots[k], rowsBatch.rates[k], rowsBatch.volatilities[k]);
+                    groupResults[k] = withGreeks ? model->priceWithGreeks(option, marketData)
+                                                 : model->price(option, marketData);
+                } catch (const std::exception& e) {
+                    // One rejected row must not fail the rest of the batch
+                    groupResults[k] = core::PricingResult();
+                    if (errors != nullptr) {
+                        (*errors)[rows[k]] = e.what();
+                    }
+                }
+            });
+        }
+
+        for (std::size_t k = 0; k < rows.size(); ++k) {
+            results[rows[k]] = groupResults[k];
+        }
+    }
+    return results;
+}
+
+} // namespace batch
+} // namespace pricing
@@ -0,0 +1,263 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../../include/pricing/batch/ResultCache.hpp"
+
+namespace pricing {
+namespace batch {
+
+namespace {
+    const char cacheMagic[8] = {'P', 'R', 'C', 'A', 'C', 'H', 'E', '1'};
+    const std::uint32_t cacheVersion = 1;
+
+    std::size_t nextPowerOfTwo(std::size_t value) {
+        std::size_t power = 1;
+        while (power < value) {
+            power <<= 1;
+        }
+        return power;
+    }
+}
+
+struct ResultCache::Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t entrySize;
+    std::uint64_t capacity;     // Power of two
+    std::uint64_t count;
+    std::uint64_t generation;
+    std::uint64_t reserved[3];
+};
+
+struct ResultCache::Entry {
+    std::uint64_t keyLow;
+    std::uint64_t keyHigh;
+    std::uint64_t generation;   // Last generation that stored or found the entry
+    std::uint64_t occupied;
+    double values[6];           // Price, delta, gamma, vega, theta, rho
+};
+
+ResultCache::ResultCache(const std::string& path, const ResultCacheSettings& settings)
+    : path_(path), settings_(settings) {
+    if (settings_.maxEntries == 0 || settings_.initialCapacity == 0) {
+        throw std::invalid_argument("Result cache limits must be positive");
+    }
+    settings_.initialCapacity = nextPowerOfTwo(settings_.initialCapacity);
+    open();
+    header()->generation += 1;
+}
+
+ResultCache::~ResultCache() {
+    unmap();
+}
+
+ResultCache::Header* ResultCache::header() const {
+    return static_cast<Header*>(mapping_);
+}
+
+ResultCache::Entry* ResultCache::entries() const {
+    return reinterpret_cast<Entry*>(static_cast<char*>(mapping_) + sizeof(Header));
+}
+
+std::size_t ResultCache::size() const {
+    return static_cast<std::size_t>(header()->count);
+}
+
+std::size_t ResultCache::capacity() const {
+    return static_cast<std::size_t>(header()->capacity);
+}
+
+std::uint64_t ResultCache::generation() const {
+    return header()->generation;
+}
+
+void ResultCache::open() {
+    int fd = ::open(path_.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open cache file: " + path_);
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot open cache file: " + path_);
+    }
+
+    std::size_t length;
+    if (info.st_size == 0) {
+        // New file: initialized in place
+        if (!writeEmpty(fd, settings_.initialCapacity, 0)) {
+            ::close(fd);
+            throw std::runtime_error("Cannot write cache file: " + path_);
+        }
+        length = sizeof(Header) + settings_.initialCapacity * sizeof(Entry);
+    } else {
+        Header stored;
+        bool valid = static_cast<std::size_t>(info.st_size) >= sizeof(Header)
+            && ::pread(fd, &stored, sizeof(stored), 0) == static_cast<ssize_t>(sizeof(stored))
+            && std::memcmp(stored.magic, cacheMagic, sizeof(cacheMagic)) == 0
+            && stored.version == cacheVersion
+            && stored.entrySize == sizeof(Entry)
+            && stored.capacity > 0 && (stored.capacity & (stored.capacity - 1)) == 0
+            && stored.count < stored.capacity
+            && static_cast<std::uint64_t>(info.st_size) == sizeof(Header) + stored.capacity * sizeof(Entry);
+        if (!valid) {
+            ::close(fd);
+            throw std::runtime_error("Cache file " + path_ + " is not an intact result cache");
+        }
+        length = static_cast<std::size_t>(info.st_size);
+    }
+
+    void* mapping = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Cannot map cache file: " + path_);
+    }
+    mapping_ = mapping;
+    length_ = length;
+}
+
+void ResultCache::unmap() {
+    if (mapping_ != nullptr) {
+        ::munmap(mapping_, length_);
+        mapping_ = nullptr;
+        length_ = 0;
+    }
+}
+
+bool ResultCache::writeEmpty(int fd, std::size_t capacity, std::uint64_t generation) {
+    Header fresh{};
+    std::memcpy(fresh.magic, cacheMagic, sizeof(cacheMagic));
+    fresh.version = cacheVersion;
+    fresh.entrySize = sizeof(Entry);
+    fresh.capacity = capacity;
+    fresh.generation = generation;
+
+    // Empty slots are all-zero, so extending the file is enough to clear them
+    off_t length = static_cast<off_t>(sizeof(Header) + capacity * sizeof(Entry));
+    return ::ftruncate(fd, length) == 0
+        && ::pwrite(fd, &fresh, sizeof(fresh), 0) == static_cast<ssize_t>(sizeof(fresh));
+}
+
+ResultCache::Entry* ResultCache::probe(Entry* table, std::size_t capacity, const util::ContentKey& key) {
+    std::size_t mask = capacity - 1;
+    for (std::size_t index = key.low & mask;; index = (index + 1) & mask) {
+        Entry& entry = table[index];
+        if (!entry.occupied || (entry.keyLow == key.low && entry.keyHigh == key.high)) {
+            return &entry;
+        }
+    }
+}
+
+ResultCache::Entry* ResultCache::slot(const util::ContentKey& key) const {
+    return probe(entries(), capacity(), key);
+}
+
+bool ResultCache::find(const util::ContentKey& key, core::PricingResult& result) {
+    Entry* entry = slot(key);
+    if (!entry->occupied) {
+        ++misses_;
+        return false;
+    }
+    entry->generation = generation();
+    result.price = entry->values[0];
+    result.delta = entry->values[1];
+    result.gamma = entry->values[2];
+    result.vega = entry->values[3];
+    result.theta = entry->values[4];
+    result.rho = entry->values[5];
+    ++hits_;
+    return true;
+}
+
+void ResultCache::store(const util::ContentKey& key, const core::PricingResult& result) {
+    Entry* entry = slot(key);
+    if (!entry->occupied) {
+        std::size_t count = size();
+        if (count >= settings_.maxEntries) {
+            // Keep three quarters of the limit so eviction does not run on every store
+            rebuild(settings_.maxEntries - settings_.maxEntries / 4, 0);
+            entry = slot(key);
+        } else if (10 * (count + 1) > 7 * capacity()) {
+            rebuild(count, 0);
+            entry = slot(key);
+        }
+        entry->keyLow = key.low;
+        entry->keyHigh = key.high;
+        entry->occupied = 1;
+        header()->count += 1;
+    }
+    entry->generation = generation();
+    entry->values[0] = result.price;
+    entry->values[1] = result.delta;
+    entry->values[2] = result.gamma;
+    entry->values[3] = result.vega;
+    entry->values[4] = result.theta;
+    entry->values[5] = result.rho;
+}
+
+void ResultCache::compact(std::uint64_t maxAge) {
+    std::uint64_t current = generation();
+    std::uint64_t oldest = (maxAge == 0 || maxAge >= current) ? 0 : current - maxAge + 1;
+    rebuild(settings_.maxEntries, oldest);
+}
+
+void ResultCache::rebuild(std::size_t keep, std::uint64_t oldestGeneration) {
+    std::vector<Entry> live;
+    live.reserve(size());
+    Entry* table = entries();
+    for (std::size_t i = 0; i < capacity(); ++i) {
+        if (table[i].occupied && table[i].generation >= oldestGeneration) {
+            live.push_back(table[i]);
+        }
+    }
+    if (live.size() > keep) {
+        std::stable_sort(live.begin(), live.end(), [](const Entry& a, const Entry& b) {
+            return a.generation > b.generation;
+        });
+        live.resize(keep);
+    }
+
+    // Write the new table next to the old file and swap it in atomically.
+    // The current mapping stays in place until the new file has replaced it.
+    std::uint64_t current = generation();
+    std::size_t newCapacity = std::max(settings_.initialCapacity, nextPowerOfTwo(2 * live.size() + 2));
+    std::size_t newLength = sizeof(Header) + newCapacity * sizeof(Entry);
+    std::string temporary = path_ + ".tmp";
+    int fd = ::open(temporary.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot create cache file: " + temporary);
+    }
+    void* mapping = writeEmpty(fd, newCapacity, current)
+        ? ::mmap(nullptr, newLength, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        std::remove(temporary.c_str());
+        throw std::runtime_error("Cannot write cache file: " + temporary);
+    }
+
+    Entry* newEntries = reinterpret_cast<Entry*>(static_cast<char*>(mapping) + sizeof(Header));
+    for (const Entry& entry : live) {
+        *probe(newEntries, newCapacity, {entry.keyLow, entry.keyHigh}) = entry;
+    }
+    static_cast<Header*>(mapping)->count = live.size();
+
+    if (std::rename(temporary.c_str(), path_.c_str()) != 0) {
+        ::munmap(mapping, newLength);
+        std::remove(temporary.c_str());
+        throw std::runtime_error("Cannot replace cache file: " + path_);
+    }
+    unmap();
+    mapping_ = mapping;
+    length_ = newLength;
+}
+
+} // namespace batch
+} // namespace pricing
@@ -0,0 +1,111 @@
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include "../../include/pricing/batch/RowHashIndex.hpp"
+
+namespace pricing {
+namespace batch {
+
+namespace {
+    const char indexMagic[8] = {'P', 'R', 'R', 'O', 'W', 'H', 'S', '2'};
+
+    struct IndexHeader {
+        char magic[8];
+        std::uint64_t rowCount;
+        std::uint64_t configurationLow;
+        std::uint64_t configurationHigh;
+        std::uint64_t outputSize;
+        std::uint64_t outputHash;
+    };
+
+    struct IndexRecord {
+        std::uint64_t keyLow;
+        std::uint64_t keyHigh;
+        std::uint64_t offset;
+        std::uint64_t length;
+    };
+}
+
+void RowHashIndex::add(const util::ContentKey& key, std::uint64_t offset, std::uint64_t length) {
+    RowLocation location;
+    location.key = key;
+    location.offset = offset;
+    location.length = length;
+    lookup_.emplace(key, rows_.size());
+    rows_.push_back(location);
+}
+
+const RowLocation* RowHashIndex::find(const util::ContentKey& key) const {
+    auto found = lookup_.find(key);
+    return found == lookup_.end() ? nullptr : &rows_[found->second];
+}
+
+bool RowHashIndex::describes(const char* data, std::size_t size) const {
+    return size == outputSize_ && util::fnv1a(data, size) == outputHash_;
+}
+
+void RowHashIndex::save(const std::string& path) const {
+    std::string temporary = path + ".tmp";
+    std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Cannot open file: " + path);
+    }
+    IndexHeader header{};
+    std::memcpy(header.magic, indexMagic, sizeof(indexMagic));
+    header.rowCount = rows_.size();
+    header.configurationLow = configuration_.low;
+    header.configurationHigh = configuration_.high;
+    header.outputSize = outputSize_;
+    header.outputHash = outputHash_;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    std::vector<IndexRecord> records(rows_.size());
+    for (std::size_t i = 0; i < rows_.size(); ++i) {
+        records[i] = {rows_[i].key.low, rows_[i].key.high, rows_[i].offset, rows_[i].length};
+    }
+    out.write(reinterpret_cast<const char*>(records.data()),
+              static_cast<std::streamsize>(records.size() * sizeof(IndexRecord)));
+    out.close();
+    if (!out || std::rename(temporary.c_str(), path.c_str()) != 0) {
+        throw std::runtime_error("Cannot write file: " + path);
+    }
+}
+
+RowHashIndex RowHashIndex::load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Cannot open file: " + path);
+    }
+    IndexHeader header;
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))
+        || std::memcmp(header.magic, indexMagic, sizeof(indexMagic)) != 0) {
+        throw std::runtime_error("Invalid row hash file: " + path);
+    }
+
+    in.seekg(0, std::ios::end);
+    auto length = static_cast<std::uint64_t>(in.tellg());
+    if ((length - sizeof(IndexHeader)) / sizeof(IndexRecord) != header.rowCount
+        || (length - sizeof(IndexHeader)) % sizeof(IndexRecord) != 0) {
+        throw std::runtime_error("Invalid row hash file: " + path);
+    }
+    in.seekg(sizeof(IndexHeader));
+
+    std::vector<IndexRecord> records(static_cast<std::size_t>(header.rowCount));
+    if (!in.read(reinterpret_cast<char*>(records.data()),
+                 static_cast<std::streamsize>(records.size() * sizeof(IndexRecord)))) {
+        throw std::runtime_error("Invalid row hash file: " + path);
+    }
+
+    RowHashIndex index({header.configurationLow, header.configurationHigh});
+    index.setOutput(header.outputSize, header.outputHash);
+    index.rows_.reserve(records.size());
+    for (const auto& record : records) {
+        index.add({record.keyLow, record.keyHigh}, record.offset, record.length);
+    }
+    return index;
+}
+
+} // namespace batch
+} // namespace pricing
@@ -0,0 +1,245 @@
+#include <cmath>
+#include <stdexcept>
+
+#include "../../include/pricing/batch/SpotLadderCache.hpp"
+#include "../../include/pricing/core/OptionBatch.hpp"
+#include "../../include/pricing/models/BlackScholesModel.hpp"
+
+namespace pricing {
+namespace batch {
+
+namespace {
+    bool sameParameters(const core::Option& option, const core::MarketData& marketData,
+                        const core::Option& otherOption, const core::MarketData& otherMarketData) {
+        return option.getType() == otherOption.getType()
+            && option.getStrike() == otherOption.getStrike()
+            && option.getTimeToExpiration() == otherOption.getTimeToExpiration()
+            && marketData.getRiskFreeRate() == otherMarketData.getRiskFreeRate()
+            && marketData.getVolatility() == otherMarketData.getVolatility();
+    }
+
+    void requireEuropean(const core::Option& option) {
+        if (option.isAmerican()) {
+            throw std::invalid_argument("Spot ladder cache prices European options only");
+        }
+    }
+}
+
+void SpotLadderSettings::validate() const {
+    if (!(bandWidth > 0.0 && bandWidth < 1.0)) {
+        throw std::invalid_argument("Ladder band width must be between 0 and 1");
+    }
+    if (nodes < 4) {
+        throw std::invalid_argument("Ladder needs at least 4 nodes");
+    }
+    if (!(recenterAt > 0.0 && recenterAt <= 1.0)) {
+        throw std::invalid_argument("Ladder recentring threshold must be in (0, 1]");
+    }
+}
+
+LadderRebuilder::LadderRebuilder()
+    : thread_([this]() { run(); }) {
+}
+
+LadderRebuilder::~LadderRebuilder() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    changed_.notify_all();
+    thread_.join();
+}
+
+void LadderRebuilder::waitIdle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    changed_.wait(lock, [this]() { return queue_.empty() && building_.empty(); });
+}
+
+// A newer request of the same cache replaces a queued one
+void LadderRebuilder::request(const Request& request) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        bool replaced = false;
+        for (auto& queued : queue_) {
+            if (queued.cache == request.cache) {
+                queued = request;
+                replaced = true;
+                break;
+            }
+        }
+        if (!replaced) {
+            queue_.push_back(request);
+        }
+    }
+    changed_.notify_all();
+}
+
+void LadderRebuilder::cancel(SpotLadderCache* cache) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (auto it = queue_.begin(); it != queue_.end();) {
+        it = it->cache == cache ? queue_.erase(it) : it + 1;
+    }
+    changed_.wait(lock, [&]() { return building_.count(cache) == 0; });
+    changed_.notify_all();      // The queue may have become empty
+}
+
+void LadderRebuilder::run() {
+    for (;;) {
+        std::vector<Request> batch;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            changed_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+            if (stopping_) {
+                return;
+            }
+            batch.assign(queue_.begin(), queue_.end());
+            queue_.clear();
+            for (const auto& request : batch) {
+                building_.insert(request.cache);
+            }
+        }
+
+        std::vector<std::shared_ptr<const SpotLadder>> ladders;
+        try {
+            ladders = SpotLadderCache::buildLadders(batch);
+        } catch (const std::exception&) {
+            ladders.assign(batch.size(), nullptr);
+        }
+        for (std::size_t k = 0; k < batch.size(); ++k) {
+            batch[k].cache->install(ladders[k], batch[k].generation);
+        }
+        laddersBuilt_ += batch.size();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            building_.clear();
+        }
+        changed_.notify_all();
+    }
+}
+
+SpotLadderCache::SpotLadderCache(const core::Option& option, const core::MarketData& marketData,
+                                 const SpotLadderSettings& settings,
+                                 std::shared_ptr<LadderRebuilder> rebuilder)
+    : settings_(settings), rebuilder_(std::move(rebuilder)), option_(option), marketData_(marketData) {
+    settings_.validate();
+    requireEuropean(option);
+    LadderRebuilder::Request request{this, option_, marketData_, generation_};
+    install(buildLadders({request})[0], request.generation);
+}
+
+SpotLadderCache::~SpotLadderCache() {
+    if (rebuilder_) {
+        rebuilder_->cancel(this);
+    }
+}
+
+core::PricingResult SpotLadderCache::quote(double spot) {
+    core::PricingResult result;
+    auto ladder = std::atomic_load(&ladder_);
+    if (ladder && ladder->generation == generation_.load(std::memory_order_relaxed) && ladder->price.contains(spot)) {
+        if (std::abs(spot - ladder->center) > settings_.recenterAt * settings_.bandWidth * ladder->center) {
+            requestLadder(spot);
+        }
+        ladderQuotes_.fetch_add(1, std::memory_order_relaxed);
+        result.price = ladder->price(spot);
+        result.delta = ladder->delta(spot);
+        return result;
+    }
+
+    requestLadder(spot);
+    exactQuotes_.fetch_add(1, std::memory_order_relaxed);
+    core::MarketData marketData(spot, marketData_.getRiskFreeRate(), marketData_.getVolatility());
+    core::PricingResult exact = models::BlackScholesModel().priceWithGreeks(option_, marketData);
+    result.price = exact.price;
+    result.delta = exact.delta;
+    return result;
+}
+
+void SpotLadderCache::update(const core::Option& option, const core::MarketData& marketData) {
+    requireEuropean(option);
+    bool same = sameParameters(option, marketData, option_, marketData_);
+    option_ = option;
+    marketData_ = marketData;
+    if (!same) {
+        ++generation_;
+        rebuildPending_ = false;
+        requestLadder(marketData.getSpot());
+    }
+}
+
+double SpotLadderCache::ladderCenter() const {
+    auto ladder = std::atomic_load(&ladder_);
+    return ladder ? ladder->center : 0.0;
+}
+
+// At most one rebuild per generation is outstanding
+void SpotLadderCache::requestLadder(double spot) {
+    if (rebuildPending_.exchange(true)) {
+        return;
+    }
+    core::MarketData center(spot, marketData_.getRiskFreeRate(), marketData_.getVolatility());
+    LadderRebuilder::Request request{this, option_, center, generation_};
+    if (rebuilder_) {
+        rebuilder_->request(request);
+    } else {
+        install(buildLadders({request})[0], request.generation);
+    }
+}
+
+// Ladders of retired parameters are dropped
+void SpotLadderCache::install(std::shared_ptr<const SpotLadder> ladder, std::uint64_t generation) {
+    if (generation != generation_) {
+        return;
+    }
+    if (ladder) {
+        std::atomic_store(&ladder_, std::move(ladder));
+    }
+    rebuildPending_ = false;
+}
+
+std::vector<std::shared_ptr<const SpotLadder>> SpotLadderCache::buildLadders(
+    const std::vector<LadderRebuilder::Request>& requests) {
+    core::OptionBatch batch;
+    for (const auto& request : requests) {
+        const SpotLadderSettings& settings = request.cache->settings_;
+        double center = request.marketData.getSpot();
+        double lower = center * (1.0 - settings.bandWidth);
+        double upper = center * (1.0 + settings.bandWidth);
+        for (std::size_t i = 0; i < settings.nodes; ++i) {
+            double spot = lower + (upper - lower) * static_cast<double>(i) / static_cast<double>(settings.nodes - 1);
+            batch.add(request.option, core::MarketData(spot, request.marketData.getRiskFreeRate(),
+                                                       request.marketData.getVolatility()));
+        }
+    }
+    std::vector<core::PricingResult> results(batch.size());
+    models::BlackScholesModel().priceBatch(batch, 0, batch.size(), true, results.data());
+
+    std::vector<std::shared_ptr<const SpotLadder>> ladders;
+    ladders.reserve(requests.size());
+    std::size_t first = 0;
+    for (const auto& request : requests) {
+        const SpotLadderSettings& settings = request.cache->settings_;
+        double center = request.marketData.getSpot();
+        std::vector<double> prices(settings.nodes);
+        std::vector<double> deltas(settings.nodes);
+        for (std::size_t i = 0; i < settings.nodes; ++i) {
+            prices[i] = results[first + i].price;
+            deltas[i] = results[first + i].delta;
+        }
+        first += settings.nodes;
+
+        auto ladder = std::make_shared<SpotLadder>();
+        ladder->generation = request.generation;
+        ladder->center = center;
+        ladder->price = numerics::MonotoneSpline(center * (1.0 - settings.bandWidth),
+                                                 center * (1.0 + settings.bandWidth), prices);
+        ladder->delta = numerics::MonotoneSpline(center * (1.0 - settings.bandWidth),
+                                                 center * (1.0 + settings.bandWidth), deltas);
+        ladders.push_back(std::move(ladder));
+    }
+    return ladders;
+}
+
+} // namespace batch
+} // namespace pricing
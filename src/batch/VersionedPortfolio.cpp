@@ -0,0 +1,222 @@
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../../include/pricing/batch/VersionedPortfolio.hpp"
+
+namespace pricing {
+namespace batch {
+
+// Nodes are mutable only while their edit tag is the portfolio's current
+// one; commit() moves the portfolio to a new tag, freezing every node the
+// published version can reach.
+struct PortfolioChunk {
+    std::uint64_t edit = 0;
+    std::array<core::OptionType, VersionedPortfolio::kChunkRows> types;
+    std::array<double, VersionedPortfolio::kChunkRows> spots;
+    std::array<double, VersionedPortfolio::kChunkRows> strikes;
+    std::array<double, VersionedPortfolio::kChunkRows> rates;
+    std::array<double, VersionedPortfolio::kChunkRows> volatilities;
+    std::array<double, VersionedPortfolio::kChunkRows> maturities;
+};
+
+struct PortfolioSegment {
+    std::uint64_t edit = 0;
+    std::vector<std::shared_ptr<PortfolioChunk>> chunks;
+};
+
+struct PortfolioRoot {
+    std::uint64_t edit = 0;
+    std::uint64_t version = 0;
+    std::size_t rows = 0;
+    std::vector<std::shared_ptr<PortfolioSegment>> segments;
+
+    const PortfolioChunk& chunk(std::size_t row) const {
+        std::size_t index = row / VersionedPortfolio::kChunkRows;
+        return *segments[index / VersionedPortfolio::kSegmentChunks]->chunks[index % VersionedPortfolio::kSegmentChunks];
+    }
+};
+
+struct VersionedPortfolio::Location {
+    PortfolioChunk* chunk;
+    std::size_t offset;
+};
+
+namespace {
+    void checkRow(std::size_t row, std::size_t rows) {
+        if (row >= rows) {
+            throw std::out_of_range("Portfolio row " + std::to_string(row) + " out of range");
+        }
+    }
+
+    void store(PortfolioChunk& chunk, std::size_t offset, const core::Option& option) {
+        chunk.types[offset] = option.getType();
+        chunk.strikes[offset] = option.getStrike();
+        chunk.maturities[offset] = option.getTimeToExpiration();
+    }
+
+    void store(PortfolioChunk& chunk, std::size_t offset, const core::MarketData& marketData) {
+        chunk.spots[offset] = marketData.getSpot();
+        chunk.rates[offset] = marketData.getRiskFreeRate();
+        chunk.volatilities[offset] = marketData.getVolatility();
+    }
+}
+
+std::uint64_t PortfolioSnapshot::version() const {
+    return root_ ? root_->version : 0;
+}
+
+std::size_t PortfolioSnapshot::size() const {
+    return root_ ? root_->rows : 0;
+}
+
+core::Option PortfolioSnapshot::option(std::size_t row) const {
+    checkRow(row, size());
+    const PortfolioChunk& chunk = root_->chunk(row);
+    std::size_t offset = row % VersionedPortfolio::kChunkRows;
+    return core::Option(chunk.types[offset], chunk.strikes[offset], chunk.maturities[offset]);
+}
+
+core::MarketData PortfolioSnapshot::marketData(std::size_t row) const {
+    checkRow(row, size());
+    const PortfolioChunk& chunk = root_->chunk(row);
+    std::size_t offset = row % VersionedPortfolio::kChunkRows;
+    return core::MarketData(chunk.spots[offset], chunk.rates[offset], chunk.volatilities[offset]);
+}
+
+core::OptionBatch PortfolioSnapshot::batch(std::size_t begin, std::size_t end) const {
+    if (begin > end || end > size()) {
+        throw std::out_of_range("Portfolio rows out of range");
+    }
+    core::OptionBatch result;
+    result.reserve(end - begin);
+    for (std::size_t row = begin; row < end;) {
+        const PortfolioChunk& chunk = root_->chunk(row);
+        std::size_t offset = row % VersionedPortfolio::kChunkRows;
+        std::size_t count = std::min(end - row, VersionedPortfolio::kChunkRows - offset);
+        result.types.insert(result.types.end(), &chunk.types[offset], &chunk.types[offset] + count);
+        result.spots.insert(result.spots.end(), &chunk.spots[offset], &chunk.spots[offset] + count);
+        result.strikes.insert(result.strikes.end(), &chunk.strikes[offset], &chunk.strikes[offset] + count);
+        result.rates.insert(result.rates.end(), &chunk.rates[offset], &chunk.rates[offset] + count);
+        result.volatilities.insert(result.volatilities.end(), &chunk.volatilities[offset],
+                                   &chunk.volatilities[offset] + count);
+        result.maturities.insert(result.maturities.end(), &chunk.maturities[offset],
+                                 &chunk.maturities[offset] + count);
+        row += count;
+    }
+    return result;
+}
+
+VersionedPortfolio::VersionedPortfolio()
+    : working_(std::make_shared<PortfolioRoot>()), published_(working_) {
+}
+
+VersionedPortfolio::~VersionedPortfolio() = default;
+
+PortfolioRoot& VersionedPortfolio::workingRoot() {
+    if (working_->edit != edit_) {
+        working_ = std::make_shared<PortfolioRoot>(*working_);
+        working_->edit = edit_;
+    }
+    return *working_;
+}
+
+// Copies the path to the row's chunk into the pending version where needed
+VersionedPortfolio::Location VersionedPortfolio::locate(std::size_t row) {
+    PortfolioRoot& root = workingRoot();
+    std::size_t index = row / kChunkRows;
+    auto& segment = root.segments[index / kSegmentChunks];
+    if (segment->edit != edit_) {
+        segment = std::make_shared<PortfolioSegment>(*segment);
+        segment->edit = edit_;
+    }
+    auto& chunk = segment->chunks[index % kSegmentChunks];
+    if (chunk->edit != edit_) {
+        chunk = std::make_shared<PortfolioChunk>(*chunk);
+        chunk->edit = edit_;
+        ++copiedChunks_;
+    }
+    return Location{chunk.get(), row % kChunkRows};
+}
+
+std::size_t VersionedPortfolio::append(const core::Option& option, const core::MarketData& marketData) {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    PortfolioRoot& root = workingRoot();
+    std::size_t row = root.rows;
+    if (row % kChunkRows == 0) {
+        std::size_t index = row / kChunkRows;
+        if (index % kSegmentChunks == 0) {
+            auto segment = std::make_shared<PortfolioSegment>();
+            segment->edit = edit_;
+            segment->chunks.reserve(kSegmentChunks);
+            root.segments.push_back(std::move(segment));
+        }
+        auto& segment = root.segments.back();
+        if (segment->edit != edit_) {
+            segment = std::make_shared<PortfolioSegment>(*segment);
+            segment->edit = edit_;
+        }
+        auto chunk = std::make_shared<PortfolioChunk>();
+        chunk->edit = edit_;
+        segment->chunks.push_back(std::move(chunk));
+    }
+
+    Location location = locate(row);
+    store(*location.chunk, location.offset, option);
+    store(*location.chunk, location.offset, marketData);
+    ++root.rows;
+    dirty_ = true;
+    return row;
+}
+
+void VersionedPortfolio::amend(std::size_t row, const core::Option& option, const core::MarketData& marketData) {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    checkRow(row, working_->rows);
+    Location location = locate(row);
+    store(*location.chunk, location.offset, option);
+    store(*location.chunk, location.offset, marketData);
+    dirty_ = true;
+}
+
+void VersionedPortfolio::amendMarketData(std::size_t row, const core::MarketData& marketData) {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    checkRow(row, working_->rows);
+    Location location = locate(row);
+    store(*location.chunk, location.offset, marketData);
+    dirty_ = true;
+}
+
+std::uint64_t VersionedPortfolio::commit() {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    if (!dirty_) {
+        return working_->version;
+    }
+    ++working_->version;
+    {
+        std::lock_guard<std::mutex> publishLock(publishMutex_);
+        published_ = working_;
+    }
+    ++edit_;
+    dirty_ = false;
+    return working_->version;
+}
+
+PortfolioSnapshot VersionedPortfolio::snapshot() const {
+    std::lock_guard<std::mutex> lock(publishMutex_);
+    return PortfolioSnapshot(published_);
+}
+
+std::size_t VersionedPortfolio::size() const {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    return working_->rows;
+}
+
+std::size_t VersionedPortfolio::copiedChunks() const {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    return copiedChunks_;
+}
+
+} // namespace batch
+} // namespace pricing
@@ -0,0 +1,57 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "../../include/pricing/batch/WorkPlanner.hpp"
+
+namespace pricing {
+namespace batch {
+
+std::vector<WorkItem> planWork(const std::vector<WorkFile>& files, double targetCost) {
+    if (!(targetCost > 0.0)) {
+        throw std::invalid_argument("Target cost of a work item must be positive");
+    }
+
+    std::vector<WorkItem> items;
+    WorkItem packed;
+    for (std::size_t file = 0; file < files.size(); ++file) {
+        std::size_t units = files[file].units;
+        double cost = static_cast<double>(units) * files[file].unitCost;
+        if (units == 0) {
+            continue;
+        }
+
+        if (cost > targetCost && units > 1) {
+            std::size_t parts = static_cast<std::size_t>(std::ceil(cost / targetCost));
+            parts = std::min(parts, units);
+            for (std::size_t part = 0; part < parts; ++part) {
+                WorkItem item;
+                WorkSpan span;
+                span.file = file;
+                span.begin = units * part / parts;
+                span.end = units * (part + 1) / parts;
+                item.cost = static_cast<double>(span.end - span.begin) * files[file].unitCost;
+                item.spans.push_back(span);
+                items.push_back(std::move(item));
+            }
+            continue;
+        }
+
+        if (!packed.spans.empty() && packed.cost + cost > targetCost) {
+            items.push_back(std::move(packed));
+            packed = WorkItem();
+        }
+        packed.spans.push_back(WorkSpan{file, 0, units});
+        packed.cost += cost;
+    }
+    if (!packed.spans.empty()) {
+        items.push_back(std::move(packed));
+    }
+
+    std::stable_sort(items.begin(), items.end(),
+                     [](const WorkItem& a, const WorkItem& b) { return a.cost > b.cost; });
+    return items;
+}
+
+} // namespace batch
+} // namespace pricing
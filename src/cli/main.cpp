@@ -1,20 +1,45 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <set>
 #include <stdexcept>
 #include <string>
+#include <utility>
 #include <sstream>
 #include <vector>
 
+#include "../../include/pricing/batch/AutoTuner.hpp"
+#include "../../include/pricing/batch/BatchEngine.hpp"
+#include "../../include/pricing/batch/DeltaPublisher.hpp"
+#include "../../include/pricing/batch/DistributedBatch.hpp"
+#include "../../include/pricing/batch/ExternalSorter.hpp"
+#include "../../include/pricing/batch/ModelComparison.hpp"
+#include "../../include/pricing/batch/ModelDispatcher.hpp"
+#include "../../include/pricing/batch/ResultCache.hpp"
+#include "../../include/pricing/batch/RowHashIndex.hpp"
+#include "../../include/pricing/batch/WorkPlanner.hpp"
 #include "../../include/pricing/core/MarketData.hpp"
+#include "../../include/pricing/core/OptionBatch.hpp"
 #include "../../include/pricing/core/Option.hpp"
-#include "../../include/pricing/models/BlackScholesModel.hpp"
+#include "../../include/pricing/models/ModelFactory.hpp"
+#include "../../include/pricing/util/AsyncFileIO.hpp"
+#include "../../include/pricing/util/MappedFile.hpp"
+#include "../../include/pricing/util/Parallel.hpp"
 
 namespace {
     void printUsage(const char* programName) {
         std::cerr << "Usage: " << programName << " [OPTIONS]\n"
                   << "\nSingle calculation mode:\n"
-                  << "  --model MODEL          Pricing model (black_scholes)\n"
+                  << "  --model MODEL          Pricing model (black_scholes|monte_carlo|binomial|finite_difference)\n"
                   << "  --type TYPE            Option type (call|put)\n"
                   << "  --spot S               Spot price of underlying asset\n"
                   << "  --strike K             Strike price\n"
@@ -24,8 +49,37 @@ namespace {
                   << "  --with-greeks          Calculate and display Greeks\n"
                   << "\nBatch processing mode:\n"
                   << "  --batch-input FILE     Input CSV file\n"
-                  << "  --batch-output FILE    Output CSV file\n"
-                  << "  --with-greeks          Include Greeks in output\n"
+                  << "  --batch-output FILE    Output CSV file (output directory with --batch-dir or --manifest)\n"
+                  << "  --batch-dir DIR        Price every *.csv file under DIR into the same paths under the\n"
+                  << "                         output directory, all files sharing one pool of threads\n"
+                  << "  --manifest FILE        Like --batch-dir for the input files listed in FILE, one per line\n"
+                  << "  --io-depth N           Files read or written at once with --batch-dir or --manifest (64)\n"
+                  << "  --model MODEL          Model of rows without a 'model' column value\n"
+                  << "  --with-greeks          Include Greeks in output (rows without an 'outputs' value)\n"
+                  << "  --reorder              Price rows grouped by underlying, maturity and strike\n"
+                  << "  --sort-memory MB       Reorder out of core, holding at most MB of rows in memory\n"
+                  << "  --threads N            Pricing threads (0 = all cores)\n"
+                  << "  --compare MODELS       Price every row with each model, prices side by side\n"
+                  << "                         (comma-separated, e.g. black_scholes,binomial:american,heston)\n"
+                  << "  --heston PARAMS        Heston V0,KAPPA,THETA,XI,RHO for 'heston' in --compare\n"
+                  << "  --since FILE           Reprice only rows changed since a previous output\n"
+                  << "  --publish-state FILE   Write only results that changed since their last publication\n"
+                  << "  --publish-threshold X  Change of price or a Greek that triggers publication (1e-4)\n"
+                  << "  --cache FILE           Reuse results across runs from a persistent cache file\n"
+                  << "  --cache-tag TAG        Market data version mixed into cache keys\n"
+                  << "  --cache-max-entries N  Evict least recently used results beyond N entries\n"
+                  << "  --cache-max-age N      Compact the cache, dropping results unused for N runs\n"
+                  << "  --huge-pages           Back large batch buffers and mapped files with huge pages\n"
+                  << "  --prefault             Fault in large batch buffers and mapped files up front\n"
+                  << "  --workers LIST         Price --batch-input on worker processes (host:port,host:port,...)\n"
+                  << "  --shard-rows N         Rows sent to a worker at a time (65536, at most 262144)\n"
+                  << "  --worker-timeout S     Give up on a worker silent for S seconds (30, 0 = never)\n"
+                  << "\nWorker mode:\n"
+                  << "  --worker [HOST:]PORT   Serve shards for --workers coordinators (loopback without HOST;\n"
+                  << "                         the protocol is unauthenticated, expose it on trusted networks only)\n"
+                  << "\nTuning:\n"
+                  << "  --autotune FILE        Calibrate the batch engine on this host and save the profile\n"
+                  << "  --tuning-profile FILE  Load chunk size, threads, kernel and reordering from a profile\n"
                   << "\nOther:\n"
                   << "  --help                 Show this help message\n"
                   << "\nExample (single):\n"
@@ -45,6 +99,29 @@ namespace {
         }
     }
 
+    std::size_t parseCount(const std::string& arg, const std::string& paramName) {
+        try {
+            std::size_t consumed = 0;
+            unsigned long long value = std::stoull(arg, &consumed);
+            if (consumed != arg.size() || arg[0] == '-') {
+                throw std::invalid_argument(arg);
+            }
+            return static_cast<std::size_t>(value);
+        } catch (const std::exception&) {
+            throw std::invalid_argument("Invalid value for " + paramName + ": " + arg);
+        }
+    }
+
+    std::vector<std::string> splitList(const std::string& text) {
+        std::vector<std::string> items;
+        std::stringstream ss(text);
+        std::string item;
+        while (std::getline(ss, item, ',')) {
+            items.push_back(item);
+        }
+        return items;
+    }
+
     pricing::core::OptionType parseOptionType(const std::string& typeStr) {
         if (typeStr == "call") {
             return pricing::core::OptionType::Call;
@@ -66,6 +143,29 @@ namespace {
         bool withGreeks = false;
         std::string batchInputFile;
         std::string batchOutputFile;
+        std::string batchDir;
+        std::string manifestFile;
+        std::size_t ioDepth = 64;
+        bool reorder = false;
+        std::vector<std::string> compareModels;
+        std::vector<double> hestonParameters;
+        std::string autotuneFile;
+        std::string tuningProfileFile;
+        bool hugePages = false;
+        bool prefault = false;
+        std::size_t sortMemory = 0;         // MB; 0 = reorder in memory
+        unsigned threads = 0;               // 0 = hardware concurrency
+        std::string sinceFile;
+        std::string publishStateFile;
+        double publishThreshold = 1e-4;
+        std::string cacheFile;
+        std::string cacheTag;
+        std::size_t cacheMaxEntries = 0;    // 0 = ResultCacheSettings default
+        std::size_t cacheMaxAge = 0;        // 0 = no compaction after the run
+        std::string workerListen;
+        std::vector<std::string> workers;
+        std::size_t shardRows = 65536;
+        double workerTimeout = 30.0;        // Seconds of silence; 0 = wait indefinitely
         bool help = false;
     };
 
@@ -98,6 +198,55 @@ namespace {
                 args.batchInputFile = argv[++i];
             } else if (arg == "--batch-output" && i + 1 < argc) {
                 args.batchOutputFile = argv[++i];
+            } else if (arg == "--batch-dir" && i + 1 < argc) {
+                args.batchDir = argv[++i];
+            } else if (arg == "--manifest" && i + 1 < argc) {
+                args.manifestFile = argv[++i];
+            } else if (arg == "--io-depth" && i + 1 < argc) {
+                args.ioDepth = parseCount(argv[++i], "--io-depth");
+            } else if (arg == "--reorder") {
+                args.reorder = true;
+            } else if (arg == "--compare" && i + 1 < argc) {
+                args.compareModels = splitList(argv[++i]);
+            } else if (arg == "--heston" && i + 1 < argc) {
+                for (const auto& value : splitList(argv[++i])) {
+                    args.hestonParameters.push_back(parseDouble(value, "--heston"));
+                }
+            } else if (arg == "--autotune" && i + 1 < argc) {
+                args.autotuneFile = argv[++i];
+            } else if (arg == "--tuning-profile" && i + 1 < argc) {
+                args.tuningProfileFile = argv[++i];
+            } else if (arg == "--huge-pages") {
+                args.hugePages = true;
+            } else if (arg == "--prefault") {
+                args.prefault = true;
+            } else if (arg == "--sort-memory" && i + 1 < argc) {
+                args.sortMemory = parseCount(argv[++i], "--sort-memory");
+                args.reorder = true;
+            } else if (arg == "--threads" && i + 1 < argc) {
+                args.threads = static_cast<unsigned>(parseCount(argv[++i], "--threads"));
+            } else if (arg == "--since" && i + 1 < argc) {
+                args.sinceFile = argv[++i];
+            } else if (arg == "--publish-state" && i + 1 < argc) {
+                args.publishStateFile = argv[++i];
+            } else if (arg == "--publish-threshold" && i + 1 < argc) {
+                args.publishThreshold = parseDouble(argv[++i], "--publish-threshold");
+            } else if (arg == "--cache" && i + 1 < argc) {
+                args.cacheFile = argv[++i];
+            } else if (arg == "--cache-tag" && i + 1 < argc) {
+                args.cacheTag = argv[++i];
+            } else if (arg == "--cache-max-entries" && i + 1 < argc) {
+                args.cacheMaxEntries = parseCount(argv[++i], "--cache-max-entries");
+            } else if (arg == "--cache-max-age" && i + 1 < argc) {
+                args.cacheMaxAge = parseCount(argv[++i], "--cache-max-age");
+            } else if (arg == "--worker" && i + 1 < argc) {
+                args.workerListen = argv[++i];
+            } else if (arg == "--workers" && i + 1 < argc) {
+                args.workers = splitList(argv[++i]);
+            } else if (arg == "--shard-rows" && i + 1 < argc) {
+                args.shardRows = parseCount(argv[++i], "--shard-rows");
+            } else if (arg == "--worker-timeout" && i + 1 < argc) {
+                args.workerTimeout = parseDouble(argv[++i], "--worker-timeout");
             } else {
                 throw std::invalid_argument("Unknown argument: " + arg);
             }
@@ -107,8 +256,67 @@ namespace {
     }
 
     void validateArguments(const CliArguments& args) {
-        if (args.model != "black_scholes") {
-            throw std::invalid_argument("Unsupported model: " + args.model + " (only 'black_scholes' is supported)");
+        if (!pricing::models::isModelName(args.model)) {
+            std::string names;
+            for (const auto& name : pricing::models::modelNames()) {
+                names += (names.empty() ? "" : ", ") + name;
+            }
+            throw std::invalid_argument("Unsupported model: " + args.model + " (supported: " + names + ")");
+        }
+
+        // Worker mode takes only the settings of its own pricing
+        if (!args.workerListen.empty()) {
+            if (!args.batchInputFile.empty() || !args.batchOutputFile.empty() || !args.batchDir.empty()
+                || !args.manifestFile.empty() || !args.workers.empty() || !args.autotuneFile.empty()) {
+                throw std::invalid_argument("--worker cannot be combined with batch, coordinator or calibration options");
+            }
+            pricing::batch::parseWorkerAddress(args.workerListen);
+            return;
+        }
+        if (!args.workers.empty()) {
+            if (args.batchInputFile.empty()) {
+                throw std::invalid_argument("--workers requires --batch-input");
+            }
+            if (!args.compareModels.empty() || args.sortMemory > 0) {
+                throw std::invalid_argument("--workers cannot be combined with --compare or --sort-memory");
+            }
+            if (args.shardRows == 0 || args.shardRows > pricing::batch::DistributedSettings::kMaxShardRows) {
+                throw std::invalid_argument("--shard-rows must be between 1 and "
+                                            + std::to_string(pricing::batch::DistributedSettings::kMaxShardRows));
+            }
+            if (args.workerTimeout < 0.0) {
+                throw std::invalid_argument("--worker-timeout must be non-negative");
+            }
+            for (const auto& worker : args.workers) {
+                pricing::batch::parseWorkerAddress(worker);
+            }
+        }
+
+        // Calibration only
+        if (!args.autotuneFile.empty() && args.batchInputFile.empty() && args.batchOutputFile.empty()
+            && args.batchDir.empty() && args.manifestFile.empty()) {
+            return;
+        }
+
+        // Directory and manifest mode validation
+        if (!args.batchDir.empty() || !args.manifestFile.empty()) {
+            if (!args.batchDir.empty() && !args.manifestFile.empty()) {
+                throw std::invalid_argument("--batch-dir cannot be combined with --manifest");
+            }
+            if (!args.batchInputFile.empty()) {
+                throw std::invalid_argument("--batch-dir and --manifest cannot be combined with --batch-input");
+            }
+            if (args.batchOutputFile.empty()) {
+                throw std::invalid_argument("--batch-output is required when using --batch-dir or --manifest");
+            }
+            if (!args.compareModels.empty() || !args.cacheFile.empty() || !args.sinceFile.empty()
+                || !args.publishStateFile.empty() || args.sortMemory > 0) {
+                throw std::invalid_argument("--batch-dir and --manifest cannot be combined with --compare, --cache, --since, --publish-state or --sort-memory");
+            }
+            if (args.ioDepth == 0) {
+                throw std::invalid_argument("--io-depth must be positive");
+            }
+            return;
         }
 
         // Batch mode validation
@@ -119,8 +327,25 @@ namespace {
             if (args.batchOutputFile.empty()) {
                 throw std::invalid_argument("--batch-output is required when using batch mode");
             }
+            if (!args.publishStateFile.empty() && !args.sinceFile.empty()) {
+                throw std::invalid_argument("--since cannot be combined with --publish-state");
+            }
+            if (args.publishThreshold < 0.0) {
+                throw std::invalid_argument("--publish-threshold must be non-negative");
+            }
+            if (!args.compareModels.empty() && (!args.cacheFile.empty() || !args.sinceFile.empty()
+                                                || !args.publishStateFile.empty() || args.sortMemory > 0)) {
+                throw std::invalid_argument("--compare cannot be combined with --cache, --since, --publish-state or --sort-memory");
+            }
+            if (!args.hestonParameters.empty() && args.hestonParameters.size() != 5) {
+                throw std::invalid_argument("--heston expects V0,KAPPA,THETA,XI,RHO");
+            }
             return; // Skip single mode validation in batch mode
         }
+        if (!args.cacheFile.empty() || !args.sinceFile.empty() || !args.publishStateFile.empty()
+            || !args.compareModels.empty()) {
+            throw std::invalid_argument("--cache, --since, --publish-state and --compare are only supported in batch mode");
+        }
 
         // Single mode validation
         if (args.spot <= 0.0) {
@@ -183,27 +408,61 @@ namespace {
         double rate;
         double vol;
         double maturity;
+        std::string model;      // Optional columns; empty = batch-wide setting
+        std::string outputs;
     };
 
-    std::vector<OptionRow> readCSV(const std::string& filename) {
-        std::ifstream file(filename);
-        if (!file.is_open()) {
-            throw std::runtime_error("Cannot open input file: " + filename);
+    // Optional columns found in the header, echoed to the output
+    struct CsvLayout {
+        std::size_t modelColumn = 0;        // 0 = absent (the first 6 columns are fixed)
+        std::size_t outputsColumn = 0;
+        bool greekColumns = false;
+    };
+
+    // Next line of [cursor, end) without its newline; false at the end
+    bool nextLine(const char*& cursor, const char* end, std::string& line) {
+        if (cursor >= end) {
+            return false;
         }
+        const char* newline = static_cast<const char*>(std::memchr(cursor, '\n', static_cast<std::size_t>(end - cursor)));
+        const char* lineEnd = newline != nullptr ? newline : end;
+        line.assign(cursor, lineEnd);
+        cursor = lineEnd + 1;
+        return true;
+    }
 
-        std::vector<OptionRow> rows;
-        std::string line;
-        bool isFirstLine = true;
+    bool isBlank(const std::string& line) {
+        return line.find_first_not_of(" \t") == std::string::npos;
+    }
 
-        while (std::getline(file, line)) {
-            // Skip empty lines
-            if (line.empty() || (line.find_first_not_of(" \t") == std::string::npos)) {
+    // The header only locates the optional columns; returns the offset of the
+    // data lines after it
+    std::size_t parseHeader(const char* data, std::size_t size, CsvLayout& layout) {
+        const char* cursor = data;
+        const char* end = data + size;
+        std::string line;
+        while (nextLine(cursor, end, line)) {
+            if (isBlank(line)) {
                 continue;
             }
+            auto names = splitCSVLine(line);
+            for (std::size_t column = 6; column < names.size(); ++column) {
+                if (names[column] == "model") {
+                    layout.modelColumn = column;
+                } else if (names[column] == "outputs") {
+                    layout.outputsColumn = column;
+                }
+            }
+            break;
+        }
+        return static_cast<std::size_t>(std::min(cursor, end) - data);
+    }
 
-            // Skip header line
-            if (isFirstLine) {
-                isFirstLine = false;
+    // Data lines of [cursor, end), appended to rows; empty lines are skipped
+    void parseRows(const char* cursor, const char* end, const CsvLayout& layout, std::vector<OptionRow>& rows) {
+        std::string line;
+        while (nextLine(cursor, end, line)) {
+            if (isBlank(line)) {
                 continue;
             }
 
@@ -219,97 +478,892 @@ namespace {
             row.rate = parseDouble(fields[3], "rate");
             row.vol = parseDouble(fields[4], "vol");
             row.maturity = parseDouble(fields[5], "maturity");
+            if (layout.modelColumn != 0 && layout.modelColumn < fields.size()) {
+                row.model = fields[layout.modelColumn];
+            }
+            if (layout.outputsColumn != 0 && layout.outputsColumn < fields.size()) {
+                row.outputs = fields[layout.outputsColumn];
+            }
 
             rows.push_back(row);
         }
+    }
 
-        file.close();
+    std::vector<OptionRow> parseCSV(const char* data, std::size_t size, CsvLayout& layout) {
+        std::vector<OptionRow> rows;
+        std::size_t body = parseHeader(data, size, layout);
+        parseRows(data + body, data + size, layout, rows);
         return rows;
     }
 
+    // The input is mapped into memory, following the memory policy
+    // Regular files are mapped; pipes and other streams, which have no size
+    // to map, are read through
+    std::vector<OptionRow> readCSV(const std::string& filename, CsvLayout& layout) {
+        std::error_code status;
+        if (!std::filesystem::is_regular_file(filename, status)) {
+            std::ifstream stream(filename, std::ios::binary);
+            if (!stream.is_open()) {
+                throw std::runtime_error("Cannot open input file: " + filename);
+            }
+            std::string text((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+            if (stream.bad()) {
+                throw std::runtime_error("Cannot read input file: " + filename);
+            }
+            return parseCSV(text.data(), text.size(), layout);
+        }
+
+        std::unique_ptr<pricing::util::MappedFile> file;
+        try {
+            file.reset(new pricing::util::MappedFile(filename, pricing::util::memoryPolicy()));
+        } catch (const std::runtime_error&) {
+            throw std::runtime_error("Cannot open input file: " + filename);
+        }
+        return parseCSV(file->data(), file->size(), layout);
+    }
+
+    // Per-row bookkeeping for the output file and its row hash sidecar
+    struct RowOutput {
+        pricing::batch::RowRequest request;   // Resolved model and outputs of the row
+        bool resolved = false;                // False if the row's model or outputs are invalid
+        pricing::util::ContentKey key;
+        bool indexed = false;                 // Priced or reused; failed rows are not indexed
+        bool written = true;                  // False for results held back by delta publication
+        const char* reusedLine = nullptr;     // Unchanged row: its line in the previous output
+        std::size_t reusedLength = 0;
+    };
+
+    // Everything that shapes an output line besides the row inputs
+    pricing::util::ContentKey outputConfiguration(const CsvLayout& layout) {
+        std::string configuration = std::string("csv-v1|fixed6|") + (layout.greekColumns ? "greeks" : "price");
+        if (layout.modelColumn != 0) {
+            configuration += "|model";
+        }
+        if (layout.outputsColumn != 0) {
+            configuration += "|outputs";
+        }
+        return pricing::util::contentKey(configuration);
+    }
+
+    std::string csvHeader(const CsvLayout& layout) {
+        std::string header = "type,spot,strike,rate,vol,maturity";
+        if (layout.modelColumn != 0) {
+            header += ",model";
+        }
+        if (layout.outputsColumn != 0) {
+            header += ",outputs";
+        }
+        header += ",price";
+        if (layout.greekColumns) {
+            header += ",delta,gamma,vega,theta,rho";
+        }
+        header += "\n";
+        return header;
+    }
+
+    std::string formatRow(const OptionRow& row, const RowOutput& output,
+                          const pricing::core::PricingResult& result, const CsvLayout& layout) {
+        std::ostringstream line;
+        line << std::fixed << std::setprecision(6);
+        line << row.type << ","
+             << row.spot << ","
+             << row.strike << ","
+             << row.rate << ","
+             << row.vol << ","
+             << row.maturity << ",";
+        if (layout.modelColumn != 0) {
+            line << row.model << ",";
+        }
+        if (layout.outputsColumn != 0) {
+            line << row.outputs << ",";
+        }
+        line << result.price;
+
+        // Greeks the row did not ask for are left empty
+        if (layout.greekColumns) {
+            const std::pair<unsigned, double> greeks[] = {
+                {pricing::batch::OutputDelta, result.delta},
+                {pricing::batch::OutputGamma, result.gamma},
+                {pricing::batch::OutputVega, result.vega},
+                {pricing::batch::OutputTheta, result.theta},
+                {pricing::batch::OutputRho, result.rho}};
+            for (const auto& greek : greeks) {
+                line << ",";
+                if (output.request.outputs & greek.first) {
+                    line << greek.second;
+                }
+            }
+        }
+        line << "\n";
+        return line.str();
+    }
+
+    // Writes through a temporary file renamed into place, so the output may
+    // replace the previous output it reuses lines from. The row hash sidecar
+    // is written next to it before the rename: a sidecar left by a run that
+    // stopped in between does not match the output and is not used.
     void writeCSV(const std::string& filename, 
                   const std::vector<OptionRow>& inputRows,
                   const std::vector<pricing::core::PricingResult>& results,
-                  bool withGreeks) {
-        std::ofstream file(filename);
+                  const std::vector<RowOutput>& outputs,
+                  const CsvLayout& layout) {
+        std::string temporary = filename + ".tmp";
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
         if (!file.is_open()) {
             throw std::runtime_error("Cannot open output file: " + filename);
         }
 
-        file << std::fixed << std::setprecision(6);
-
         // Write header
-        file << "type,spot,strike,rate,vol,maturity,price";
-        if (withGreeks) {
-            file << ",delta,gamma,vega,theta,rho";
-        }
-        file << "\n";
+        std::string header = csvHeader(layout);
+        file << header;
 
         // Write data rows
+        pricing::batch::RowHashIndex index(outputConfiguration(layout));
+        std::uint64_t offset = header.size();
+        std::uint64_t hash = pricing::util::fnv1a(header);
         for (size_t i = 0; i < inputRows.size() && i < results.size(); ++i) {
+            const auto& output = outputs[i];
+            if (!output.written) {
+                continue;
+            }
+            std::uint64_t length;
+            if (output.reusedLine != nullptr) {
+                file.write(output.reusedLine, static_cast<std::streamsize>(output.reusedLength));
+                length = output.reusedLength;
+                hash = pricing::util::fnv1a(output.reusedLine, output.reusedLength, hash);
+            } else {
+                std::string line = formatRow(inputRows[i], output, results[i], layout);
+                file << line;
+                length = line.size();
+                hash = pricing::util::fnv1a(line, hash);
+            }
+            if (output.indexed) {
+                index.add(output.key, offset, length);
+            }
+            offset += length;
+        }
+
+        file.close();
+        if (!file) {
+            throw std::runtime_error("Cannot write output file: " + filename);
+        }
+        index.setOutput(offset, hash);
+        index.save(pricing::batch::RowHashIndex::sidecarPath(filename));
+        if (std::rename(temporary.c_str(), filename.c_str()) != 0) {
+            throw std::runtime_error("Cannot write output file: " + filename);
+        }
+    }
+
+    // Canonical text of everything that determines a result; doubles are
+    // written with full precision so equal inputs give equal keys
+    std::string normalizedInputs(const CliArguments& args, const pricing::batch::RowRequest& request,
+                                 const OptionRow& row) {
+        char numbers[160];
+        std::snprintf(numbers, sizeof(numbers), "%.17g|%.17g|%.17g|%.17g|%.17g",
+                      row.spot, row.strike, row.rate, row.vol, row.maturity);
+        std::string outputs = request.outputs == pricing::batch::OutputAll ? "greeks"
+            : request.outputs == pricing::batch::OutputPrice ? "price"
+            : "outputs" + std::to_string(request.outputs);
+        return "v1|" + request.model + "|" + outputs + "|"
+            + args.cacheTag + "|" + row.type + "|" + numbers;
+    }
+
+    // Instrument identity for delta publication: the contract terms, not the
+    // market data. Rows with equal terms (e.g. the same strike and maturity on
+    // different underlyings) are told apart by ordinal, their occurrence among
+    // such rows in the file; the first keeps the plain terms.
+    pricing::util::ContentKey instrumentKey(const pricing::batch::RowRequest& request, const OptionRow& row,
+                                            std::map<std::string, std::size_t>& ordinals) {
+        char terms[80];
+        std::snprintf(terms, sizeof(terms), "%.17g|%.17g", row.strike, row.maturity);
+        std::string key = request.model + "|" + row.type + "|" + terms;
+        std::size_t ordinal = ordinals[key]++;
+        if (ordinal > 0) {
+            key += "|#" + std::to_string(ordinal);
+        }
+        return pricing::util::contentKey(key);
+    }
+
+    // Row model and outputs: the row's own columns, else the batch-wide flags
+    pricing::batch::RowRequest resolveRequest(const CliArguments& args, const OptionRow& row) {
+        pricing::batch::RowRequest request;
+        request.model = row.model.empty() ? args.model : row.model;
+        if (!pricing::models::isModelName(request.model)) {
+            throw std::invalid_argument("Unsupported model: " + request.model);
+        }
+        if (!row.outputs.empty()) {
+            request.outputs = pricing::batch::parseOutputs(row.outputs);
+        } else {
+            request.outputs = args.withGreeks ? pricing::batch::OutputAll : pricing::batch::OutputPrice;
+        }
+        return request;
+    }
+
+    // Per-row model and outputs decide the Greek columns before anything is priced
+    std::vector<RowOutput> resolveRows(const CliArguments& args, const std::vector<OptionRow>& inputRows,
+                                       CsvLayout& layout) {
+        std::vector<RowOutput> outputs(inputRows.size());
+        layout.greekColumns = args.withGreeks;
+        for (std::size_t i = 0; i < inputRows.size(); ++i) {
+            auto& output = outputs[i];
+            try {
+                output.request = resolveRequest(args, inputRows[i]);
+                output.resolved = true;
+                layout.greekColumns = layout.greekColumns || output.request.needsGreeks();
+            } catch (const std::exception& e) {
+                std::cerr << "Warning: Error processing row: " << e.what() << "\n";
+                output.request.outputs = args.withGreeks ? pricing::batch::OutputAll : pricing::batch::OutputPrice;
+            }
+        }
+        return outputs;
+    }
+
+    // Profile first, explicit flags override it
+    pricing::batch::BatchSettings batchSettings(const CliArguments& args) {
+        pricing::batch::BatchSettings settings;
+        if (!args.tuningProfileFile.empty()) {
+            auto profile = pricing::batch::TuningProfile::load(args.tuningProfileFile);
+            if (!profile.matchesHost()) {
+                std::cerr << "Warning: " << args.tuningProfileFile << " was calibrated on another host ("
+                          << profile.host << ")\n";
+            }
+            profile.apply(settings);
+        }
+        settings.reorder = settings.reorder || args.reorder;
+        settings.withGreeks = args.withGreeks;
+        if (args.threads > 0) {
+            settings.numThreads = args.threads;
+        }
+        return settings;
+    }
+
+    void runAutotune(const CliArguments& args) {
+        std::cout << "Calibrating batch engine...\n";
+        auto profile = pricing::batch::AutoTuner().calibrate();
+        profile.save(args.autotuneFile);
+        std::cout << "Tuning profile written to " << args.autotuneFile << ": "
+                  << profile.numThreads << " threads, chunk " << profile.chunkSize << ", "
+                  << (profile.kernel == pricing::batch::BatchKernel::Grouped ? "grouped" : "per-row")
+                  << " kernel, " << (profile.reorder ? "reordered" : "input order") << ", "
+                  << static_cast<unsigned long long>(profile.rowsPerSecond) << " rows/s\n";
+    }
+
+    // Worker mode: serves coordinators until the process is stopped
+    void runWorker(const CliArguments& args) {
+        auto address = pricing::batch::parseWorkerAddress(args.workerListen);
+        pricing::batch::ShardWorker worker(address, batchSettings(args));
+        std::cout << "Worker listening on " << address.host << ":" << worker.port() << std::endl;
+        worker.serve();
+    }
+
+    // Coordinator mode: rows left to price go to the workers in shards and
+    // come back in input order
+    std::vector<pricing::core::PricingResult> priceOnWorkers(
+        const CliArguments& args, const pricing::core::OptionBatch& batch,
+        const std::vector<pricing::batch::RowRequest>& requests, std::vector<std::string>& errors) {
+        std::vector<pricing::batch::WorkerAddress> workers;
+        for (const auto& worker : args.workers) {
+            workers.push_back(pricing::batch::parseWorkerAddress(worker));
+        }
+        pricing::batch::DistributedSettings settings;
+        settings.shardRows = args.shardRows;
+        settings.timeoutSeconds = args.workerTimeout;
+        pricing::batch::ShardCoordinator coordinator(workers, settings);
+        auto results = coordinator.price(batch, requests, &errors);
+        if (coordinator.failedWorkers() > 0) {
+            std::cerr << "Warning: " << coordinator.failedWorkers() << " of " << workers.size()
+                      << " workers failed, " << coordinator.reassignedShards() << " shards reassigned\n";
+        }
+        return results;
+    }
+
+    // Comparison mode: the input is parsed once into one batch that every model reads
+    void processComparison(const CliArguments& args) {
+        CsvLayout layout;
+        auto inputRows = readCSV(args.batchInputFile, layout);
+        if (inputRows.empty()) {
+            throw std::runtime_error("Input file is empty or contains no data rows");
+        }
+
+        std::unique_ptr<pricing::core::HestonParameters> heston;
+        if (!args.hestonParameters.empty()) {
+            const auto& p = args.hestonParameters;
+            heston.reset(new pricing::core::HestonParameters(p[0], p[1], p[2], p[3], p[4]));
+        }
+        std::vector<pricing::batch::ComparedModel> models;
+        for (const auto& spec : args.compareModels) {
+            models.push_back(pricing::batch::ModelComparison::fromSpec(spec, heston.get()));
+        }
+
+        pricing::core::OptionBatch batch;
+        std::vector<std::size_t> batchRows;
+        for (std::size_t i = 0; i < inputRows.size(); ++i) {
             const auto& row = inputRows[i];
-            const auto& result = results[i];
-
-            file << row.type << ","
-                 << row.spot << ","
-                 << row.strike << ","
-                 << row.rate << ","
-                 << row.vol << ","
-                 << row.maturity << ","
-                 << result.price;
-
-            if (withGreeks) {
-                file << "," << result.delta
-                     << "," << result.gamma
-                     << "," << result.vega
-                     << "," << result.theta
-                     << "," << result.rho;
+            try {
+                pricing::core::Option option(parseOptionType(row.type), row.strike, row.maturity);
+                pricing::core::MarketData marketData(row.spot, row.rate, row.vol);
+                batch.add(option, marketData);
+                batchRows.push_back(i);
+            } catch (const std::exception& e) {
+                std::cerr << "Warning: Error processing row: " << e.what() << "\n";
             }
-            file << "\n";
         }
 
+        // Only prices are compared, Greeks would be computed for nothing
+        auto settings = batchSettings(args);
+        settings.withGreeks = false;
+        pricing::batch::ModelComparison comparison(models, settings);
+        auto prices = comparison.price(batch);
+
+        std::ofstream file(args.batchOutputFile);
+        if (!file.is_open()) {
+            throw std::runtime_error("Cannot open output file: " + args.batchOutputFile);
+        }
+        file << "type,spot,strike,rate,vol,maturity";
+        for (const auto& compared : comparison.models()) {
+            file << "," << compared.label;
+        }
+        file << "\n" << std::fixed << std::setprecision(6);
+
+        // Rows that failed to parse or that a model rejected get empty cells
+        std::size_t next = 0;
+        for (std::size_t i = 0; i < inputRows.size(); ++i) {
+            const auto& row = inputRows[i];
+            file << row.type << "," << row.spot << "," << row.strike << ","
+                 << row.rate << "," << row.vol << "," << row.maturity;
+            bool priced = next < batchRows.size() && batchRows[next] == i;
+            for (std::size_t m = 0; m < prices.size(); ++m) {
+                file << ",";
+                if (priced && !std::isnan(prices[m][next].price)) {
+                    file << prices[m][next].price;
+                }
+            }
+            file << "\n";
+            next += priced ? 1 : 0;
+        }
         file.close();
+        if (!file) {
+            throw std::runtime_error("Cannot write output file: " + args.batchOutputFile);
+        }
+
+        std::cout << "Compared " << models.size() << " models on " << inputRows.size()
+                  << " options. Results written to " << args.batchOutputFile << "\n";
+    }
+
+    // Directory and manifest modes
+
+    struct BatchFile {
+        std::filesystem::path input;
+        std::filesystem::path output;   // Same relative path under the output directory
+    };
+
+    // Inputs may not be mirrored outside the output directory
+    std::filesystem::path mirrorPath(const std::filesystem::path& outputDir, const std::filesystem::path& relative) {
+        std::filesystem::path normal = relative.lexically_normal().relative_path();
+        if (normal.empty() || *normal.begin() == "..") {
+            throw std::runtime_error("Input path leaves the batch directory: " + relative.string());
+        }
+        return outputDir / normal;
+    }
+
+    // *.csv files of --batch-dir and its subdirectories (except the output
+    // directory), or the inputs listed in --manifest, one per line, relative
+    // to the manifest's directory
+    std::vector<BatchFile> listBatchFiles(const CliArguments& args) {
+        namespace fs = std::filesystem;
+        std::vector<BatchFile> files;
+        fs::path outputDir(args.batchOutputFile);
+        try {
+            if (!args.batchDir.empty()) {
+                fs::path outputCanonical = fs::weakly_canonical(outputDir);
+                for (auto it = fs::recursive_directory_iterator(args.batchDir); it != fs::recursive_directory_iterator(); ++it) {
+                    if (it->is_directory() && fs::weakly_canonical(it->path()) == outputCanonical) {
+                        it.disable_recursion_pending();
+                    } else if (it->is_regular_file() && it->path().extension() == ".csv") {
+                        files.push_back({it->path(), mirrorPath(outputDir, it->path().lexically_relative(args.batchDir))});
+                    }
+                }
+                std::sort(files.begin(), files.end(),
+                          [](const BatchFile& a, const BatchFile& b) { return a.input < b.input; });
+            } else {
+                std::ifstream manifest(args.manifestFile);
+                if (!manifest.is_open()) {
+                    throw std::runtime_error("Cannot open manifest: " + args.manifestFile);
+                }
+                fs::path base = fs::path(args.manifestFile).parent_path();
+                std::string line;
+                while (std::getline(manifest, line)) {
+                    line.erase(0, line.find_first_not_of(" \t"));
+                    line.erase(line.find_last_not_of(" \t\r") + 1);
+                    if (line.empty() || line[0] == '#') {
+                        continue;
+                    }
+                    fs::path input(line);
+                    files.push_back({input.is_absolute() ? input : base / input, mirrorPath(outputDir, input)});
+                }
+            }
+        } catch (const fs::filesystem_error& e) {
+            throw std::runtime_error(std::string("Cannot list batch files: ") + e.what());
+        }
+        return files;
+    }
+
+    struct LoadedFile {
+        std::size_t index = 0;                  // Into the batch file list
+        std::string data;
+        std::size_t body = 0;                   // Offset of the data lines
+        CsvLayout layout;
+        std::vector<OptionRow> rows;
+        std::vector<RowOutput> outputs;
+        std::vector<pricing::core::PricingResult> results;
+        std::vector<std::string> warnings;
+        std::string error;                      // The file is skipped
+    };
+
+    // Rows of a span of one file after parsing
+    struct ParsedSpan {
+        std::vector<OptionRow> rows;
+        std::vector<RowOutput> outputs;
+        bool greekColumns = false;
+        std::vector<std::string> warnings;
+        std::string error;
+    };
+
+    // Numerical models cost about this many Black-Scholes rows per row
+    constexpr double kNumericalRowCost = 1000.0;
+    constexpr double kParseSpanBytes = 1 << 20;
+    constexpr std::size_t kWaveBytes = std::size_t(64) << 20;
+
+    // Start of the line that contains the byte before offset, so that
+    // neighbouring byte spans split the data lines between them exactly
+    std::size_t lineBoundary(const LoadedFile& file, std::size_t offset) {
+        if (offset <= file.body) {
+            return file.body;
+        }
+        if (offset >= file.data.size()) {
+            return file.data.size();
+        }
+        const char* data = file.data.data();
+        const void* newline = std::memchr(data + offset - 1, '\n', file.data.size() - offset + 1);
+        return newline != nullptr ? static_cast<std::size_t>(static_cast<const char*>(newline) - data) + 1
+                                  : file.data.size();
+    }
+
+    // Spans of all items in file order: (file, begin, item, span)
+    std::vector<std::array<std::size_t, 4>> spansInFileOrder(const std::vector<pricing::batch::WorkItem>& items) {
+        std::vector<std::array<std::size_t, 4>> order;
+        for (std::size_t k = 0; k < items.size(); ++k) {
+            for (std::size_t s = 0; s < items[k].spans.size(); ++s) {
+                order.push_back({items[k].spans[s].file, items[k].spans[s].begin, k, s});
+            }
+        }
+        std::sort(order.begin(), order.end());
+        return order;
+    }
+
+    // One wave of loaded files on the shared pool. Parsing works on byte
+    // spans and pricing on row spans: large files are split, small files are
+    // packed together, so every thread stays busy until the wave ends.
+    // Returns the output text of every file that did not fail.
+    std::vector<std::string> processWave(const CliArguments& args, const pricing::batch::BatchSettings& settings,
+                                         std::vector<LoadedFile>& wave) {
+        for (auto& file : wave) {
+            file.body = parseHeader(file.data.data(), file.data.size(), file.layout);
+        }
+
+        // Parse and resolve the rows
+        std::vector<pricing::batch::WorkFile> byteCounts(wave.size());
+        for (std::size_t f = 0; f < wave.size(); ++f) {
+            byteCounts[f].units = wave[f].data.size() - wave[f].body;
+        }
+        auto parseItems = pricing::batch::planWork(byteCounts, kParseSpanBytes);
+        std::vector<std::vector<ParsedSpan>> parsed(parseItems.size());
+        pricing::util::parallelFor(parseItems.size(), settings.numThreads, [&](std::size_t k) {
+            parsed[k].resize(parseItems[k].spans.size());
+            for (std::size_t s = 0; s < parseItems[k].spans.size(); ++s) {
+                const auto& span = parseItems[k].spans[s];
+                const LoadedFile& file = wave[span.file];
+                ParsedSpan& result = parsed[k][s];
+                try {
+                    const char* data = file.data.data();
+                    parseRows(data + lineBoundary(file, file.body + span.begin),
+                              data + lineBoundary(file, file.body + span.end), file.layout, result.rows);
+                } catch (const std::exception& e) {
+                    result.error = e.what();
+                    continue;
+                }
+                result.outputs.resize(result.rows.size());
+                for (std::size_t i = 0; i < result.rows.size(); ++i) {
+                    auto& output = result.outputs[i];
+                    try {
+                        output.request = resolveRequest(args, result.rows[i]);
+                        output.resolved = true;
+                        result.greekColumns = result.greekColumns || output.request.needsGreeks();
+                    } catch (const std::exception& e) {
+                        result.warnings.push_back(std::string("Error processing row: ") + e.what());
+                        output.request.outputs = args.withGreeks ? pricing::batch::OutputAll : pricing::batch::OutputPrice;
+                    }
+                }
+            }
+        });
+        for (auto& file : wave) {
+            file.layout.greekColumns = args.withGreeks;
+        }
+        for (const auto& ref : spansInFileOrder(parseItems)) {
+            LoadedFile& file = wave[ref[0]];
+            ParsedSpan& span = parsed[ref[2]][ref[3]];
+            if (file.error.empty() && !span.error.empty()) {
+                file.error = span.error;
+            }
+            std::move(span.rows.begin(), span.rows.end(), std::back_inserter(file.rows));
+            std::move(span.outputs.begin(), span.outputs.end(), std::back_inserter(file.outputs));
+            std::move(span.warnings.begin(), span.warnings.end(), std::back_inserter(file.warnings));
+            file.layout.greekColumns = file.layout.greekColumns || span.greekColumns;
+        }
+        parsed.clear();
+
+        // Price and format the rows, weighting numerical models by their cost
+        std::vector<pricing::batch::WorkFile> rowCounts(wave.size());
+        for (std::size_t f = 0; f < wave.size(); ++f) {
+            LoadedFile& file = wave[f];
+            if (file.error.empty() && file.rows.empty()) {
+                file.error = "Input file is empty or contains no data rows";
+            }
+            if (!file.error.empty()) {
+                continue;
+            }
+            double cost = 0.0;
+            for (const auto& output : file.outputs) {
+                cost += output.request.model == "black_scholes" ? 1.0 : kNumericalRowCost;
+            }
+            file.results.resize(file.rows.size());
+            rowCounts[f].units = file.rows.size();
+            rowCounts[f].unitCost = cost / static_cast<double>(file.rows.size());
+        }
+        auto priceItems = pricing::batch::planWork(rowCounts, static_cast<double>(settings.chunkSize));
+        std::vector<std::vector<std::string>> texts(priceItems.size());
+        std::vector<std::vector<std::string>> itemWarnings(priceItems.size());
+        pricing::batch::BatchSettings itemSettings = settings;
+        itemSettings.numThreads = 1;        // The items are the parallel tasks
+        pricing::util::parallelFor(priceItems.size(), settings.numThreads, [&](std::size_t k) {
+            const auto& spans = priceItems[k].spans;
+            pricing::core::OptionBatch pending;
+            std::vector<std::pair<std::size_t, std::size_t>> pendingRows;   // (file, row)
+            std::vector<pricing::batch::RowRequest> pendingRequests;
+            for (const auto& span : spans) {
+                LoadedFile& file = wave[span.file];
+                for (std::size_t i = span.begin; i < span.end; ++i) {
+                    const auto& row = file.rows[i];
+                    if (!file.outputs[i].resolved) {
+                        continue;
+                    }
+                    try {
+                        pricing::core::Option option(parseOptionType(row.type), row.strike, row.maturity);
+                        pricing::core::MarketData marketData(row.spot, row.rate, row.vol);
+                        pending.add(option, marketData);
+                        pendingRows.emplace_back(span.file, i);
+                        pendingRequests.push_back(file.outputs[i].request);
+                    } catch (const std::exception& e) {
+                        itemWarnings[k].push_back(std::string("Error processing row: ") + e.what());
+                    }
+                }
+            }
+            std::vector<std::string> errors;
+            auto priced = pricing::batch::ModelDispatcher(itemSettings).price(pending, pendingRequests, &errors);
+            for (std::size_t p = 0; p < pendingRows.size(); ++p) {
+                wave[pendingRows[p].first].results[pendingRows[p].second] = priced[p];
+                if (!errors[p].empty()) {
+                    itemWarnings[k].push_back("Error processing row: " + errors[p]);
+                }
+            }
+
+            texts[k].resize(spans.size());
+            for (std::size_t s = 0; s < spans.size(); ++s) {
+                const LoadedFile& file = wave[spans[s].file];
+                for (std::size_t i = spans[s].begin; i < spans[s].end; ++i) {
+                    texts[k][s] += formatRow(file.rows[i], file.outputs[i], file.results[i], file.layout);
+                }
+            }
+        });
+        for (const auto& warnings : itemWarnings) {
+            for (const auto& warning : warnings) {
+                std::cerr << "Warning: " << warning << "\n";
+            }
+        }
+
+        std::vector<std::string> outputs(wave.size());
+        for (std::size_t f = 0; f < wave.size(); ++f) {
+            if (wave[f].error.empty()) {
+                outputs[f] = csvHeader(wave[f].layout);
+            }
+        }
+        for (const auto& ref : spansInFileOrder(priceItems)) {
+            outputs[ref[0]] += texts[ref[2]][ref[3]];
+        }
+        return outputs;
+    }
+
+    // Directory and manifest modes: every file is read and written in the
+    // background (up to --io-depth at once) while the files already read are
+    // processed in waves on the shared pool. A file that cannot be read,
+    // parsed or written is reported and skipped; returns their number.
+    std::size_t processBatchFiles(const CliArguments& args) {
+        auto files = listBatchFiles(args);
+        if (files.empty()) {
+            throw std::runtime_error("No input files in " + (args.batchDir.empty() ? args.manifestFile : args.batchDir));
+        }
+
+        auto settings = batchSettings(args);
+        pricing::util::AsyncIoSettings ioSettings;
+        ioSettings.queueDepth = std::min<std::size_t>(args.ioDepth, 4096);
+        pricing::util::AsyncFileIO io(ioSettings);
+
+        std::size_t nextRead = 0;
+        for (; nextRead < files.size() && nextRead < ioSettings.queueDepth; ++nextRead) {
+            io.read(files[nextRead].input.string(), nextRead);
+        }
+
+        std::set<std::filesystem::path> createdDirectories;
+        std::size_t written = 0;
+        std::size_t failed = 0;
+        std::size_t rows = 0;
+        for (;;) {
+            // Wait for one read, then take whatever else has arrived meanwhile
+            std::vector<LoadedFile> wave;
+            std::size_t waveBytes = 0;
+            pricing::util::IoCompletion completion;
+            while (waveBytes < kWaveBytes && (wave.empty() ? io.next(completion) : io.poll(completion))) {
+                std::size_t index = static_cast<std::size_t>(completion.tag);
+                if (completion.write) {
+                    if (completion.error.empty()) {
+                        ++written;
+                    } else {
+                        std::cerr << "Warning: " << completion.error << "\n";
+                        ++failed;
+                    }
+                    continue;
+                }
+                if (nextRead < files.size()) {
+                    io.read(files[nextRead].input.string(), nextRead);
+                    ++nextRead;
+                }
+                if (!completion.error.empty()) {
+                    std::cerr << "Warning: " << completion.error << "\n";
+                    ++failed;
+                    continue;
+                }
+                LoadedFile file;
+                file.index = index;
+                file.data = std::move(completion.data);
+                waveBytes += file.data.size();
+                wave.push_back(std::move(file));
+            }
+            if (wave.empty()) {
+                break;
+            }
+
+            auto outputs = processWave(args, settings, wave);
+            for (std::size_t f = 0; f < wave.size(); ++f) {
+                const LoadedFile& file = wave[f];
+                const BatchFile& batchFile = files[file.index];
+                for (const auto& warning : file.warnings) {
+                    std::cerr << "Warning: " << warning << "\n";
+                }
+                if (!file.error.empty()) {
+                    std::cerr << "Warning: " << batchFile.input.string() << ": " << file.error << "\n";
+                    ++failed;
+                    continue;
+                }
+                std::filesystem::path directory = batchFile.output.parent_path();
+                if (!directory.empty() && createdDirectories.insert(directory).second) {
+                    std::error_code ignored;
+                    std::filesystem::create_directories(directory, ignored);   // A failure surfaces on write
+                }
+                rows += file.rows.size();
+                io.write(batchFile.output.string(), std::move(outputs[f]), file.index);
+            }
+        }
+
+        std::cout << "Processed " << written << " of " << files.size() << " files (" << rows
+                  << " options). Results written to " << args.batchOutputFile << " (I/O: "
+                  << (io.backend() == pricing::util::IoBackend::IoUring ? "io_uring" : "threads") << ")\n";
+        if (failed > 0) {
+            std::cerr << failed << " files could not be processed\n";
+        }
+        return failed;
     }
 
     void processBatch(const CliArguments& args) {
         // Read input CSV
-        auto inputRows = readCSV(args.batchInputFile);
+        CsvLayout layout;
+        auto inputRows = readCSV(args.batchInputFile, layout);
 
         if (inputRows.empty()) {
             throw std::runtime_error("Input file is empty or contains no data rows");
         }
 
-        // Process each row
-        pricing::models::BlackScholesModel model;
-        std::vector<pricing::core::PricingResult> results;
+        auto outputs = resolveRows(args, inputRows, layout);
+        std::size_t reused = 0;
+
+        // Incremental mode: lines of unchanged rows are copied from the previous output
+        std::unique_ptr<pricing::util::MappedFile> previous;
+        pricing::batch::RowHashIndex previousIndex;
+        if (!args.sinceFile.empty()) {
+            try {
+                previousIndex = pricing::batch::RowHashIndex::load(
+                    pricing::batch::RowHashIndex::sidecarPath(args.sinceFile));
+                previous.reset(new pricing::util::MappedFile(args.sinceFile, pricing::util::memoryPolicy()));
+                if (!previousIndex.describes(previous->data(), previous->size())) {
+                    std::cerr << "Warning: " << args.sinceFile << " was changed after its row hash index was written, repricing all rows\n";
+                    previous.reset();
+                } else if (previousIndex.configuration() != outputConfiguration(layout)) {
+                    std::cerr << "Warning: " << args.sinceFile << " has a different output format, repricing all rows\n";
+                    previous.reset();
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "Warning: Cannot reuse previous output: " << e.what() << "\n";
+                previous.reset();
+            }
+        }
+
+        std::unique_ptr<pricing::batch::ResultCache> cache;
+        if (!args.cacheFile.empty()) {
+            pricing::batch::ResultCacheSettings cacheSettings;
+            if (args.cacheMaxEntries > 0) {
+                cacheSettings.maxEntries = args.cacheMaxEntries;
+            }
+            cache.reset(new pricing::batch::ResultCache(args.cacheFile, cacheSettings));
+        }
+
+        // Rows that are neither reused nor cached are priced together, grouped
+        // by model; Black-Scholes rows with the batch-wide outputs go through an
+        // external sort when reordering out of core
+        std::vector<pricing::core::PricingResult> results(inputRows.size());
+        pricing::core::OptionBatch pending;
+        std::vector<std::size_t> pendingRows;
+        std::vector<pricing::batch::RowRequest> pendingRequests;
+        std::unique_ptr<pricing::batch::ExternalSorter> sorter;
+        if (args.sortMemory > 0) {
+            pricing::batch::ExternalSortSettings sortSettings;
+            sortSettings.memoryLimit = args.sortMemory << 20;
+            sorter.reset(new pricing::batch::ExternalSorter(sortSettings));
+        }
 
-        for (const auto& row : inputRows) {
+        for (std::size_t i = 0; i < inputRows.size(); ++i) {
+            const auto& row = inputRows[i];
+            auto& output = outputs[i];
+            if (!output.resolved) {
+                continue;
+            }
             try {
                 pricing::core::OptionType optionType = parseOptionType(row.type);
                 pricing::core::Option option(optionType, row.strike, row.maturity);
                 pricing::core::MarketData marketData(row.spot, row.rate, row.vol);
 
-                pricing::core::PricingResult result;
-                if (args.withGreeks) {
-                    result = model.priceWithGreeks(option, marketData);
-                } else {
-                    result = model.price(option, marketData);
+                pricing::util::ContentKey key = pricing::util::contentKey(normalizedInputs(args, output.request, row));
+                output.key = key;
+                output.indexed = true;
+
+                if (previous) {
+                    const auto* location = previousIndex.find(key);
+                    if (location != nullptr && location->offset + location->length <= previous->size()) {
+                        output.reusedLine = previous->data() + location->offset;
+                        output.reusedLength = static_cast<std::size_t>(location->length);
+                        ++reused;
+                        continue;
+                    }
+                }
+                if (cache && cache->find(key, results[i])) {
+                    continue;
                 }
 
-                results.push_back(result);
+                if (sorter && output.request.model == "black_scholes"
+                    && output.request.needsGreeks() == args.withGreeks) {
+                    sorter->add(pricing::batch::ExternalSorter::localityRecord(i, option, marketData));
+                } else {
+                    pending.add(option, marketData);
+                    pendingRows.push_back(i);
+                    pendingRequests.push_back(output.request);
+                }
             } catch (const std::exception& e) {
                 std::cerr << "Warning: Error processing row: " << e.what() << "\n";
-                // Add empty result to maintain row alignment
-                pricing::core::PricingResult emptyResult;
-                results.push_back(emptyResult);
+                // Empty result keeps the row alignment
+                output.indexed = false;
+            }
+        }
+
+        auto settings = batchSettings(args);
+        auto storeResult = [&](std::size_t i, const pricing::core::PricingResult& result) {
+            results[i] = result;
+            if (cache) {
+                cache->store(outputs[i].key, result);
+            }
+        };
+        if (sorter) {
+            sorter->finish();
+            pricing::batch::BatchEngine(settings).priceSorted(
+                *sorter, [&](std::uint64_t row, const pricing::core::PricingResult& result) {
+                    storeResult(static_cast<std::size_t>(row), result);
+                });
+        }
+        std::vector<std::string> errors;
+        auto priced = args.workers.empty()
+            ? pricing::batch::ModelDispatcher(settings).price(pending, pendingRequests, &errors)
+            : priceOnWorkers(args, pending, pendingRequests, errors);
+        for (std::size_t k = 0; k < pendingRows.size(); ++k) {
+            if (!errors[k].empty()) {
+                std::cerr << "Warning: Error processing row: " << errors[k] << "\n";
+                // Empty result, kept out of the cache and the row hash index
+                outputs[pendingRows[k]].indexed = false;
+                continue;
             }
+            storeResult(pendingRows[k], priced[k]);
         }
 
-        // Write output CSV
-        writeCSV(args.batchOutputFile, inputRows, results, args.withGreeks);
+        // Delta publication: hold back results that did not move materially
+        std::size_t published = 0;
+        pricing::batch::PublicationSettings publication;
+        publication.threshold = args.publishThreshold;
+        publication.trackGreeks = layout.greekColumns;
+        pricing::batch::DeltaPublisher publisher(publication);
+        if (!args.publishStateFile.empty()) {
+            publisher.load(args.publishStateFile);
+            std::map<std::string, std::size_t> ordinals;
+            for (std::size_t i = 0; i < inputRows.size(); ++i) {
+                // Every row takes its ordinal, so a failed row does not shift the later ones
+                pricing::util::ContentKey instrument = instrumentKey(outputs[i].request, inputRows[i], ordinals);
+                outputs[i].written = outputs[i].indexed && publisher.update(instrument, results[i]);
+                published += outputs[i].written ? 1 : 0;
+            }
+        }
+
+        // Write output CSV; publications are recorded only once it is in place
+        writeCSV(args.batchOutputFile, inputRows, results, outputs, layout);
+        if (!args.publishStateFile.empty()) {
+            publisher.save(args.publishStateFile);
+        }
 
         std::cout << "Processed " << inputRows.size() << " options. Results written to " 
                   << args.batchOutputFile << "\n";
+        if (!args.publishStateFile.empty()) {
+            std::cout << "Published " << published << " changed results\n";
+        }
+        if (!args.sinceFile.empty()) {
+            std::cout << "Reused " << reused << " unchanged rows from " << args.sinceFile << "\n";
+        }
+
+        if (cache) {
+            if (args.cacheMaxAge > 0) {
+                cache->compact(args.cacheMaxAge);
+            }
+            std::cout << "Cache: " << cache->hits() << " hits, " << cache->misses() << " misses, "
+                      << cache->size() << " entries\n";
+        }
+        if (args.hugePages || args.prefault) {
+            auto stats = pricing::util::largeAllocationStats();
+            std::cout << "Large buffers: " << stats.hugeTlb << " on reserved huge pages, "
+                      << stats.transparent << " transparent huge pages, " << stats.regular << " regular\n";
+        }
     }
 }
 
@@ -324,9 +1378,35 @@ int main(int argc, char* argv[]) {
 
         validateArguments(args);
 
+        pricing::util::MemoryPolicy memory;
+        memory.hugePages = args.hugePages;
+        memory.prefault = args.prefault;
+        pricing::util::setMemoryPolicy(memory);
+
+        if (!args.workerListen.empty()) {
+            runWorker(args);
+            return 0;
+        }
+
+        if (!args.autotuneFile.empty()) {
+            runAutotune(args);
+            if (args.batchInputFile.empty() && args.batchDir.empty() && args.manifestFile.empty()) {
+                return 0;
+            }
+            args.tuningProfileFile = args.autotuneFile;
+        }
+
+        if (!args.batchDir.empty() || !args.manifestFile.empty()) {
+            return processBatchFiles(args) == 0 ? 0 : 1;
+        }
+
         // Check if batch mode
         if (!args.batchInputFile.empty()) {
-            processBatch(args);
+            if (!args.compareModels.empty()) {
+                processComparison(args);
+            } else {
+                processBatch(args);
+            }
             return 0;
         }
 
@@ -334,12 +1414,12 @@ int main(int argc, char* argv[]) {
         pricing::core::Option option(args.optionType, args.strike, args.maturity);
         pricing::core::MarketData marketData(args.spot, args.rate, args.vol);
 
-        pricing::models::BlackScholesModel model;
+        auto model = pricing::models::createModel(args.model);
         pricing::core::PricingResult result;
         if (args.withGreeks) {
-            result = model.priceWithGreeks(option, marketData);
+            result = model->priceWithGreeks(option, marketData);
         } else {
-            result = model.price(option, marketData);
+            result = model->price(option, marketData);
         }
 
         printResult(result, args);
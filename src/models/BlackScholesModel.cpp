@@ -9,6 +9,7 @@ namespace models {
 core::PricingResult BlackScholesModel::price(
     const core::Option& option,
     const core::MarketData& marketData) const {
+    requireEuropean(option, "Black-Scholes");
 
     double S = marketData.getSpot();
     double K = option.getStrike();
@@ -56,6 +57,7 @@ core::PricingResult BlackScholesModel::price(
 core::PricingResult BlackScholesModel::priceWithGreeks(
     const core::Option& option,
     const core::MarketData& marketData) const {
+    requireEuropean(option, "Black-Scholes");
 
     double S = marketData.getSpot();
     double K = option.getStrike();
@@ -111,6 +113,58 @@ core::PricingResult BlackScholesModel::priceWithGreeks(
     return result;
 }
 
+void BlackScholesModel::priceBatch(const core::OptionBatch& batch, std::size_t begin, std::size_t end,
+                                   bool withGreeks, core::PricingResult* results) const {
+    // Terms shared by rows with the same rate, volatility and maturity,
+    // written exactly as in the single-option formulas
+    double sharedR = 0.0, sharedSigma = 0.0, sharedT = -1.0;
+    double sqrtT = 0.0, volSqrtT = 0.0, driftT = 0.0, discountFactor = 0.0;
+
+    for (std::size_t k = begin; k < end; ++k) {
+        double S = batch.spots[k];
+        double K = batch.strikes[k];
+        double r = batch.rates[k];
+        double sigma = batch.volatilities[k];
+        double T = batch.maturities[k];
+        bool isCall = batch.types[k] == core::OptionType::Call;
+
+        if (T == 0.0 || sigma == 0.0) {
+            core::Option option(batch.types[k], K, T);
+            core::MarketData marketData(S, r, sigma);
+            results[k] = withGreeks ? priceWithGreeks(option, marketData) : price(option, marketData);
+            continue;
+        }
+        if (T != sharedT || r != sharedR || sigma != sharedSigma) {
+            sharedT = T;
+            sharedR = r;
+            sharedSigma = sigma;
+            sqrtT = std::sqrt(T);
+            volSqrtT = sigma * sqrtT;
+            driftT = (r + 0.5 * sigma * sigma) * T;
+            discountFactor = std::exp(-r * T);
+        }
+
+        double d1 = (std::log(S / K) + driftT) / volSqrtT;
+        double d2 = d1 - volSqrtT;
+        double nd1 = normalCDF(isCall ? d1 : -d1);
+        double nd2 = normalCDF(isCall ? d2 : -d2);
+
+        core::PricingResult result;
+        result.price = isCall ? S * nd1 - K * discountFactor * nd2 : K * discountFactor * nd2 - S * nd1;
+
+        if (withGreeks) {
+            double pdf = normalPDF(d1);
+            result.delta = isCall ? nd1 : normalCDF(d1) - 1.0;
+            result.gamma = pdf / (S * sigma * sqrtT);
+            result.vega = S * pdf * sqrtT;
+            double theta = -S * pdf * sigma / (2.0 * sqrtT);
+            result.theta = isCall ? theta - r * K * discountFactor * nd2 : theta + r * K * discountFactor * nd2;
+            result.rho = isCall ? K * T * discountFactor * nd2 : -K * T * discountFactor * nd2;
+        }
+        results[k] = result;
+    }
+}
+
 double BlackScholesModel::normalCDF(double x) {
     // Approximation of the cumulative distribution function
     // Using Abramowitz and Stegun approximation
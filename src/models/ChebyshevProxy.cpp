@@ -0,0 +1,240 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../../include/pricing/models/ChebyshevProxy.hpp"
+#include "../../include/pricing/util/Parallel.hpp"
+
+namespace pricing {
+namespace models {
+
+namespace {
+    const std::size_t parameterCount = 5;
+    const char fileMagic[8] = {'P', 'R', 'C', 'H', 'E', 'B', '0', '1'};
+
+    // On-disk layout: FileHeader, dimensionCount DimensionRecords, then the
+    // coefficients as doubles. All records are multiples of 8 bytes, so the
+    // coefficients are naturally aligned in a mapping.
+    struct FileHeader {
+        char magic[8];
+        std::uint32_t optionType;
+        std::uint32_t exercise;
+        double reference[parameterCount];
+        std::uint64_t dimensionCount;
+    };
+
+    struct DimensionRecord {
+        std::uint32_t parameter;
+        std::uint32_t reserved;
+        double lower;
+        double upper;
+        std::uint64_t nodes;
+    };
+
+    core::Option makeOption(core::OptionType type, core::ExerciseStyle exercise, const double* values) {
+        return core::Option(type, values[1], values[2], exercise);
+    }
+
+    core::MarketData makeMarketData(const double* values) {
+        return core::MarketData(values[0], values[3], values[4]);
+    }
+}
+
+ChebyshevProxy::ChebyshevProxy(std::vector<ProxyParameter> parameters, numerics::ChebyshevTensor tensor,
+                               core::OptionType type, core::ExerciseStyle exercise, const double* reference)
+    : parameters_(std::move(parameters)), tensor_(std::move(tensor)), type_(type), exercise_(exercise) {
+    std::copy(reference, reference + parameterCount, reference_);
+}
+
+double ChebyshevProxy::parameterValue(ProxyParameter parameter, const core::Option& option,
+                                      const core::MarketData& marketData) {
+    switch (parameter) {
+        case ProxyParameter::Spot: return marketData.getSpot();
+        case ProxyParameter::Strike: return option.getStrike();
+        case ProxyParameter::Maturity: return option.getTimeToExpiration();
+        case ProxyParameter::Rate: return marketData.getRiskFreeRate();
+        case ProxyParameter::Volatility: return marketData.getVolatility();
+    }
+    throw std::invalid_argument("Unknown proxy parameter");
+}
+
+ChebyshevProxy ChebyshevProxy::build(
+    const PricingModel& model,
+    const core::Option& referenceOption,
+    const core::MarketData& referenceMarketData,
+    const std::vector<ProxyDimension>& dimensions,
+    unsigned numThreads) {
+
+    std::vector<ProxyParameter> parameters;
+    std::vector<double> lower, upper;
+    std::vector<std::size_t> nodes;
+    for (const auto& dimension : dimensions) {
+        for (ProxyParameter seen : parameters) {
+            if (seen == dimension.parameter) {
+                throw std::invalid_argument("Proxy parameter listed twice");
+            }
+        }
+        parameters.push_back(dimension.parameter);
+        lower.push_back(dimension.lower);
+        upper.push_back(dimension.upper);
+        nodes.push_back(dimension.nodes);
+    }
+    numerics::ChebyshevTensor tensor(lower, upper, nodes);
+
+    double reference[parameterCount];
+    for (std::size_t p = 0; p < parameterCount; ++p) {
+        reference[p] = parameterValue(static_cast<ProxyParameter>(p), referenceOption, referenceMarketData);
+    }
+
+    std::vector<std::vector<double>> points(dimensions.size());
+    for (std::size_t d = 0; d < dimensions.size(); ++d) {
+        points[d] = tensor.points(d);
+    }
+
+    // One model call per tensor node; the model must be safe to call concurrently
+    std::vector<double> values(tensor.size());
+    util::parallelFor(tensor.size(), numThreads, [&](std::size_t index) {
+        double inputs[parameterCount];
+        std::copy(reference, reference + parameterCount, inputs);
+        std::size_t remainder = index;
+        for (std::size_t d = dimensions.size(); d-- > 0;) {
+            inputs[static_cast<std::size_t>(parameters[d])] = points[d][remainder % nodes[d]];
+            remainder /= nodes[d];
+        }
+        values[index] = model.price(makeOption(referenceOption.getType(), referenceOption.getExerciseStyle(), inputs),
+                                    makeMarketData(inputs)).price;
+    });
+    tensor.fit(values);
+
+    return ChebyshevProxy(std::move(parameters), std::move(tensor), referenceOption.getType(),
+                          referenceOption.getExerciseStyle(), reference);
+}
+
+core::PricingResult ChebyshevProxy::price(
+    const core::Option& option,
+    const core::MarketData& marketData) const {
+
+    if (option.getType() != type_ || option.getExerciseStyle() != exercise_) {
+        throw std::invalid_argument("Option type or exercise style differs from the proxy");
+    }
+
+    double point[parameterCount];
+    bool isDimension[parameterCount] = {false, false, false, false, false};
+    for (std::size_t d = 0; d < parameters_.size(); ++d) {
+        double value = parameterValue(parameters_[d], option, marketData);
+        double tolerance = 1e-12 * (tensor_.upper()[d] - tensor_.lower()[d]);
+        if (value < tensor_.lower()[d] - tolerance || value > tensor_.upper()[d] + tolerance) {
+            throw std::invalid_argument("Pricing input outside the proxy domain");
+        }
+        point[d] = value;
+        isDimension[static_cast<std::size_t>(parameters_[d])] = true;
+    }
+    for (std::size_t p = 0; p < parameterCount; ++p) {
+        double value = parameterValue(static_cast<ProxyParameter>(p), option, marketData);
+        if (!isDimension[p] && std::abs(value - reference_[p]) > 1e-12 * std::max(1.0, std::abs(reference_[p]))) {
+            throw std::invalid_argument("Pricing input outside the proxy domain");
+        }
+    }
+
+    core::PricingResult result;
+    result.price = tensor_.evaluate(point);
+    return result;
+}
+
+void ChebyshevProxy::save(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Cannot open file: " + path);
+    }
+
+    FileHeader header{};
+    std::memcpy(header.magic, fileMagic, sizeof(fileMagic));
+    header.optionType = static_cast<std::uint32_t>(type_);
+    header.exercise = static_cast<std::uint32_t>(exercise_);
+    std::copy(reference_, reference_ + parameterCount, header.reference);
+    header.dimensionCount = parameters_.size();
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    for (std::size_t d = 0; d < parameters_.size(); ++d) {
+        DimensionRecord record{};
+        record.parameter = static_cast<std::uint32_t>(parameters_[d]);
+        record.lower = tensor_.lower()[d];
+        record.upper = tensor_.upper()[d];
+        record.nodes = tensor_.nodeCounts()[d];
+        out.write(reinterpret_cast<const char*>(&record), sizeof(record));
+    }
+    out.write(reinterpret_cast<const char*>(tensor_.coefficients()),
+              static_cast<std::streamsize>(tensor_.size() * sizeof(double)));
+    if (!out) {
+        throw std::runtime_error("Cannot write file: " + path);
+    }
+}
+
+ChebyshevProxy ChebyshevProxy::load(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open file: " + path);
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(FileHeader)) {
+        ::close(fd);
+        throw std::runtime_error("Invalid proxy file: " + path);
+    }
+    std::size_t length = static_cast<std::size_t>(info.st_size);
+    void* mapping = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Cannot map file: " + path);
+    }
+    std::shared_ptr<const char> region(static_cast<const char*>(mapping),
+                                       [length](const char* data) { ::munmap(const_cast<char*>(data), length); });
+
+    FileHeader header;
+    std::memcpy(&header, region.get(), sizeof(header));
+    if (std::memcmp(header.magic, fileMagic, sizeof(fileMagic)) != 0
+        || header.optionType > static_cast<std::uint32_t>(core::OptionType::Put)
+        || header.exercise > static_cast<std::uint32_t>(core::ExerciseStyle::American)
+        || header.dimensionCount == 0 || header.dimensionCount > parameterCount
+        || length < sizeof(FileHeader) + header.dimensionCount * sizeof(DimensionRecord)) {
+        throw std::runtime_error("Invalid proxy file: " + path);
+    }
+
+    std::vector<ProxyParameter> parameters;
+    std::vector<double> lower, upper;
+    std::vector<std::size_t> nodes;
+    std::size_t coefficientCount = 1;
+    const char* cursor = region.get() + sizeof(FileHeader);
+    for (std::uint64_t d = 0; d < header.dimensionCount; ++d) {
+        DimensionRecord record;
+        std::memcpy(&record, cursor, sizeof(record));
+        cursor += sizeof(record);
+        if (record.parameter >= parameterCount || record.nodes < 2) {
+            throw std::runtime_error("Invalid proxy file: " + path);
+        }
+        parameters.push_back(static_cast<ProxyParameter>(record.parameter));
+        lower.push_back(record.lower);
+        upper.push_back(record.upper);
+        nodes.push_back(static_cast<std::size_t>(record.nodes));
+        coefficientCount *= nodes.back();
+    }
+    if (static_cast<std::size_t>(region.get() + length - cursor) != coefficientCount * sizeof(double)) {
+        throw std::runtime_error("Invalid proxy file: " + path);
+    }
+
+    std::shared_ptr<const double> coefficients(region, reinterpret_cast<const double*>(cursor));
+    numerics::ChebyshevTensor tensor(std::move(lower), std::move(upper), std::move(nodes), std::move(coefficients));
+    return ChebyshevProxy(std::move(parameters), std::move(tensor),
+                          static_cast<core::OptionType>(header.optionType),
+                          static_cast<core::ExerciseStyle>(header.exercise), header.reference);
+}
+
+} // namespace models
+} // namespace pricing
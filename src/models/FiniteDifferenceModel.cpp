@@ -0,0 +1,181 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "../../include/pricing/models/FiniteDifferenceModel.hpp"
+#include "../../include/pricing/numerics/Grid.hpp"
+#include "../../include/pricing/numerics/TridiagonalSolver.hpp"
+
+namespace pricing {
+namespace models {
+
+FiniteDifferenceModel::FiniteDifferenceModel(const FiniteDifferenceSettings& settings)
+    : settings_(settings) {
+    validate();
+}
+
+void FiniteDifferenceModel::validate() const {
+    if (settings_.spotSteps < 2) {
+        throw std::invalid_argument("Finite-difference grid needs at least two intervals");
+    }
+    if (settings_.timeSteps == 0) {
+        throw std::invalid_argument("Finite-difference solver requires at least one time step");
+    }
+    if (settings_.maxSpotMultiple <= 1.0) {
+        throw std::invalid_argument("Upper spot boundary must lie above the strike and spot");
+    }
+    if (settings_.concentration <= 0.0) {
+        throw std::invalid_argument("Grid concentration must be positive");
+    }
+}
+
+core::PricingResult FiniteDifferenceModel::price(
+    const core::Option& option,
+    const core::MarketData& marketData) const {
+
+    return priceStrikes(option.getType(), option.getExerciseStyle(), {option.getStrike()},
+                        option.getTimeToExpiration(), marketData).front();
+}
+
+std::vector<core::PricingResult> FiniteDifferenceModel::priceStrikes(
+    core::OptionType type,
+    core::ExerciseStyle exercise,
+    const std::vector<double>& strikes,
+    double timeToExpiration,
+    const core::MarketData& marketData) const {
+
+    if (strikes.empty()) {
+        return {};
+    }
+    double lowestStrike = strikes.front();
+    double logSum = 0.0;
+    for (double strike : strikes) {
+        core::Option(type, strike, timeToExpiration);   // Validates every strike and the maturity
+        lowestStrike = std::min(lowestStrike, strike);
+        logSum += std::log(strike);
+    }
+
+    double S = marketData.getSpot();
+    bool isCall = type == core::OptionType::Call;
+    std::vector<core::PricingResult> results(strikes.size());
+
+    if (timeToExpiration == 0.0) {
+        for (std::size_t k = 0; k < strikes.size(); ++k) {
+            results[k].price = isCall ? std::max(S - strikes[k], 0.0) : std::max(strikes[k] - S, 0.0);
+        }
+        return results;
+    }
+
+    // Concentrate at the strike (moneyness 1) and at the spot of a typical strike of the chain
+    double typicalMoneyness = S / std::exp(logSum / static_cast<double>(strikes.size()));
+    double upper = settings_.maxSpotMultiple * std::max(1.0, S / lowestStrike);
+    Solution solution = solveMoneyness(isCall, exercise == core::ExerciseStyle::American,
+                                       marketData.getRiskFreeRate(), marketData.getVolatility(),
+                                       timeToExpiration, {1.0, typicalMoneyness}, upper);
+
+    for (std::size_t k = 0; k < strikes.size(); ++k) {
+        results[k].price = strikes[k] * interpolate(solution, S / strikes[k]);
+    }
+    return results;
+}
+
+FiniteDifferenceModel::Solution FiniteDifferenceModel::solveMoneyness(
+    bool isCall, bool isAmerican, double r, double sigma, double T,
+    const std::vector<double>& centers, double upper) const {
+
+    Solution solution;
+    solution.grid = numerics::concentratedGrid(0.0, upper, centers, settings_.concentration,
+                                               settings_.spotSteps);
+    const std::vector<double>& x = solution.grid;
+    std::size_t n = x.size();
+
+    // Spatial operator A u = 0.5 sigma^2 x^2 u_xx + r x u_x - r u as a tridiagonal stencil.
+    // At x = 0 only the discounting survives; at the top u_xx = 0 (linear boundary).
+    std::vector<double> lower(n, 0.0), diag(n, -r), upperDiag(n, 0.0);
+    for (std::size_t i = 1; i + 1 < n; ++i) {
+        double hm = x[i] - x[i - 1];
+        double hp = x[i + 1] - x[i];
+        double second = 0.5 * sigma * sigma * x[i] * x[i];
+        double first = r * x[i];
+        lower[i] = -first * hp / (hm * (hm + hp)) + second * 2.0 / (hm * (hm + hp));
+        diag[i] += first * (hp - hm) / (hm * hp) - second * 2.0 / (hm * hp);
+        upperDiag[i] = first * hm / (hp * (hm + hp)) + second * 2.0 / (hp * (hm + hp));
+    }
+    double hLast = x[n - 1] - x[n - 2];
+    lower[n - 1] = -r * x[n - 1] / hLast;
+    diag[n - 1] += r * x[n - 1] / hLast;
+
+    std::vector<double>& u = solution.values;
+    u.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        u[i] = isCall ? std::max(x[i] - 1.0, 0.0) : std::max(1.0 - x[i], 0.0);
+    }
+    std::vector<double> payoff = u;
+
+    // Rannacher start: the first Crank-Nicolson steps become twice as many
+    // fully implicit half steps, which damps the oscillations from the kink
+    std::size_t smoothingSteps = std::min(settings_.rannacherSteps, settings_.timeSteps);
+    double dt = T / static_cast<double>(settings_.timeSteps);
+
+    numerics::TridiagonalSolver solver(n);
+    std::vector<double> implicitLower(n), implicitDiag(n), implicitUpper(n);
+    std::vector<double> rhs(n), next(n), multiplier(n, 0.0);
+    double builtFor = -1.0;
+
+    auto advance = [&](double stepSize, double theta) {
+        double weight = theta * stepSize;
+        if (weight != builtFor) {
+            for (std::size_t i = 0; i < n; ++i) {
+                implicitLower[i] = -weight * lower[i];
+                implicitDiag[i] = 1.0 - weight * diag[i];
+                implicitUpper[i] = -weight * upperDiag[i];
+            }
+            builtFor = weight;
+        }
+
+        double explicitWeight = (1.0 - theta) * stepSize;
+        for (std::size_t i = 0; i < n; ++i) {
+            double applied = diag[i] * u[i];
+            if (i > 0) {
+                applied += lower[i] * u[i - 1];
+            }
+            if (i + 1 < n) {
+                applied += upperDiag[i] * u[i + 1];
+            }
+            rhs[i] = u[i] + explicitWeight * applied + stepSize * multiplier[i];
+        }
+        if (!isAmerican) {
+            // rhs holds everything the step needs from u, so u takes the solution
+            solver.solve(implicitLower.data(), implicitDiag.data(), implicitUpper.data(), rhs.data(), u.data());
+            return;
+        }
+
+        // Ikonen-Toivanen splitting of the early exercise constraint
+        solver.solve(implicitLower.data(), implicitDiag.data(), implicitUpper.data(), rhs.data(), next.data());
+        for (std::size_t i = 0; i < n; ++i) {
+            double candidate = next[i];
+            u[i] = std::max(candidate - stepSize * multiplier[i], payoff[i]);
+            multiplier[i] = std::max(0.0, multiplier[i] + (payoff[i] - candidate) / stepSize);
+        }
+    };
+
+    for (std::size_t step = 0; step < 2 * smoothingSteps; ++step) {
+        advance(0.5 * dt, 1.0);
+    }
+    for (std::size_t step = smoothingSteps; step < settings_.timeSteps; ++step) {
+        advance(dt, 0.5);
+    }
+    return solution;
+}
+
+double FiniteDifferenceModel::interpolate(const Solution& solution, double moneyness) {
+    numerics::InterpolationStencil stencil = numerics::interpolationStencil(solution.grid, moneyness);
+    double value = 0.0;
+    for (std::size_t k = 0; k < 3; ++k) {
+        value += stencil.weights[k] * solution.values[stencil.first + k];
+    }
+    return value;
+}
+
+} // namespace models
+} // namespace pricing
@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+#include "../../include/pricing/models/HestonAdiModel.hpp"
+#include "../../include/pricing/numerics/Grid.hpp"
+
+namespace pricing {
+namespace models {
+
+HestonAdiModel::HestonAdiModel(const core::HestonParameters& parameters,
+                               const HestonAdiSettings& settings)
+    : parameters_(parameters), settings_(settings) {
+    validate();
+}
+
+void HestonAdiModel::validate() const {
+    if (settings_.spotSteps < 2 || settings_.varianceSteps < 2) {
+        throw std::invalid_argument("ADI grid needs at least two intervals per direction");
+    }
+    if (settings_.timeSteps == 0) {
+        throw std::invalid_argument("ADI requires at least one time step");
+    }
+    if (settings_.maxSpotMultiple <= 1.0) {
+        throw std::invalid_argument("Upper spot boundary must lie above the strike");
+    }
+    if (settings_.maxVariance <= 0.0) {
+        throw std::invalid_argument("Upper variance boundary must be positive");
+    }
+}
+
+core::PricingResult HestonAdiModel::price(
+    const core::Option& option,
+    const core::MarketData& marketData) const {
+
+    double S = marketData.getSpot();
+    double K = option.getStrike();
+    double r = marketData.getRiskFreeRate();
+    double T = option.getTimeToExpiration();
+    double v0 = parameters_.getInitialVariance();
+    double sign = option.isCall() ? 1.0 : -1.0;
+
+    core::PricingResult result;
+    if (T == 0.0) {
+        result.price = std::max(sign * (S - K), 0.0);
+        return result;
+    }
+
+    // Grids after In 't Hout & Foulon: spot concentrated at the strike, variance at zero
+    double maxSpot = std::max(settings_.maxSpotMultiple * K, 2.0 * S);
+    double maxVariance = std::max(settings_.maxVariance, 2.0 * v0);
+    std::vector<double> spots = numerics::sinhGrid(0.0, maxSpot, K, K / 5.0, settings_.spotSteps);
+    std::vector<double> variances = numerics::sinhGrid(
+        0.0, maxVariance, 0.0, maxVariance / 500.0, settings_.varianceSteps);
+
+    double kappa = parameters_.getMeanReversion();
+    double theta = parameters_.getLongTermVariance();
+    double xi = parameters_.getVolOfVol();
+    double rho = parameters_.getCorrelation();
+
+    std::size_t nx = spots.size();
+    std::size_t n = nx * variances.size();
+    numerics::AdiCoefficients coefficients{std::vector<double>(n), std::vector<double>(n),
+                                           std::vector<double>(n), std::vector<double>(n),
+                                           std::vector<double>(n), std::vector<double>(n, r)};
+    std::vector<double> values(n);
+
+    for (std::size_t j = 0; j < variances.size(); ++j) {
+        double v = variances[j];
+        for (std::size_t i = 0; i < nx; ++i) {
+            double s = spots[i];
+            std::size_t node = i + j * nx;
+            coefficients.xx[node] = 0.5 * s * s * v;
+            coefficients.yy[node] = 0.5 * xi * xi * v;
+            coefficients.xy[node] = rho * xi * s * v;
+            coefficients.x[node] = r * s;
+            coefficients.y[node] = kappa * (theta - v);
+            values[node] = std::max(sign * (s - K), 0.0);
+        }
+    }
+
+    numerics::AdiSolver2D solver(spots, variances, std::move(coefficients),
+                                 settings_.scheme, settings_.numThreads);
+    std::vector<double> payoff = values;
+    solver.solve(values, T, settings_.timeSteps, option.isAmerican() ? &payoff : nullptr);
+
+    numerics::InterpolationStencil inSpot = numerics::interpolationStencil(spots, S);
+    numerics::InterpolationStencil inVariance = numerics::interpolationStencil(variances, v0);
+    double price = 0.0;
+    for (std::size_t l = 0; l < 3; ++l) {
+        for (std::size_t k = 0; k < 3; ++k) {
+            std::size_t node = (inSpot.first + k) + (inVariance.first + l) * nx;
+            price += inVariance.weights[l] * inSpot.weights[k] * values[node];
+        }
+    }
+
+    result.price = price;
+    return result;
+}
+
+} // namespace models
+} // namespace pricing
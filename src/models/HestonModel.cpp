@@ -0,0 +1,83 @@
+#include <algorithm>
+#include <cmath>
+#include <complex>
+
+#include "../../include/pricing/models/HestonModel.hpp"
+
+namespace pricing {
+namespace models {
+
+namespace {
+    const double kPi = 3.14159265358979323846;
+    const double kIntegrationLimit = 200.0;
+    const int kIntegrationIntervals = 2000;
+}
+
+HestonModel::HestonModel(const core::HestonParameters& parameters)
+    : parameters_(parameters) {
+}
+
+core::PricingResult HestonModel::price(
+    const core::Option& option,
+    const core::MarketData& marketData) const {
+    requireEuropean(option, "Heston");
+
+    double S = marketData.getSpot();
+    double K = option.getStrike();
+    double r = marketData.getRiskFreeRate();
+    double T = option.getTimeToExpiration();
+
+    core::PricingResult result;
+    if (T == 0.0) {
+        result.price = option.isCall() ? std::max(S - K, 0.0) : std::max(K - S, 0.0);
+        return result;
+    }
+
+    double logSpot = std::log(S);
+    double logStrike = std::log(K);
+    double discountFactor = std::exp(-r * T);
+    double call = S * probability(1, logSpot, logStrike, r, T)
+        - K * discountFactor * probability(2, logSpot, logStrike, r, T);
+    call = std::max(call, std::max(S - K * discountFactor, 0.0));
+
+    result.price = option.isCall() ? call : call - S + K * discountFactor;
+    return result;
+}
+
+double HestonModel::probability(int index, double logSpot, double logStrike, double r, double T) const {
+    using Complex = std::complex<double>;
+    const Complex i(0.0, 1.0);
+
+    double kappa = parameters_.getMeanReversion();
+    double theta = parameters_.getLongTermVariance();
+    double xi = parameters_.getVolOfVol();
+    double rho = parameters_.getCorrelation();
+    double v0 = parameters_.getInitialVariance();
+
+    double u = index == 1 ? 0.5 : -0.5;
+    double b = index == 1 ? kappa - rho * xi : kappa;
+
+    auto integrand = [&](double phi) {
+        Complex rhoXiPhi = rho * xi * phi * i;
+        Complex d = std::sqrt((rhoXiPhi - b) * (rhoXiPhi - b) - xi * xi * (2.0 * u * phi * i - phi * phi));
+        Complex g = (b - rhoXiPhi - d) / (b - rhoXiPhi + d);
+        Complex decay = std::exp(-d * T);
+        Complex C = r * phi * i * T
+            + kappa * theta / (xi * xi) * ((b - rhoXiPhi - d) * T - 2.0 * std::log((1.0 - g * decay) / (1.0 - g)));
+        Complex D = (b - rhoXiPhi - d) / (xi * xi) * (1.0 - decay) / (1.0 - g * decay);
+        Complex f = std::exp(C + D * v0 + i * phi * logSpot);
+        return std::real(std::exp(-i * phi * logStrike) * f / (i * phi));
+    };
+
+    // Composite Simpson rule; the integrand is finite at phi -> 0
+    double h = kIntegrationLimit / kIntegrationIntervals;
+    double lower = 1e-8;
+    double sum = integrand(lower) + integrand(kIntegrationLimit);
+    for (int k = 1; k < kIntegrationIntervals; ++k) {
+        sum += (k % 2 == 1 ? 4.0 : 2.0) * integrand(k * h);
+    }
+    return 0.5 + sum * h / (3.0 * kPi);
+}
+
+} // namespace models
+} // namespace pricing
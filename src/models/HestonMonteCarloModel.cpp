@@ -0,0 +1,218 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+#include "../../include/pricing/models/HestonMonteCarloModel.hpp"
+#include "../../include/pricing/util/Parallel.hpp"
+#include "../../include/pricing/util/Random.hpp"
+
+namespace pricing {
+namespace models {
+
+namespace {
+    // Switching level of the QE scheme between the quadratic and exponential branches
+    const double kCriticalPsi = 1.5;
+
+    struct StepInputs {
+        std::size_t paths;
+        double dt;
+        double rate;
+        const double* varianceShock;
+        const double* spotShock;
+        double* variance;
+        double* logSpot;
+    };
+
+    void advanceQuadraticExponential(const StepInputs& in, const core::HestonParameters& p) {
+        double kappa = p.getMeanReversion();
+        double theta = p.getLongTermVariance();
+        double xi = p.getVolOfVol();
+        double rho = p.getCorrelation();
+
+        double decay = std::exp(-kappa * in.dt);
+        double c1 = xi * xi * decay * (1.0 - decay) / kappa;
+        double c2 = theta * xi * xi * (1.0 - decay) * (1.0 - decay) / (2.0 * kappa);
+
+        // Log-spot discretization with trapezoidal (gamma1 = gamma2 = 1/2) variance integral
+        double k0 = -rho * kappa * theta * in.dt / xi;
+        double k1 = 0.5 * in.dt * (kappa * rho / xi - 0.5) - rho / xi;
+        double k2 = 0.5 * in.dt * (kappa * rho / xi - 0.5) + rho / xi;
+        double k3 = 0.5 * in.dt * (1.0 - rho * rho);
+        double drift = in.rate * in.dt + k0;
+
+        for (std::size_t i = 0; i < in.paths; ++i) {
+            double v = in.variance[i];
+            double mean = theta + (v - theta) * decay;
+            double psi = (v * c1 + c2) / (mean * mean);
+
+            double next;
+            if (mean <= 0.0) {
+                next = 0.0;
+            } else if (psi <= kCriticalPsi) {
+                double twoOverPsi = 2.0 / psi;
+                double b2 = twoOverPsi - 1.0 + std::sqrt(twoOverPsi) * std::sqrt(twoOverPsi - 1.0);
+                double a = mean / (1.0 + b2);
+                double root = std::sqrt(b2) + in.varianceShock[i];
+                next = a * root * root;
+            } else {
+                double p0 = (psi - 1.0) / (psi + 1.0);
+                double beta = (1.0 - p0) / mean;
+                double u = 0.5 * std::erfc(-in.varianceShock[i] / std::sqrt(2.0));
+                next = u <= p0 ? 0.0 : std::log((1.0 - p0) / (1.0 - u)) / beta;
+            }
+
+            in.logSpot[i] += drift + k1 * v + k2 * next + std::sqrt(k3 * (v + next)) * in.spotShock[i];
+            in.variance[i] = next;
+        }
+    }
+
+    void advanceEulerFullTruncation(const StepInputs& in, const core::HestonParameters& p) {
+        double kappa = p.getMeanReversion();
+        double theta = p.getLongTermVariance();
+        double xi = p.getVolOfVol();
+        double rho = p.getCorrelation();
+        double orthogonal = std::sqrt(1.0 - rho * rho);
+        double sqrtDt = std::sqrt(in.dt);
+
+        for (std::size_t i = 0; i < in.paths; ++i) {
+            double v = std::max(in.variance[i], 0.0);
+            double volDt = std::sqrt(v) * sqrtDt;
+            double spotShock = rho * in.varianceShock[i] + orthogonal * in.spotShock[i];
+            in.logSpot[i] += (in.rate - 0.5 * v) * in.dt + volDt * spotShock;
+            in.variance[i] += kappa * (theta - v) * in.dt + xi * volDt * in.varianceShock[i];
+        }
+    }
+}
+
+HestonMonteCarloModel::HestonMonteCarloModel(const core::HestonParameters& parameters,
+                                             const HestonMonteCarloSettings& settings)
+    : parameters_(parameters), settings_(settings) {
+    validate();
+}
+
+void HestonMonteCarloModel::validate() const {
+    if (settings_.numPaths < 2) {
+        throw std::invalid_argument("Monte Carlo requires at least two paths");
+    }
+    if (settings_.numSteps == 0) {
+        throw std::invalid_argument("Monte Carlo requires at least one time step");
+    }
+    if (settings_.blockSize == 0) {
+        throw std::invalid_argument("Monte Carlo block size must be positive");
+    }
+}
+
+core::PricingResult HestonMonteCarloModel::price(
+    const core::Option& option,
+    const core::MarketData& marketData) const {
+    requireEuropean(option, "Heston Monte Carlo");
+
+    double K = option.getStrike();
+    double sign = option.isCall() ? 1.0 : -1.0;
+
+    return pricePayoff([K, sign](const PathBlock& block, std::vector<double>& payoffs) {
+        const double* expiry = block.step(block.numSteps);
+        for (std::size_t i = 0; i < block.numPaths; ++i) {
+            payoffs[i] = std::max(sign * (expiry[i] - K), 0.0);
+        }
+    }, marketData, option.getTimeToExpiration());
+}
+
+core::PricingResult HestonMonteCarloModel::pricePayoff(
+    const PathPayoff& payoff,
+    const core::MarketData& marketData,
+    double maturity) const {
+
+    if (maturity < 0.0) {
+        throw std::invalid_argument("Time to expiration cannot be negative");
+    }
+
+    double S = marketData.getSpot();
+    double r = marketData.getRiskFreeRate();
+    std::size_t numBlocks = (settings_.numPaths + settings_.blockSize - 1) / settings_.blockSize;
+
+    struct BlockSums {
+        double sum = 0.0;
+        double sumSquares = 0.0;
+    };
+    std::vector<BlockSums> blocks(numBlocks);
+
+    util::parallelFor(numBlocks, settings_.numThreads, [&](std::size_t b) {
+        PathBlock paths;
+        paths.timeStep = maturity / static_cast<double>(settings_.numSteps);
+        simulateBlock(b, S, r, paths);
+
+        std::vector<double> payoffs(paths.numPaths, 0.0);
+        payoff(paths, payoffs);
+
+        BlockSums sums;
+        for (double value : payoffs) {
+            sums.sum += value;
+            sums.sumSquares += value * value;
+        }
+        blocks[b] = sums;
+    });
+
+    double sum = 0.0;
+    double sumSquares = 0.0;
+    for (const auto& block : blocks) {
+        sum += block.sum;
+        sumSquares += block.sumSquares;
+    }
+
+    double n = static_cast<double>(settings_.numPaths);
+    double mean = sum / n;
+    double variance = std::max((sumSquares - n * mean * mean) / (n - 1.0), 0.0);
+    double discountFactor = std::exp(-r * maturity);
+
+    core::PricingResult result;
+    result.price = discountFactor * mean;
+    result.standardError = discountFactor * std::sqrt(variance / n);
+    return result;
+}
+
+void HestonMonteCarloModel::simulateBlock(std::size_t block, double spot, double rate, PathBlock& paths) const {
+    std::size_t first = block * settings_.blockSize;
+    std::size_t n = std::min(settings_.blockSize, settings_.numPaths - first);
+    std::size_t steps = settings_.numSteps;
+
+    paths.numPaths = n;
+    paths.numSteps = steps;
+    paths.spots.assign(n * (steps + 1), spot);
+    if (paths.timeStep == 0.0) {
+        return;
+    }
+
+    std::mt19937_64 rng(util::streamSeed(settings_.seed, block));
+    std::normal_distribution<double> normal;
+
+    std::vector<double> logSpot(n, std::log(spot));
+    std::vector<double> variance(n, parameters_.getInitialVariance());
+    std::vector<double> varianceShock(n);
+    std::vector<double> spotShock(n);
+
+    StepInputs inputs{n, paths.timeStep, rate, varianceShock.data(), spotShock.data(),
+                      variance.data(), logSpot.data()};
+
+    for (std::size_t step = 1; step <= steps; ++step) {
+        for (std::size_t i = 0; i < n; ++i) {
+            varianceShock[i] = normal(rng);
+            spotShock[i] = normal(rng);
+        }
+
+        if (settings_.scheme == HestonScheme::QuadraticExponential) {
+            advanceQuadraticExponential(inputs, parameters_);
+        } else {
+            advanceEulerFullTruncation(inputs, parameters_);
+        }
+
+        double* spots = paths.step(step);
+        for (std::size_t i = 0; i < n; ++i) {
+            spots[i] = std::exp(logSpot[i]);
+        }
+    }
+}
+
+} // namespace models
+} // namespace pricing
@@ -0,0 +1,43 @@
+#include <algorithm>
+#include <stdexcept>
+
+#include "../../include/pricing/models/BinomialTreeModel.hpp"
+#include "../../include/pricing/models/BlackScholesModel.hpp"
+#include "../../include/pricing/models/FiniteDifferenceModel.hpp"
+#include "../../include/pricing/models/ModelFactory.hpp"
+#include "../../include/pricing/models/MonteCarloModel.hpp"
+
+namespace pricing {
+namespace models {
+
+const std::vector<std::string>& modelNames() {
+    static const std::vector<std::string> names = {
+        "black_scholes", "monte_carlo", "binomial", "finite_difference"};
+    return names;
+}
+
+bool isModelName(const std::string& name) {
+    const auto& names = modelNames();
+    return std::find(names.begin(), names.end(), name) != names.end();
+}
+
+std::unique_ptr<PricingModel> createModel(const std::string& name, unsigned numThreads) {
+    if (name == "black_scholes") {
+        return std::unique_ptr<PricingModel>(new BlackScholesModel());
+    }
+    if (name == "monte_carlo") {
+        MonteCarloSettings settings;
+        settings.numThreads = numThreads;
+        return std::unique_ptr<PricingModel>(new MonteCarloModel(settings));
+    }
+    if (name == "binomial") {
+        return std::unique_ptr<PricingModel>(new BinomialTreeModel());
+    }
+    if (name == "finite_difference") {
+        return std::unique_ptr<PricingModel>(new FiniteDifferenceModel());
+    }
+    throw std::invalid_argument("Unknown model: " + name);
+}
+
+} // namespace models
+} // namespace pricing
@@ -0,0 +1,469 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+#include "../../include/pricing/models/MonteCarloModel.hpp"
+#include "../../include/pricing/util/Parallel.hpp"
+#include "../../include/pricing/util/Random.hpp"
+
+namespace pricing {
+namespace models {
+
+namespace {
+    // Broadie-Glasserman-Kou constant: -zeta(1/2) / sqrt(2 * pi)
+    const double kBgkBeta = 0.5825971579390106;
+}
+
+MonteCarloModel::MonteCarloModel(const MonteCarloSettings& settings)
+    : settings_(settings) {
+    validate();
+}
+
+void MonteCarloModel::validate() const {
+    if (settings_.numPaths < 2) {
+        throw std::invalid_argument("Monte Carlo requires at least two paths");
+    }
+    if (settings_.numSteps == 0) {
+        throw std::invalid_argument("Monte Carlo requires at least one time step");
+    }
+    if (settings_.blockSize == 0) {
+        throw std::invalid_argument("Monte Carlo block size must be positive");
+    }
+}
+
+core::PricingResult MonteCarloModel::price(
+    const core::Option& option,
+    const core::MarketData& marketData) const {
+    requireEuropean(option, "Monte Carlo");
+
+    double S = marketData.getSpot();
+    double K = option.getStrike();
+    double r = marketData.getRiskFreeRate();
+    double sigma = marketData.getVolatility();
+    double T = option.getTimeToExpiration();
+
+    if (T == 0.0) {
+        core::PricingResult result;
+        result.price = intrinsicValue(option, S);
+        return result;
+    }
+
+    double logMean = std::log(S) + (r - 0.5 * sigma * sigma) * T;
+    double volSqrtT = sigma * std::sqrt(T);
+    double sign = option.isCall() ? 1.0 : -1.0;
+    double shift = settings_.importanceSampling ? importanceShift(option, logMean, volSqrtT) : 0.0;
+
+    std::vector<BlockSums> blocks(blockCount());
+    util::parallelFor(blocks.size(), settings_.numThreads, [&](std::size_t b) {
+        std::vector<double> shocks;
+        std::vector<double> weights;
+        sampleTerminalShocks(b, shift, shocks, weights);
+
+        BlockSums sums;
+        for (std::size_t i = 0; i < shocks.size(); ++i) {
+            double spotAtExpiry = std::exp(logMean + volSqrtT * shocks[i]);
+            double value = weights[i] * std::max(sign * (spotAtExpiry - K), 0.0);
+            sums.sum += value;
+            sums.sumSquares += value * value;
+        }
+        blocks[b] = sums;
+    });
+
+    return aggregate(blocks, std::exp(-r * T), settings_.stratified);
+}
+
+core::PricingResult MonteCarloModel::priceWithGreeks(
+    const core::Option& option,
+    const core::MarketData& marketData) const {
+    requireEuropean(option, "Monte Carlo");
+
+    double S = marketData.getSpot();
+    double K = option.getStrike();
+    double r = marketData.getRiskFreeRate();
+    double sigma = marketData.getVolatility();
+    double T = option.getTimeToExpiration();
+
+    if (T == 0.0) {
+        core::PricingResult result;
+        result.price = intrinsicValue(option, S);
+        if (option.isCall()) {
+            result.delta = (S > K) ? 1.0 : 0.0;
+        } else {
+            result.delta = (S < K) ? -1.0 : 0.0;
+        }
+        return result;
+    }
+
+    if (sigma == 0.0) {
+        // Every path ends at the forward: the pathwise gamma and vega
+        // estimators degenerate, so follow the closed form as BlackScholesModel does
+        core::PricingResult result;
+        double discountFactor = std::exp(-r * T);
+        if (option.isCall()) {
+            result.price = std::max(S - K * discountFactor, 0.0);
+            result.delta = (S > K * discountFactor) ? 1.0 : 0.0;
+        } else {
+            result.price = std::max(K * discountFactor - S, 0.0);
+            result.delta = (S < K * discountFactor) ? -1.0 : 0.0;
+        }
+        return result;
+    }
+
+    double sqrtT = std::sqrt(T);
+    double logMean = std::log(S) + (r - 0.5 * sigma * sigma) * T;
+    double volSqrtT = sigma * sqrtT;
+    double gammaScale = 1.0 / volSqrtT;
+    double sign = option.isCall() ? 1.0 : -1.0;
+    double shift = settings_.importanceSampling ? importanceShift(option, logMean, volSqrtT) : 0.0;
+
+    std::vector<GreekSums> blocks(blockCount());
+    util::parallelFor(blocks.size(), settings_.numThreads, [&](std::size_t b) {
+        std::vector<double> shocks;
+        std::vector<double> weights;
+        sampleTerminalShocks(b, shift, shocks, weights);
+
+        GreekSums sums;
+        for (std::size_t i = 0; i < shocks.size(); ++i) {
+            double z = shocks[i];
+            double spotAtExpiry = std::exp(logMean + volSqrtT * z);
+            double payoff = weights[i] * std::max(sign * (spotAtExpiry - K), 0.0);
+            // dPayoff/dS_T times S_T; every sensitivity of S_T is proportional to S_T
+            double slope = payoff > 0.0 ? weights[i] * sign * spotAtExpiry : 0.0;
+
+            sums.price.sum += payoff;
+            sums.price.sumSquares += payoff * payoff;
+            sums.delta += slope;
+            sums.gamma += slope * (z * gammaScale - 1.0);
+            sums.vega += slope * (sqrtT * z - sigma * T);
+        }
+        blocks[b] = sums;
+    });
+
+    double discountFactor = std::exp(-r * T);
+    std::vector<BlockSums> priceSums;
+    priceSums.reserve(blocks.size());
+    GreekSums total;
+    for (const auto& block : blocks) {
+        priceSums.push_back(block.price);
+        total.delta += block.delta;
+        total.gamma += block.gamma;
+        total.vega += block.vega;
+    }
+
+    core::PricingResult result = aggregate(priceSums, discountFactor, settings_.stratified);
+    double scale = discountFactor / static_cast<double>(settings_.numPaths);
+    result.delta = scale * total.delta / S;
+    result.gamma = scale * total.gamma / (S * S);
+    result.vega = scale * total.vega;
+    // dS_T/dr = T * S_T, so the pathwise rho estimator reuses the delta sum
+    result.rho = T * (S * result.delta - result.price);
+    result.theta = r * result.price - r * S * result.delta
+        - 0.5 * sigma * sigma * S * S * result.gamma;
+    return result;
+}
+
+core::PricingResult MonteCarloModel::priceBarrier(
+    const core::Option& option,
+    const core::Barrier& barrier,
+    const core::MarketData& marketData) const {
+    requireEuropean(option, "Monte Carlo");
+
+    double S = marketData.getSpot();
+    double K = option.getStrike();
+    double r = marketData.getRiskFreeRate();
+    double sigma = marketData.getVolatility();
+    double T = option.getTimeToExpiration();
+    double B = barrier.getLevel();
+    bool isUp = barrier.isUp();
+
+    if (T == 0.0) {
+        bool breached = isUp ? S >= B : S <= B;
+        core::PricingResult result;
+        result.price = (breached != barrier.isKnockOut()) ? intrinsicValue(option, S) : 0.0;
+        return result;
+    }
+
+    std::size_t steps = settings_.numSteps;
+    double dt = T / static_cast<double>(steps);
+    bool useBridge = settings_.brownianBridge && sigma > 0.0;
+    std::size_t monitorStride = 1;
+
+    if (!barrier.isContinuous()) {
+        std::size_t dates = barrier.getMonitoringDates();
+        if (steps % dates == 0) {
+            // Monitoring dates lie on the simulation grid: check them exactly
+            monitorStride = steps / dates;
+            useBridge = false;
+        } else if (useBridge) {
+            // Discrete barrier ~ continuous barrier moved away from the spot
+            double shift = kBgkBeta * sigma * std::sqrt(T / static_cast<double>(dates));
+            B *= std::exp(isUp ? shift : -shift);
+        }
+    }
+
+    // Signed log-distance to the barrier is positive while the path is alive
+    double direction = isUp ? 1.0 : -1.0;
+    double logBarrier = std::log(B);
+    double stepDrift = (r - 0.5 * sigma * sigma) * dt;
+    double stepVol = sigma * std::sqrt(dt);
+    double bridgeScale = useBridge ? -2.0 / (sigma * sigma * dt) : 0.0;
+    bool isCall = option.isCall();
+    bool knockOut = barrier.isKnockOut();
+
+    std::vector<BlockSums> blocks(blockCount());
+    util::parallelFor(blocks.size(), settings_.numThreads, [&](std::size_t b) {
+        std::mt19937_64 rng(util::streamSeed(settings_.seed, b));
+        std::normal_distribution<double> normal;
+
+        std::size_t paths = blockPaths(b);
+        std::vector<double> logSpot(paths, std::log(S));
+        std::vector<double> survival(paths, direction * (logBarrier - std::log(S)) > 0.0 ? 1.0 : 0.0);
+        std::vector<double> shocks(paths);
+
+        for (std::size_t step = 1; step <= steps; ++step) {
+            for (std::size_t i = 0; i < paths; ++i) {
+                shocks[i] = normal(rng);
+            }
+            bool monitored = (step % monitorStride) == 0;
+            for (std::size_t i = 0; i < paths; ++i) {
+                double before = direction * (logBarrier - logSpot[i]);
+                logSpot[i] += stepDrift + stepVol * shocks[i];
+                double after = direction * (logBarrier - logSpot[i]);
+
+                if (useBridge) {
+                    double pass = (before > 0.0 && after > 0.0)
+                        ? 1.0 - std::exp(bridgeScale * before * after) : 0.0;
+                    survival[i] *= pass;
+                } else if (monitored && after <= 0.0) {
+                    survival[i] = 0.0;
+                }
+            }
+        }
+
+        BlockSums sums;
+        for (std::size_t i = 0; i < paths; ++i) {
+            double spotAtExpiry = std::exp(logSpot[i]);
+            double payoff = isCall ? std::max(spotAtExpiry - K, 0.0) : std::max(K - spotAtExpiry, 0.0);
+            double weight = knockOut ? survival[i] : 1.0 - survival[i];
+            double value = weight * payoff;
+            sums.sum += value;
+            sums.sumSquares += value * value;
+        }
+        blocks[b] = sums;
+    });
+
+    return aggregate(blocks, std::exp(-r * T), false);
+}
+
+core::PricingResult MonteCarloModel::pricePayoff(
+    const PathPayoff& payoff,
+    const core::MarketData& marketData,
+    double maturity) const {
+
+    if (maturity < 0.0) {
+        throw std::invalid_argument("Time to expiration cannot be negative");
+    }
+
+    double S = marketData.getSpot();
+    double r = marketData.getRiskFreeRate();
+    double sigma = marketData.getVolatility();
+    std::size_t steps = settings_.numSteps;
+    double dt = maturity / static_cast<double>(steps);
+    double stepGrowth = std::exp((r - 0.5 * sigma * sigma) * dt);
+    double stepVol = sigma * std::sqrt(dt);
+
+    std::vector<BlockSums> blocks(blockCount());
+    util::parallelFor(blocks.size(), settings_.numThreads, [&](std::size_t b) {
+        std::mt19937_64 rng(util::streamSeed(settings_.seed, b));
+        std::normal_distribution<double> normal;
+
+        PathBlock paths;
+        paths.numPaths = blockPaths(b);
+        paths.numSteps = steps;
+        paths.timeStep = dt;
+        paths.spots.resize(paths.numPaths * (steps + 1));
+        std::fill(paths.step(0), paths.step(0) + paths.numPaths, S);
+
+        for (std::size_t step = 1; step <= steps; ++step) {
+            const double* previous = paths.step(step - 1);
+            double* current = paths.step(step);
+            for (std::size_t i = 0; i < paths.numPaths; ++i) {
+                current[i] = normal(rng);
+            }
+            for (std::size_t i = 0; i < paths.numPaths; ++i) {
+                current[i] = previous[i] * stepGrowth * std::exp(stepVol * current[i]);
+            }
+        }
+
+        std::vector<double> payoffs(paths.numPaths, 0.0);
+        payoff(paths, payoffs);
+
+        BlockSums sums;
+        for (double value : payoffs) {
+            sums.sum += value;
+            sums.sumSquares += value * value;
+        }
+        blocks[b] = sums;
+    });
+
+    return aggregate(blocks, std::exp(-r * maturity), false);
+}
+
+void MonteCarloModel::sampleTerminalShocks(
+    std::size_t block, double shift,
+    std::vector<double>& shocks, std::vector<double>& weights) const {
+
+    std::mt19937_64 rng(util::streamSeed(settings_.seed, block));
+    std::size_t paths = blockPaths(block);
+    shocks.resize(paths);
+    weights.assign(paths, 1.0);
+
+    if (settings_.stratified) {
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        double width = 1.0 / static_cast<double>(paths);
+        for (std::size_t i = 0; i < paths; ++i) {
+            shocks[i] = inverseNormalCDF((static_cast<double>(i) + uniform(rng)) * width);
+        }
+    } else {
+        std::normal_distribution<double> normal;
+        for (std::size_t i = 0; i < paths; ++i) {
+            shocks[i] = normal(rng);
+        }
+    }
+
+    if (shift != 0.0) {
+        // Sample N(shift, 1) and reweight by the likelihood ratio to N(0, 1)
+        double halfShiftSquared = 0.5 * shift * shift;
+        for (std::size_t i = 0; i < paths; ++i) {
+            shocks[i] += shift;
+            weights[i] = std::exp(halfShiftSquared - shift * shocks[i]);
+        }
+    }
+}
+
+double MonteCarloModel::importanceShift(const core::Option& option, double logMean, double volSqrtT) {
+    if (volSqrtT <= 0.0) {
+        return 0.0;
+    }
+
+    // The shift is the mode of payoff(z) * density(z), i.e. the root of
+    // d/dz [log payoff(z) - z^2 / 2] on the in-the-money side of the strike.
+    double K = option.getStrike();
+    double sign = option.isCall() ? 1.0 : -1.0;
+    auto outwardSlope = [&](double z) {
+        double spot = std::exp(logMean + volSqrtT * z);
+        double payoff = sign * (spot - K);
+        if (payoff <= 0.0) {
+            return std::numeric_limits<double>::infinity();
+        }
+        return volSqrtT * spot / payoff - sign * z;
+    };
+
+    double inner = (std::log(K) - logMean) / volSqrtT;
+    double step = 1.0;
+    double outer = inner + sign * step;
+    while (outwardSlope(outer) > 0.0) {
+        inner = outer;
+        step *= 2.0;
+        outer = inner + sign * step;
+    }
+    for (int iteration = 0; iteration < 100; ++iteration) {
+        double middle = 0.5 * (inner + outer);
+        if (outwardSlope(middle) > 0.0) {
+            inner = middle;
+        } else {
+            outer = middle;
+        }
+    }
+    return 0.5 * (inner + outer);
+}
+
+double MonteCarloModel::inverseNormalCDF(double p) {
+    // Acklam's rational approximation refined by one Halley step
+    static const double a[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                               1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+    static const double b[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                               6.680131188771972e+01, -1.328068155288572e+01};
+    static const double c[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                               -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+    static const double d[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                               3.754408661907416e+00};
+    const double lowTail = 0.02425;
+
+    p = std::min(std::max(p, std::numeric_limits<double>::min()), 1.0 - 1e-16);
+
+    double x;
+    if (p < lowTail) {
+        double q = std::sqrt(-2.0 * std::log(p));
+        x = (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+            ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+    } else if (p <= 1.0 - lowTail) {
+        double q = p - 0.5;
+        double t = q * q;
+        x = (((((a[0] * t + a[1]) * t + a[2]) * t + a[3]) * t + a[4]) * t + a[5]) * q /
+            (((((b[0] * t + b[1]) * t + b[2]) * t + b[3]) * t + b[4]) * t + 1.0);
+    } else {
+        double q = std::sqrt(-2.0 * std::log(1.0 - p));
+        x = -(((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+            ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+    }
+
+    const double sqrt2Pi = 2.5066282746310002;
+    double error = 0.5 * std::erfc(-x / std::sqrt(2.0)) - p;
+    double u = error * sqrt2Pi * std::exp(0.5 * x * x);
+    return x - u / (1.0 + 0.5 * x * u);
+}
+
+std::size_t MonteCarloModel::blockCount() const {
+    return (settings_.numPaths + settings_.blockSize - 1) / settings_.blockSize;
+}
+
+std::size_t MonteCarloModel::blockPaths(std::size_t block) const {
+    std::size_t first = block * settings_.blockSize;
+    return std::min(settings_.blockSize, settings_.numPaths - first);
+}
+
+core::PricingResult MonteCarloModel::aggregate(
+    const std::vector<BlockSums>& blocks, double discountFactor, bool fromBlockMeans) const {
+
+    // Reduce in block order so results are reproducible for any thread count
+    double sum = 0.0;
+    double sumSquares = 0.0;
+    for (const auto& block : blocks) {
+        sum += block.sum;
+        sumSquares += block.sumSquares;
+    }
+
+    double n = static_cast<double>(settings_.numPaths);
+    double mean = sum / n;
+    double variance = std::max((sumSquares - n * mean * mean) / (n - 1.0), 0.0);
+
+    double varianceOfMean = variance / n;
+
+    if (fromBlockMeans && blocks.size() > 1) {
+        // Paths inside a stratified block are dependent; blocks are i.i.d. replicates
+        double spread = 0.0;
+        for (std::size_t b = 0; b < blocks.size(); ++b) {
+            double paths = static_cast<double>(blockPaths(b));
+            double deviation = blocks[b].sum / paths - mean;
+            spread += paths * paths * deviation * deviation;
+        }
+        double replicates = static_cast<double>(blocks.size());
+        varianceOfMean = spread / (n * n) * replicates / (replicates - 1.0);
+    }
+
+    core::PricingResult result;
+    result.price = discountFactor * mean;
+    result.standardError = discountFactor * std::sqrt(varianceOfMean);
+    return result;
+}
+
+double MonteCarloModel::intrinsicValue(const core::Option& option, double spot) {
+    double K = option.getStrike();
+    return option.isCall() ? std::max(spot - K, 0.0) : std::max(K - spot, 0.0);
+}
+
+} // namespace models
+} // namespace pricing
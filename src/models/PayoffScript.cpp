@@ -0,0 +1,491 @@
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+#include "../../include/pricing/models/PayoffScript.hpp"
+
+namespace pricing {
+namespace models {
+
+namespace {
+    using OpCode = PayoffScript::OpCode;
+
+    struct Observation {
+        const char* name;
+        OpCode op;
+    };
+
+    const Observation observations[] = {
+        {"spot", OpCode::Spot},
+        {"initial", OpCode::Initial},
+        {"average", OpCode::Average},
+        {"maximum", OpCode::Maximum},
+        {"minimum", OpCode::Minimum},
+    };
+
+    struct Function {
+        const char* name;
+        OpCode op;
+        int arity;   // -1 = two or more, folded pairwise
+    };
+
+    const Function functions[] = {
+        {"max", OpCode::Max, -1},
+        {"min", OpCode::Min, -1},
+        {"abs", OpCode::Abs, 1},
+        {"exp", OpCode::Exp, 1},
+        {"log", OpCode::Log, 1},
+        {"sqrt", OpCode::Sqrt, 1},
+        {"if", OpCode::Select, 3},
+        {"at", OpCode::At, 1},
+    };
+
+    int operandCount(OpCode op) {
+        switch (op) {
+            case OpCode::Constant: case OpCode::Spot: case OpCode::Initial: case OpCode::Average:
+            case OpCode::Maximum: case OpCode::Minimum: case OpCode::At:
+                return 0;
+            case OpCode::Negate: case OpCode::Not: case OpCode::Abs: case OpCode::Exp:
+            case OpCode::Log: case OpCode::Sqrt:
+                return 1;
+            case OpCode::Select:
+                return 3;
+            default:
+                return 2;
+        }
+    }
+
+    // Scalar semantics of every operation, used for constant folding
+    double applyScalar(OpCode op, const double* args) {
+        double a = args[0], b = args[1];
+        switch (op) {
+            case OpCode::Add: return a + b;
+            case OpCode::Subtract: return a - b;
+            case OpCode::Multiply: return a * b;
+            case OpCode::Divide: return a / b;
+            case OpCode::Negate: return -a;
+            case OpCode::Not: return a == 0.0 ? 1.0 : 0.0;
+            case OpCode::Less: return a < b ? 1.0 : 0.0;
+            case OpCode::LessEqual: return a <= b ? 1.0 : 0.0;
+            case OpCode::Greater: return a > b ? 1.0 : 0.0;
+            case OpCode::GreaterEqual: return a >= b ? 1.0 : 0.0;
+            case OpCode::Equal: return a == b ? 1.0 : 0.0;
+            case OpCode::NotEqual: return a != b ? 1.0 : 0.0;
+            case OpCode::And: return (a != 0.0 && b != 0.0) ? 1.0 : 0.0;
+            case OpCode::Or: return (a != 0.0 || b != 0.0) ? 1.0 : 0.0;
+            case OpCode::Max: return std::max(a, b);
+            case OpCode::Min: return std::min(a, b);
+            case OpCode::Abs: return std::abs(a);
+            case OpCode::Exp: return std::exp(a);
+            case OpCode::Log: return std::log(a);
+            case OpCode::Sqrt: return std::sqrt(a);
+            case OpCode::Select: return a != 0.0 ? b : args[2];
+            default: throw std::logic_error("Operation cannot be folded");
+        }
+    }
+
+    template <typename Fn>
+    void unaryLoop(double* a, std::size_t n, Fn fn) {
+        for (std::size_t i = 0; i < n; ++i) {
+            a[i] = fn(a[i]);
+        }
+    }
+
+    template <typename Fn>
+    void binaryLoop(double* a, const double* b, std::size_t n, Fn fn) {
+        for (std::size_t i = 0; i < n; ++i) {
+            a[i] = fn(a[i], b[i]);
+        }
+    }
+}
+
+// Recursive-descent compiler from source text to bytecode. Grammar, lowest
+// precedence first: || , && , comparison , + - , * / , unary - ! , primary.
+class PayoffScript::Compiler {
+public:
+    Compiler(PayoffScript& script, const std::map<std::string, double>& parameters)
+        : script_(script), text_(script.source_), parameters_(parameters) {}
+
+    void compile() {
+        for (const auto& parameter : parameters_) {
+            if (isReserved(parameter.first)) {
+                throw std::invalid_argument("Payoff parameter name is reserved: " + parameter.first);
+            }
+        }
+        parseOr();
+        skipSpaces();
+        if (position_ != text_.size()) {
+            fail("unexpected input");
+        }
+    }
+
+private:
+    [[noreturn]] void fail(const std::string& message) const {
+        throw std::invalid_argument("Payoff script error at position " + std::to_string(position_)
+                                    + ": " + message);
+    }
+
+    static bool isReserved(const std::string& name) {
+        for (const auto& observation : observations) {
+            if (name == observation.name) {
+                return true;
+            }
+        }
+        for (const auto& function : functions) {
+            if (name == function.name) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void skipSpaces() {
+        while (position_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[position_]))) {
+            ++position_;
+        }
+    }
+
+    bool accept(const char* token) {
+        skipSpaces();
+        std::size_t length = std::strlen(token);
+        if (text_.compare(position_, length, token) != 0) {
+            return false;
+        }
+        // Do not split two-character operators: '<' must not match "<="
+        if (length == 1 && position_ + 1 < text_.size() && text_[position_ + 1] == '='
+            && (token[0] == '<' || token[0] == '>' || token[0] == '!')) {
+            return false;
+        }
+        position_ += length;
+        return true;
+    }
+
+    void expect(const char* token) {
+        if (!accept(token)) {
+            fail(std::string("expected '") + token + "'");
+        }
+    }
+
+    void emit(OpCode op, std::uint32_t operand = 0) {
+        int count = operandCount(op);
+        auto& code = script_.code_;
+        bool foldable = count > 0 && code.size() >= static_cast<std::size_t>(count)
+            && std::all_of(code.end() - count, code.end(),
+                           [](const Instruction& instruction) { return instruction.op == OpCode::Constant; });
+        if (foldable) {
+            double args[3] = {0.0, 0.0, 0.0};
+            for (int k = 0; k < count; ++k) {
+                args[k] = script_.constants_[code[code.size() - count + k].operand];
+            }
+            code.resize(code.size() - count);
+            emitConstant(applyScalar(op, args));
+            return;
+        }
+        code.push_back({op, operand});
+    }
+
+    void emitConstant(double value) {
+        script_.code_.push_back({OpCode::Constant, static_cast<std::uint32_t>(script_.constants_.size())});
+        script_.constants_.push_back(value);
+    }
+
+    void parseOr() {
+        parseAnd();
+        while (accept("||")) {
+            parseAnd();
+            emit(OpCode::Or);
+        }
+    }
+
+    void parseAnd() {
+        parseComparison();
+        while (accept("&&")) {
+            parseComparison();
+            emit(OpCode::And);
+        }
+    }
+
+    void parseComparison() {
+        parseSum();
+        struct Comparison {
+            const char* token;
+            OpCode op;
+        };
+        const Comparison comparisons[] = {
+            {"<=", OpCode::LessEqual}, {">=", OpCode::GreaterEqual}, {"==", OpCode::Equal},
+            {"!=", OpCode::NotEqual}, {"<", OpCode::Less}, {">", OpCode::Greater},
+        };
+        for (const auto& comparison : comparisons) {
+            if (accept(comparison.token)) {
+                parseSum();
+                emit(comparison.op);
+                return;
+            }
+        }
+    }
+
+    void parseSum() {
+        parseProduct();
+        for (;;) {
+            if (accept("+")) {
+                parseProduct();
+                emit(OpCode::Add);
+            } else if (accept("-")) {
+                parseProduct();
+                emit(OpCode::Subtract);
+            } else {
+                return;
+            }
+        }
+    }
+
+    void parseProduct() {
+        parseUnary();
+        for (;;) {
+            if (accept("*")) {
+                parseUnary();
+                emit(OpCode::Multiply);
+            } else if (accept("/")) {
+                parseUnary();
+                emit(OpCode::Divide);
+            } else {
+                return;
+            }
+        }
+    }
+
+    void parseUnary() {
+        if (accept("-")) {
+            parseUnary();
+            emit(OpCode::Negate);
+        } else if (accept("!")) {
+            parseUnary();
+            emit(OpCode::Not);
+        } else if (accept("+")) {
+            parseUnary();
+        } else {
+            parsePrimary();
+        }
+    }
+
+    void parsePrimary() {
+        skipSpaces();
+        if (position_ >= text_.size()) {
+            fail("unexpected end of script");
+        }
+        char next = text_[position_];
+        if (accept("(")) {
+            parseOr();
+            expect(")");
+            return;
+        }
+        if (std::isdigit(static_cast<unsigned char>(next)) || next == '.') {
+            const char* begin = text_.c_str() + position_;
+            char* end = nullptr;
+            double value = std::strtod(begin, &end);
+            if (end == begin) {
+                fail("malformed number");
+            }
+            position_ += static_cast<std::size_t>(end - begin);
+            emitConstant(value);
+            return;
+        }
+        if (std::isalpha(static_cast<unsigned char>(next)) || next == '_') {
+            std::size_t start = position_;
+            while (position_ < text_.size()
+                   && (std::isalnum(static_cast<unsigned char>(text_[position_])) || text_[position_] == '_')) {
+                ++position_;
+            }
+            parseName(text_.substr(start, position_ - start), start);
+            return;
+        }
+        fail(std::string("unexpected character '") + next + "'");
+    }
+
+    void parseName(const std::string& name, std::size_t start) {
+        for (const auto& function : functions) {
+            if (name == function.name) {
+                expect("(");
+                parseCall(function);
+                return;
+            }
+        }
+        for (const auto& observation : observations) {
+            if (name == observation.name) {
+                emit(observation.op);
+                return;
+            }
+        }
+        auto parameter = parameters_.find(name);
+        if (parameter == parameters_.end()) {
+            position_ = start;
+            fail("unknown name '" + name + "'");
+        }
+        emitConstant(parameter->second);
+    }
+
+    void parseCall(const Function& function) {
+        if (function.op == OpCode::At) {
+            // The step index must be a constant so the observation is a row of the block
+            std::size_t codeSize = script_.code_.size();
+            parseOr();
+            expect(")");
+            const Instruction& last = script_.code_.back();
+            if (script_.code_.size() != codeSize + 1 || last.op != OpCode::Constant) {
+                fail("at() needs a constant step");
+            }
+            double step = script_.constants_[last.operand];
+            if (step < 0.0 || step != std::floor(step) || step > 1e9) {
+                fail("at() needs a non-negative integer step");
+            }
+            script_.code_.pop_back();
+            auto index = static_cast<std::uint32_t>(step);
+            script_.maxStep_ = std::max<std::size_t>(script_.maxStep_, index);
+            emit(OpCode::At, index);
+            return;
+        }
+
+        int count = 1;
+        parseOr();
+        while (accept(",")) {
+            parseOr();
+            ++count;
+            if (function.arity < 0) {
+                emit(function.op);
+            }
+        }
+        expect(")");
+        bool valid = function.arity < 0 ? count >= 2 : count == function.arity;
+        if (!valid) {
+            fail(std::string("wrong number of arguments to ") + function.name + "()");
+        }
+        if (function.arity > 0) {
+            emit(function.op);
+        }
+    }
+
+    PayoffScript& script_;
+    const std::string& text_;
+    const std::map<std::string, double>& parameters_;
+    std::size_t position_ = 0;
+};
+
+PayoffScript::PayoffScript(const std::string& source, const std::map<std::string, double>& parameters)
+    : source_(source) {
+    Compiler(*this, parameters).compile();
+
+    std::size_t depth = 0;
+    for (const auto& instruction : code_) {
+        int count = operandCount(instruction.op);
+        depth = depth + 1 - static_cast<std::size_t>(count);
+        stackDepth_ = std::max(stackDepth_, depth);
+    }
+}
+
+void PayoffScript::operator()(const PathBlock& block, std::vector<double>& payoffs) const {
+    std::size_t n = block.numPaths;
+    if (maxStep_ > block.numSteps) {
+        throw std::invalid_argument("Payoff script observes a step beyond the simulated path");
+    }
+    payoffs.resize(n);
+
+    // Path statistics are computed once per block, step-major
+    bool needsAverage = false, needsMaximum = false, needsMinimum = false;
+    for (const auto& instruction : code_) {
+        needsAverage |= instruction.op == OpCode::Average;
+        needsMaximum |= instruction.op == OpCode::Maximum;
+        needsMinimum |= instruction.op == OpCode::Minimum;
+    }
+    std::vector<double> average, maximum, minimum;
+    if (needsAverage) {
+        average.assign(n, 0.0);
+        for (std::size_t step = 1; step <= block.numSteps; ++step) {
+            binaryLoop(average.data(), block.step(step), n, [](double a, double s) { return a + s; });
+        }
+        double scale = 1.0 / static_cast<double>(std::max<std::size_t>(block.numSteps, 1));
+        unaryLoop(average.data(), n, [scale](double a) { return a * scale; });
+    }
+    if (needsMaximum) {
+        maximum.assign(block.step(0), block.step(0) + n);
+        for (std::size_t step = 1; step <= block.numSteps; ++step) {
+            binaryLoop(maximum.data(), block.step(step), n, [](double a, double s) { return s > a ? s : a; });
+        }
+    }
+    if (needsMinimum) {
+        minimum.assign(block.step(0), block.step(0) + n);
+        for (std::size_t step = 1; step <= block.numSteps; ++step) {
+            binaryLoop(minimum.data(), block.step(step), n, [](double a, double s) { return s < a ? s : a; });
+        }
+    }
+
+    std::vector<double> stack(stackDepth_ * n);
+    std::size_t top = 0;
+    auto lane = [&](std::size_t index) { return stack.data() + index * n; };
+    auto load = [&](const double* source) {
+        std::copy(source, source + n, lane(top++));
+    };
+
+    for (const auto& instruction : code_) {
+        switch (instruction.op) {
+            case OpCode::Constant:
+                std::fill(lane(top), lane(top) + n, constants_[instruction.operand]);
+                ++top;
+                break;
+            case OpCode::Spot: load(block.step(block.numSteps)); break;
+            case OpCode::Initial: load(block.step(0)); break;
+            case OpCode::At: load(block.step(instruction.operand)); break;
+            case OpCode::Average: load(average.data()); break;
+            case OpCode::Maximum: load(maximum.data()); break;
+            case OpCode::Minimum: load(minimum.data()); break;
+
+            case OpCode::Negate: unaryLoop(lane(top - 1), n, [](double a) { return -a; }); break;
+            case OpCode::Not: unaryLoop(lane(top - 1), n, [](double a) { return a == 0.0 ? 1.0 : 0.0; }); break;
+            case OpCode::Abs: unaryLoop(lane(top - 1), n, [](double a) { return std::abs(a); }); break;
+            case OpCode::Exp: unaryLoop(lane(top - 1), n, [](double a) { return std::exp(a); }); break;
+            case OpCode::Log: unaryLoop(lane(top - 1), n, [](double a) { return std::log(a); }); break;
+            case OpCode::Sqrt: unaryLoop(lane(top - 1), n, [](double a) { return std::sqrt(a); }); break;
+
+            case OpCode::Select: {
+                double* condition = lane(top - 3);
+                const double* whenTrue = lane(top - 2);
+                const double* whenFalse = lane(top - 1);
+                for (std::size_t i = 0; i < n; ++i) {
+                    condition[i] = condition[i] != 0.0 ? whenTrue[i] : whenFalse[i];
+                }
+                top -= 2;
+                break;
+            }
+
+            default: {
+                double* a = lane(top - 2);
+                const double* b = lane(top - 1);
+                switch (instruction.op) {
+                    case OpCode::Add: binaryLoop(a, b, n, [](double x, double y) { return x + y; }); break;
+                    case OpCode::Subtract: binaryLoop(a, b, n, [](double x, double y) { return x - y; }); break;
+                    case OpCode::Multiply: binaryLoop(a, b, n, [](double x, double y) { return x * y; }); break;
+                    case OpCode::Divide: binaryLoop(a, b, n, [](double x, double y) { return x / y; }); break;
+                    case OpCode::Less: binaryLoop(a, b, n, [](double x, double y) { return x < y ? 1.0 : 0.0; }); break;
+                    case OpCode::LessEqual: binaryLoop(a, b, n, [](double x, double y) { return x <= y ? 1.0 : 0.0; }); break;
+                    case OpCode::Greater: binaryLoop(a, b, n, [](double x, double y) { return x > y ? 1.0 : 0.0; }); break;
+                    case OpCode::GreaterEqual: binaryLoop(a, b, n, [](double x, double y) { return x >= y ? 1.0 : 0.0; }); break;
+                    case OpCode::Equal: binaryLoop(a, b, n, [](double x, double y) { return x == y ? 1.0 : 0.0; }); break;
+                    case OpCode::NotEqual: binaryLoop(a, b, n, [](double x, double y) { return x != y ? 1.0 : 0.0; }); break;
+                    case OpCode::And: binaryLoop(a, b, n, [](double x, double y) { return (x != 0.0 && y != 0.0) ? 1.0 : 0.0; }); break;
+                    case OpCode::Or: binaryLoop(a, b, n, [](double x, double y) { return (x != 0.0 || y != 0.0) ? 1.0 : 0.0; }); break;
+                    case OpCode::Max: binaryLoop(a, b, n, [](double x, double y) { return x > y ? x : y; }); break;
+                    case OpCode::Min: binaryLoop(a, b, n, [](double x, double y) { return x < y ? x : y; }); break;
+                    default: throw std::logic_error("Unknown payoff opcode");
+                }
+                --top;
+                break;
+            }
+        }
+    }
+    std::copy(lane(0), lane(0) + n, payoffs.begin());
+}
+
+} // namespace models
+} // namespace pricing
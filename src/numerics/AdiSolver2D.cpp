@@ -0,0 +1,284 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+#include "../../include/pricing/numerics/AdiSolver2D.hpp"
+#include "../../include/pricing/numerics/TridiagonalSolver.hpp"
+#include "../../include/pricing/util/Parallel.hpp"
+
+namespace pricing {
+namespace numerics {
+
+namespace {
+    // Lines a thread should get per sweep before another thread pays off
+    const std::size_t kMinLinesPerThread = 16;
+
+    // Central first-derivative weights for u[k-1], u[k], u[k+1]; zero on the boundary
+    std::vector<double> centralDerivativeWeights(const std::vector<double>& grid) {
+        std::vector<double> weights(3 * grid.size(), 0.0);
+        for (std::size_t k = 1; k + 1 < grid.size(); ++k) {
+            double hm = grid[k] - grid[k - 1];
+            double hp = grid[k + 1] - grid[k];
+            weights[3 * k] = -hp / (hm * (hm + hp));
+            weights[3 * k + 1] = (hp - hm) / (hm * hp);
+            weights[3 * k + 2] = hm / (hp * (hm + hp));
+        }
+        return weights;
+    }
+}
+
+struct AdiSolver2D::Workspace {
+    Workspace(std::size_t nx, std::size_t ny)
+        : xSolver(nx), ySolver(ny), line(ny) {}
+
+    TridiagonalSolver xSolver;
+    TridiagonalSolver ySolver;
+    std::vector<double> line;
+};
+
+AdiSolver2D::AdiSolver2D(std::vector<double> xGrid, std::vector<double> yGrid,
+                         AdiCoefficients coefficients, AdiScheme scheme, unsigned numThreads)
+    : xGrid_(std::move(xGrid)), yGrid_(std::move(yGrid)),
+      nx_(xGrid_.size()), ny_(yGrid_.size()),
+      coefficients_(std::move(coefficients)), scheme_(scheme), numThreads_(numThreads) {
+
+    if (nx_ < 3 || ny_ < 3) {
+        throw std::invalid_argument("ADI grid needs at least three points per direction");
+    }
+    std::size_t n = nodeCount();
+    const AdiCoefficients& c = coefficients_;
+    if (c.xx.size() != n || c.yy.size() != n || c.xy.size() != n ||
+        c.x.size() != n || c.y.size() != n || c.reaction.size() != n) {
+        throw std::invalid_argument("ADI coefficients must be given for every grid node");
+    }
+
+    xStencil_ = buildStencil(true);
+    yStencil_ = buildStencil(false);
+    xDerivative_ = centralDerivativeWeights(xGrid_);
+    yDerivative_ = centralDerivativeWeights(yGrid_);
+}
+
+AdiSolver2D::Stencil AdiSolver2D::buildStencil(bool alongX) const {
+    std::size_t n = nodeCount();
+    Stencil stencil{std::vector<double>(n, 0.0), std::vector<double>(n, 0.0), std::vector<double>(n, 0.0)};
+    const std::vector<double>& grid = alongX ? xGrid_ : yGrid_;
+    std::size_t last = grid.size() - 1;
+
+    for (std::size_t j = 0; j < ny_; ++j) {
+        for (std::size_t i = 0; i < nx_; ++i) {
+            std::size_t node = i + j * nx_;
+            std::size_t k = alongX ? i : j;
+            double second = alongX ? coefficients_.xx[node] : coefficients_.yy[node];
+            double first = alongX ? coefficients_.x[node] : coefficients_.y[node];
+
+            double lower = 0.0, diag = 0.0, upper = 0.0;
+            if (k == 0) {
+                double h = grid[1] - grid[0];
+                diag = -first / h;
+                upper = first / h;
+            } else if (k == last) {
+                double h = grid[k] - grid[k - 1];
+                lower = -first / h;
+                diag = first / h;
+            } else {
+                double hm = grid[k] - grid[k - 1];
+                double hp = grid[k + 1] - grid[k];
+                lower = -first * hp / (hm * (hm + hp)) + second * 2.0 / (hm * (hm + hp));
+                diag = first * (hp - hm) / (hm * hp) - second * 2.0 / (hm * hp);
+                upper = first * hm / (hp * (hm + hp)) + second * 2.0 / (hp * (hm + hp));
+            }
+
+            // The reaction term is shared equally between the two directions
+            stencil.lower[node] = lower;
+            stencil.diag[node] = diag - 0.5 * coefficients_.reaction[node];
+            stencil.upper[node] = upper;
+        }
+    }
+    return stencil;
+}
+
+AdiSolver2D::Stencil AdiSolver2D::implicitMatrix(bool alongX, double weight) const {
+    // Stored line by line: x lines are already contiguous, y lines are transposed
+    std::size_t n = nodeCount();
+    const Stencil& source = alongX ? xStencil_ : yStencil_;
+    Stencil matrix{std::vector<double>(n), std::vector<double>(n), std::vector<double>(n)};
+
+    for (std::size_t j = 0; j < ny_; ++j) {
+        for (std::size_t i = 0; i < nx_; ++i) {
+            std::size_t node = i + j * nx_;
+            std::size_t position = alongX ? node : j + i * ny_;
+            matrix.lower[position] = -weight * source.lower[node];
+            matrix.diag[position] = 1.0 - weight * source.diag[node];
+            matrix.upper[position] = -weight * source.upper[node];
+        }
+    }
+    return matrix;
+}
+
+void AdiSolver2D::applyMixed(const std::vector<double>& u, std::vector<double>& out) const {
+    std::fill(out.begin(), out.end(), 0.0);
+    for (std::size_t j = 1; j + 1 < ny_; ++j) {
+        const double* wy = &yDerivative_[3 * j];
+        for (std::size_t i = 1; i + 1 < nx_; ++i) {
+            std::size_t node = i + j * nx_;
+            const double* wx = &xDerivative_[3 * i];
+            double sum = 0.0;
+            for (int l = 0; l < 3; ++l) {
+                const double* row = &u[node + (static_cast<std::ptrdiff_t>(l) - 1) * static_cast<std::ptrdiff_t>(nx_)];
+                sum += wy[l] * (wx[0] * row[-1] + wx[1] * row[0] + wx[2] * row[1]);
+            }
+            out[node] = coefficients_.xy[node] * sum;
+        }
+    }
+}
+
+void AdiSolver2D::applyX(const std::vector<double>& u, std::vector<double>& out) const {
+    const Stencil& s = xStencil_;
+    for (std::size_t j = 0; j < ny_; ++j) {
+        std::size_t begin = j * nx_;
+        std::size_t end = begin + nx_ - 1;
+        out[begin] = s.diag[begin] * u[begin] + s.upper[begin] * u[begin + 1];
+        for (std::size_t node = begin + 1; node < end; ++node) {
+            out[node] = s.lower[node] * u[node - 1] + s.diag[node] * u[node] + s.upper[node] * u[node + 1];
+        }
+        out[end] = s.lower[end] * u[end - 1] + s.diag[end] * u[end];
+    }
+}
+
+void AdiSolver2D::applyY(const std::vector<double>& u, std::vector<double>& out) const {
+    const Stencil& s = yStencil_;
+    std::size_t last = (ny_ - 1) * nx_;
+    for (std::size_t i = 0; i < nx_; ++i) {
+        out[i] = s.diag[i] * u[i] + s.upper[i] * u[i + nx_];
+        out[last + i] = s.lower[last + i] * u[last + i - nx_] + s.diag[last + i] * u[last + i];
+    }
+    for (std::size_t node = nx_; node < last; ++node) {
+        out[node] = s.lower[node] * u[node - nx_] + s.diag[node] * u[node] + s.upper[node] * u[node + nx_];
+    }
+}
+
+void AdiSolver2D::solveLines(bool alongX, const Stencil& matrix, const std::vector<double>& rhs,
+                             std::vector<double>& out, std::vector<Workspace>& workspaces,
+                             util::ThreadTeam& team) const {
+    std::size_t lines = alongX ? ny_ : nx_;
+    std::size_t length = alongX ? nx_ : ny_;
+    std::size_t chunks = workspaces.size();
+
+    team.run([&](unsigned chunk) {
+        Workspace& ws = workspaces[chunk];
+        std::size_t first = lines * chunk / chunks;
+        std::size_t last = lines * (chunk + 1) / chunks;
+
+        for (std::size_t line = first; line < last; ++line) {
+            std::size_t offset = line * length;
+            const double* lower = matrix.lower.data() + offset;
+            const double* diag = matrix.diag.data() + offset;
+            const double* upper = matrix.upper.data() + offset;
+
+            if (alongX) {
+                ws.xSolver.solve(lower, diag, upper, rhs.data() + offset, out.data() + offset);
+            } else {
+                for (std::size_t j = 0; j < ny_; ++j) {
+                    ws.line[j] = rhs[line + j * nx_];
+                }
+                ws.ySolver.solve(lower, diag, upper, ws.line.data(), ws.line.data());
+                for (std::size_t j = 0; j < ny_; ++j) {
+                    out[line + j * nx_] = ws.line[j];
+                }
+            }
+        }
+    });
+}
+
+void AdiSolver2D::solve(std::vector<double>& values, double maturity, std::size_t timeSteps,
+                        const std::vector<double>* exerciseValues) const {
+    std::size_t n = nodeCount();
+    if (values.size() != n || (exerciseValues && exerciseValues->size() != n)) {
+        throw std::invalid_argument("ADI values must be given for every grid node");
+    }
+    if (timeSteps == 0) {
+        throw std::invalid_argument("ADI requires at least one time step");
+    }
+    if (maturity <= 0.0) {
+        return;
+    }
+
+    double dt = maturity / static_cast<double>(timeSteps);
+    double theta = scheme_ == AdiScheme::HundsdorferVerwer ? 0.5 + std::sqrt(3.0) / 6.0 : 0.5;
+    double weight = theta * dt;
+
+    Stencil implicitX = implicitMatrix(true, weight);
+    Stencil implicitY = implicitMatrix(false, weight);
+
+    std::size_t chunks = std::min<std::size_t>(util::resolveThreadCount(numThreads_),
+                                               std::max<std::size_t>(1, std::min(nx_, ny_) / kMinLinesPerThread));
+    util::ThreadTeam team(static_cast<unsigned>(chunks));
+    std::vector<Workspace> workspaces;
+    workspaces.reserve(chunks);
+    for (std::size_t c = 0; c < chunks; ++c) {
+        workspaces.emplace_back(nx_, ny_);
+    }
+
+    std::vector<double>& u = values;
+    std::vector<double> f0(n), f1(n), f2(n), g0(n), g1(n), g2(n);
+    std::vector<double> y0(n), y1(n), y2(n), rhs(n), next(n);
+    std::vector<double> multiplier(n, 0.0);
+
+    for (std::size_t step = 0; step < timeSteps; ++step) {
+        applyMixed(u, f0);
+        applyX(u, f1);
+        applyY(u, f2);
+
+        // Douglas predictor (shared by all schemes)
+        for (std::size_t k = 0; k < n; ++k) {
+            y0[k] = u[k] + dt * (f0[k] + f1[k] + f2[k] + multiplier[k]);
+            rhs[k] = y0[k] - weight * f1[k];
+        }
+        solveLines(true, implicitX, rhs, y1, workspaces, team);
+        for (std::size_t k = 0; k < n; ++k) {
+            rhs[k] = y1[k] - weight * f2[k];
+        }
+        solveLines(false, implicitY, rhs, y2, workspaces, team);
+
+        if (scheme_ == AdiScheme::Douglas) {
+            next.swap(y2);
+        } else {
+            // Corrector: re-evaluate the explicit part at the predicted solution
+            applyMixed(y2, g0);
+            if (scheme_ == AdiScheme::CraigSneyd) {
+                for (std::size_t k = 0; k < n; ++k) {
+                    rhs[k] = y0[k] + 0.5 * dt * (g0[k] - f0[k]) - weight * f1[k];
+                }
+                std::copy(f1.begin(), f1.end(), g1.begin());
+                std::copy(f2.begin(), f2.end(), g2.begin());
+            } else {
+                applyX(y2, g1);
+                applyY(y2, g2);
+                for (std::size_t k = 0; k < n; ++k) {
+                    rhs[k] = y0[k] + 0.5 * dt * (g0[k] + g1[k] + g2[k] - f0[k] - f1[k] - f2[k])
+                        - weight * g1[k];
+                }
+            }
+            solveLines(true, implicitX, rhs, y1, workspaces, team);
+            for (std::size_t k = 0; k < n; ++k) {
+                rhs[k] = y1[k] - weight * g2[k];
+            }
+            solveLines(false, implicitY, rhs, next, workspaces, team);
+        }
+
+        if (exerciseValues) {
+            const std::vector<double>& exercise = *exerciseValues;
+            for (std::size_t k = 0; k < n; ++k) {
+                double candidate = next[k];
+                u[k] = std::max(candidate - dt * multiplier[k], exercise[k]);
+                multiplier[k] = std::max(0.0, multiplier[k] + (exercise[k] - candidate) / dt);
+            }
+        } else {
+            u.swap(next);
+        }
+    }
+}
+
+} // namespace numerics
+} // namespace pricing
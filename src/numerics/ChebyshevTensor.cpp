@@ -0,0 +1,166 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+#include "../../include/pricing/numerics/ChebyshevTensor.hpp"
+
+namespace pricing {
+namespace numerics {
+
+namespace {
+    const double pi = 3.14159265358979323846;
+
+    std::size_t tensorSize(const std::vector<std::size_t>& nodes) {
+        std::size_t size = 1;
+        for (std::size_t n : nodes) {
+            size *= n;
+        }
+        return size;
+    }
+}
+
+ChebyshevTensor::ChebyshevTensor(std::vector<double> lower, std::vector<double> upper,
+                                 std::vector<std::size_t> nodes)
+    : lower_(std::move(lower)), upper_(std::move(upper)), nodes_(std::move(nodes)) {
+    validate();
+    size_ = tensorSize(nodes_);
+    auto storage = std::make_shared<std::vector<double>>(size_, 0.0);
+    coefficients_ = std::shared_ptr<const double>(storage, storage->data());
+}
+
+ChebyshevTensor::ChebyshevTensor(std::vector<double> lower, std::vector<double> upper,
+                                 std::vector<std::size_t> nodes, std::shared_ptr<const double> coefficients)
+    : lower_(std::move(lower)), upper_(std::move(upper)), nodes_(std::move(nodes)),
+      coefficients_(std::move(coefficients)) {
+    validate();
+    size_ = tensorSize(nodes_);
+    if (!coefficients_) {
+        throw std::invalid_argument("Chebyshev tensor requires coefficient storage");
+    }
+}
+
+void ChebyshevTensor::validate() const {
+    if (nodes_.empty()) {
+        throw std::invalid_argument("Chebyshev tensor needs at least one dimension");
+    }
+    if (lower_.size() != nodes_.size() || upper_.size() != nodes_.size()) {
+        throw std::invalid_argument("Chebyshev tensor bounds do not match its dimensions");
+    }
+    for (std::size_t d = 0; d < nodes_.size(); ++d) {
+        if (!(upper_[d] > lower_[d])) {
+            throw std::invalid_argument("Chebyshev tensor upper bound must exceed lower bound");
+        }
+        if (nodes_[d] < 2) {
+            throw std::invalid_argument("Chebyshev tensor needs at least two nodes per dimension");
+        }
+    }
+}
+
+std::vector<double> ChebyshevTensor::points(std::size_t dimension) const {
+    std::size_t n = nodes_.at(dimension);
+    double mid = 0.5 * (upper_[dimension] + lower_[dimension]);
+    double half = 0.5 * (upper_[dimension] - lower_[dimension]);
+    std::vector<double> result(n);
+    for (std::size_t k = 0; k < n; ++k) {
+        result[k] = mid + half * std::cos(pi * static_cast<double>(k) / static_cast<double>(n - 1));
+    }
+    result.front() = upper_[dimension];
+    result.back() = lower_[dimension];
+    return result;
+}
+
+void ChebyshevTensor::fit(const std::vector<double>& values) {
+    if (values.size() != size_) {
+        throw std::invalid_argument("Number of sampled values does not match the Chebyshev tensor");
+    }
+    std::vector<double> current = values;
+    std::vector<double> transformed(size_);
+
+    // Discrete cosine transform along each dimension in turn
+    std::size_t outer = 1;
+    for (std::size_t d = 0; d < nodes_.size(); ++d) {
+        std::size_t n = nodes_[d];
+        std::size_t inner = size_ / (outer * n);
+        double scale = 2.0 / static_cast<double>(n - 1);
+
+        std::vector<double> cosines(n * n);
+        for (std::size_t j = 0; j < n; ++j) {
+            for (std::size_t k = 0; k < n; ++k) {
+                double weight = (k == 0 || k == n - 1) ? 0.5 : 1.0;
+                if (j == 0 || j == n - 1) {
+                    weight *= 0.5;
+                }
+                cosines[j * n + k] = scale * weight
+                    * std::cos(pi * static_cast<double>(j * k) / static_cast<double>(n - 1));
+            }
+        }
+
+        for (std::size_t o = 0; o < outer; ++o) {
+            const double* source = current.data() + o * n * inner;
+            double* target = transformed.data() + o * n * inner;
+            for (std::size_t j = 0; j < n; ++j) {
+                double* row = target + j * inner;
+                for (std::size_t i = 0; i < inner; ++i) {
+                    row[i] = 0.0;
+                }
+                for (std::size_t k = 0; k < n; ++k) {
+                    double c = cosines[j * n + k];
+                    const double* input = source + k * inner;
+                    for (std::size_t i = 0; i < inner; ++i) {
+                        row[i] += c * input[i];
+                    }
+                }
+            }
+        }
+        current.swap(transformed);
+        outer *= n;
+    }
+
+    auto storage = std::make_shared<std::vector<double>>(std::move(current));
+    coefficients_ = std::shared_ptr<const double>(storage, storage->data());
+}
+
+double ChebyshevTensor::evaluate(const double* point) const {
+    // Three recurrence rows and the reduced level, reused across calls on
+    // the same thread; the first dimension needs the most.
+    std::size_t width = size_ / nodes_.front();
+    thread_local std::vector<double> scratch;
+    if (scratch.size() < 4 * width) {
+        scratch.resize(4 * width);
+    }
+    double* level = scratch.data();
+    double* b0 = level + width;
+    double* b1 = b0 + width;
+    double* b2 = b1 + width;
+
+    const double* source = coefficients_.get();
+    std::size_t rest = size_;
+    for (std::size_t d = 0; d < nodes_.size(); ++d) {
+        std::size_t n = nodes_[d];
+        rest /= n;
+        double half = 0.5 * (upper_[d] - lower_[d]);
+        double t = (point[d] - 0.5 * (upper_[d] + lower_[d])) / half;
+        double twoT = 2.0 * t;
+
+        std::fill(b1, b1 + rest, 0.0);
+        std::fill(b2, b2 + rest, 0.0);
+        for (std::size_t k = n - 1; k >= 1; --k) {
+            const double* row = source + k * rest;
+            for (std::size_t i = 0; i < rest; ++i) {
+                b0[i] = row[i] + twoT * b1[i] - b2[i];
+            }
+            std::swap(b2, b1);
+            std::swap(b1, b0);
+        }
+        // Row 0 of a reduced source is level itself, read and written in place
+        for (std::size_t i = 0; i < rest; ++i) {
+            level[i] = source[i] + t * b1[i] - b2[i];
+        }
+        source = level;
+    }
+    return source[0];
+}
+
+} // namespace numerics
+} // namespace pricing
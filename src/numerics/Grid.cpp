@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "../../include/pricing/numerics/Grid.hpp"
+
+namespace pricing {
+namespace numerics {
+
+std::vector<double> sinhGrid(double lower, double upper, double center, double scale, std::size_t intervals) {
+    if (!(upper > lower)) {
+        throw std::invalid_argument("Grid upper bound must exceed lower bound");
+    }
+    if (scale <= 0.0) {
+        throw std::invalid_argument("Grid concentration scale must be positive");
+    }
+    if (intervals < 2) {
+        throw std::invalid_argument("Grid needs at least two intervals");
+    }
+
+    double uLower = std::asinh((lower - center) / scale);
+    double uUpper = std::asinh((upper - center) / scale);
+    double du = (uUpper - uLower) / static_cast<double>(intervals);
+
+    std::vector<double> grid(intervals + 1);
+    for (std::size_t k = 0; k <= intervals; ++k) {
+        grid[k] = center + scale * std::sinh(uLower + du * static_cast<double>(k));
+    }
+    grid.front() = lower;
+    grid.back() = upper;
+    return grid;
+}
+
+std::vector<double> concentratedGrid(double lower, double upper, const std::vector<double>& centers,
+                                     double scale, std::size_t intervals) {
+    if (centers.empty()) {
+        throw std::invalid_argument("Grid needs at least one concentration center");
+    }
+    if (centers.size() == 1) {
+        return sinhGrid(lower, upper, centers.front(), scale, intervals);
+    }
+
+    auto stretched = [&](double x) {
+        double u = 0.0;
+        for (double center : centers) {
+            u += std::asinh((x - center) / scale);
+        }
+        return u;
+    };
+
+    // Validates the bounds, scale and interval count
+    std::vector<double> grid = sinhGrid(lower, upper, centers.front(), scale, intervals);
+    double uLower = stretched(lower);
+    double du = (stretched(upper) - uLower) / static_cast<double>(intervals);
+
+    // u(x) is strictly increasing, so each node is found by bisection
+    double left = lower;
+    for (std::size_t k = 1; k < intervals; ++k) {
+        double target = uLower + du * static_cast<double>(k);
+        double right = upper;
+        for (int iteration = 0; iteration < 100 && right - left > 1e-14 * (upper - lower); ++iteration) {
+            double middle = 0.5 * (left + right);
+            if (stretched(middle) < target) {
+                left = middle;
+            } else {
+                right = middle;
+            }
+        }
+        grid[k] = 0.5 * (left + right);
+        left = grid[k];
+    }
+    return grid;
+}
+
+InterpolationStencil interpolationStencil(const std::vector<double>& grid, double x) {
+    if (grid.size() < 3) {
+        throw std::invalid_argument("Interpolation needs at least three grid points");
+    }
+
+    // Central node is the grid point nearest to x, kept away from the ends
+    auto upper = std::lower_bound(grid.begin(), grid.end(), x);
+    std::size_t nearest = static_cast<std::size_t>(upper - grid.begin());
+    if (nearest == grid.size() || (nearest > 0 && x - grid[nearest - 1] < grid[nearest] - x)) {
+        --nearest;
+    }
+    nearest = std::min(std::max<std::size_t>(nearest, 1), grid.size() - 2);
+
+    InterpolationStencil stencil;
+    stencil.first = nearest - 1;
+    const double* p = grid.data() + stencil.first;
+    stencil.weights[0] = (x - p[1]) * (x - p[2]) / ((p[0] - p[1]) * (p[0] - p[2]));
+    stencil.weights[1] = (x - p[0]) * (x - p[2]) / ((p[1] - p[0]) * (p[1] - p[2]));
+    stencil.weights[2] = (x - p[0]) * (x - p[1]) / ((p[2] - p[0]) * (p[2] - p[1]));
+    return stencil;
+}
+
+} // namespace numerics
+} // namespace pricing
@@ -0,0 +1,65 @@
+#include <cmath>
+#include <stdexcept>
+
+#include "../../include/pricing/numerics/MonotoneSpline.hpp"
+
+namespace pricing {
+namespace numerics {
+
+MonotoneSpline::MonotoneSpline(double lower, double upper, const std::vector<double>& values)
+    : lower_(lower), upper_(upper) {
+    if (values.size() < 2) {
+        throw std::invalid_argument("Monotone spline needs at least two values");
+    }
+    if (!(lower < upper)) {
+        throw std::invalid_argument("Monotone spline needs lower < upper");
+    }
+
+    std::size_t intervals = values.size() - 1;
+    double step = (upper - lower) / static_cast<double>(intervals);
+    inverseStep_ = 1.0 / step;
+
+    // Secant slopes, then tangents: averages of neighbouring secants, zero at
+    // local extrema, and limited to the Fritsch-Carlson monotonicity region
+    std::vector<double> secants(intervals);
+    for (std::size_t k = 0; k < intervals; ++k) {
+        secants[k] = (values[k + 1] - values[k]) / step;
+    }
+    std::vector<double> tangents(values.size());
+    tangents[0] = secants[0];
+    tangents[intervals] = secants[intervals - 1];
+    for (std::size_t k = 1; k < intervals; ++k) {
+        tangents[k] = secants[k - 1] * secants[k] <= 0.0 ? 0.0 : 0.5 * (secants[k - 1] + secants[k]);
+    }
+    for (std::size_t k = 0; k < intervals; ++k) {
+        if (secants[k] == 0.0) {
+            tangents[k] = 0.0;
+            tangents[k + 1] = 0.0;
+            continue;
+        }
+        double alpha = tangents[k] / secants[k];
+        double beta = tangents[k + 1] / secants[k];
+        double norm = alpha * alpha + beta * beta;
+        if (norm > 9.0) {
+            double tau = 3.0 / std::sqrt(norm);
+            tangents[k] = tau * alpha * secants[k];
+            tangents[k + 1] = tau * beta * secants[k];
+        }
+    }
+
+    // Hermite form in t = (x - x_k) / step
+    coefficients_.resize(4 * intervals);
+    for (std::size_t k = 0; k < intervals; ++k) {
+        double y0 = values[k];
+        double y1 = values[k + 1];
+        double m0 = tangents[k] * step;
+        double m1 = tangents[k + 1] * step;
+        coefficients_[4 * k] = y0;
+        coefficients_[4 * k + 1] = m0;
+        coefficients_[4 * k + 2] = 3.0 * (y1 - y0) - 2.0 * m0 - m1;
+        coefficients_[4 * k + 3] = 2.0 * (y0 - y1) + m0 + m1;
+    }
+}
+
+} // namespace numerics
+} // namespace pricing
@@ -0,0 +1,32 @@
+#include <stdexcept>
+
+#include "../../include/pricing/numerics/TridiagonalSolver.hpp"
+
+namespace pricing {
+namespace numerics {
+
+TridiagonalSolver::TridiagonalSolver(std::size_t size)
+    : scratch_(size) {
+    if (size == 0) {
+        throw std::invalid_argument("Tridiagonal system must not be empty");
+    }
+}
+
+void TridiagonalSolver::solve(const double* lower, const double* diag, const double* upper,
+                              const double* rhs, double* x) {
+    std::size_t n = scratch_.size();
+
+    double pivot = diag[0];
+    x[0] = rhs[0] / pivot;
+    for (std::size_t k = 1; k < n; ++k) {
+        scratch_[k] = upper[k - 1] / pivot;
+        pivot = diag[k] - lower[k] * scratch_[k];
+        x[k] = (rhs[k] - lower[k] * x[k - 1]) / pivot;
+    }
+    for (std::size_t k = n - 1; k > 0; --k) {
+        x[k - 1] -= scratch_[k] * x[k];
+    }
+}
+
+} // namespace numerics
+} // namespace pricing
@@ -0,0 +1,691 @@
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && defined(__NR_io_uring_register)
+#define PRICING_HAVE_IO_URING 1
+#endif
+#endif
+#endif
+
+#include "../../include/pricing/util/AsyncFileIO.hpp"
+
+namespace pricing {
+namespace util {
+
+namespace {
+    constexpr std::size_t kMaxQueueDepth = 4096;
+    constexpr std::size_t kMaxTransfer = std::size_t(1) << 30;   // Per read or write call
+    constexpr int kReadFlags = O_RDONLY | O_CLOEXEC;
+    constexpr int kWriteFlags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+    constexpr mode_t kWriteMode = 0644;
+
+    std::string ioError(const char* action, const std::string& path, int error) {
+        return std::string("Cannot ") + action + " " + path + ": " + std::strerror(error);
+    }
+
+    // Blocking equivalents of the io_uring request sequence
+    void readWholeFile(const std::string& path, std::string& data, std::string& error) {
+        int fd = ::open(path.c_str(), kReadFlags);
+        if (fd < 0) {
+            error = ioError("open", path, errno);
+            return;
+        }
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            error = ioError("read", path, errno);
+            ::close(fd);
+            return;
+        }
+        data.resize(static_cast<std::size_t>(info.st_size));
+        std::size_t done = 0;
+        while (done < data.size()) {
+            ssize_t count = ::pread(fd, &data[done], std::min(data.size() - done, kMaxTransfer),
+                                    static_cast<off_t>(done));
+            if (count < 0 && errno == EINTR) {
+                continue;
+            }
+            if (count < 0) {
+                error = ioError("read", path, errno);
+                break;
+            }
+            if (count == 0) {
+                data.resize(done);     // Truncated while reading
+                break;
+            }
+            done += static_cast<std::size_t>(count);
+        }
+        ::close(fd);
+    }
+
+    void writeWholeFile(const std::string& path, const std::string& data, std::string& error) {
+        int fd = ::open(path.c_str(), kWriteFlags, kWriteMode);
+        if (fd < 0) {
+            error = ioError("create", path, errno);
+            return;
+        }
+        std::size_t done = 0;
+        while (done < data.size()) {
+            ssize_t count = ::pwrite(fd, data.data() + done, std::min(data.size() - done, kMaxTransfer),
+                                     static_cast<off_t>(done));
+            if (count < 0 && errno == EINTR) {
+                continue;
+            }
+            if (count < 0) {
+                error = ioError("write", path, errno);
+                break;
+            }
+            done += static_cast<std::size_t>(count);
+        }
+        if (::close(fd) != 0 && error.empty()) {
+            error = ioError("write", path, errno);
+        }
+    }
+}
+
+// Completions are handed from the I/O threads to the caller under a lock
+class AsyncFileIO::Backend {
+public:
+    virtual ~Backend() = default;
+
+    virtual void submit(std::uint64_t tag, bool write, const std::string& path, std::string data) = 0;
+    virtual IoBackend kind() const = 0;
+
+    bool next(IoCompletion& completion, bool wait) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (wait) {
+            completionReady_.wait(lock, [this]() { return !done_.empty() || outstanding_ == 0; });
+        }
+        if (done_.empty()) {
+            return false;
+        }
+        completion = std::move(done_.front());
+        done_.pop_front();
+        --outstanding_;
+        return true;
+    }
+
+    std::size_t outstanding() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return outstanding_;
+    }
+
+protected:
+    // Called with mutex_ held
+    void complete(IoCompletion completion) {
+        done_.push_back(std::move(completion));
+        completionReady_.notify_one();
+    }
+
+    mutable std::mutex mutex_;
+    std::size_t outstanding_ = 0;
+
+private:
+    std::condition_variable completionReady_;
+    std::deque<IoCompletion> done_;
+};
+
+namespace {
+    struct IoRequest {
+        std::uint64_t tag = 0;
+        bool write = false;
+        std::string path;
+        std::string data;
+    };
+
+    // Fallback: blocking calls on a few threads
+    class ThreadBackend : public AsyncFileIO::Backend {
+    public:
+        explicit ThreadBackend(unsigned threads) {
+            workers_.reserve(threads);
+            for (unsigned t = 0; t < threads; ++t) {
+                workers_.emplace_back([this]() { run(); });
+            }
+        }
+
+        ~ThreadBackend() override {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stopping_ = true;
+                queue_.clear();
+            }
+            requestReady_.notify_all();
+            for (auto& worker : workers_) {
+                worker.join();
+            }
+        }
+
+        void submit(std::uint64_t tag, bool write, const std::string& path, std::string data) override {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                queue_.push_back(IoRequest{tag, write, path, std::move(data)});
+                ++outstanding_;
+            }
+            requestReady_.notify_one();
+        }
+
+        IoBackend kind() const override { return IoBackend::Threads; }
+
+    private:
+        void run() {
+            for (;;) {
+                IoRequest request;
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    requestReady_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+                    if (stopping_) {
+                        return;
+                    }
+                    request = std::move(queue_.front());
+                    queue_.pop_front();
+                }
+
+                IoCompletion completion;
+                completion.tag = request.tag;
+                completion.write = request.write;
+                if (request.write) {
+                    writeWholeFile(request.path, request.data, completion.error);
+                } else {
+                    readWholeFile(request.path, completion.data, completion.error);
+                }
+
+                std::lock_guard<std::mutex> lock(mutex_);
+                complete(std::move(completion));
+            }
+        }
+
+        std::condition_variable requestReady_;
+        std::deque<IoRequest> queue_;
+        bool stopping_ = false;
+        std::vector<std::thread> workers_;
+    };
+
+#ifdef PRICING_HAVE_IO_URING
+    int ioUringSetup(unsigned entries, io_uring_params* params) {
+        return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+    }
+
+    int ioUringEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags) {
+        return static_cast<int>(::syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+    }
+
+    int ioUringRegister(int fd, unsigned opcode, void* arg, unsigned count) {
+        return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode, arg, count));
+    }
+
+    // One I/O thread owns the ring, so file operations keep moving while the
+    // caller is busy. Each file is a small state machine with one operation
+    // in the ring at a time: open, then reads or writes until the file is
+    // done, then close. The slot index travels as the operation's user data.
+    // A read of an eventfd stays queued so that new requests wake the thread.
+    class UringBackend : public AsyncFileIO::Backend {
+    public:
+        static std::unique_ptr<UringBackend> create(std::size_t queueDepth) {
+            std::unique_ptr<UringBackend> backend(new UringBackend(queueDepth));
+            if (!backend->setup()) {
+                return nullptr;
+            }
+            backend->thread_ = std::thread([raw = backend.get()]() { raw->run(); });
+            return backend;
+        }
+
+        ~UringBackend() override {
+            if (thread_.joinable()) {
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    stopping_ = true;
+                }
+                wake();
+                thread_.join();
+            }
+            for (const auto& slot : slots_) {
+                if (slot.fd >= 0) {
+                    ::close(slot.fd);
+                }
+            }
+            if (sqes_ != nullptr) {
+                ::munmap(sqes_, sqesSize_);
+            }
+            if (cqRing_ != nullptr && cqRing_ != sqRing_) {
+                ::munmap(cqRing_, cqRingSize_);
+            }
+            if (sqRing_ != nullptr) {
+                ::munmap(sqRing_, sqRingSize_);
+            }
+            if (ringFd_ >= 0) {
+                ::close(ringFd_);
+            }
+            if (wakeFd_ >= 0) {
+                ::close(wakeFd_);
+            }
+        }
+
+        void submit(std::uint64_t tag, bool write, const std::string& path, std::string data) override {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                ++outstanding_;
+                if (!failure_.empty()) {
+                    IoCompletion completion;
+                    completion.tag = tag;
+                    completion.write = write;
+                    completion.error = failure_;
+                    complete(std::move(completion));
+                    return;
+                }
+                incoming_.push_back(IoRequest{tag, write, path, std::move(data)});
+            }
+            wake();
+        }
+
+        IoBackend kind() const override { return IoBackend::IoUring; }
+
+    private:
+        enum class Stage { Open, Transfer, Close };
+
+        struct Slot {
+            IoRequest request;
+            std::string error;
+            int fd = -1;
+            std::size_t done = 0;
+            Stage stage = Stage::Open;
+        };
+
+        static constexpr std::uint64_t kWakeTag = ~std::uint64_t(0);
+
+        explicit UringBackend(std::size_t queueDepth) : slots_(queueDepth) {
+            freeSlots_.reserve(queueDepth);
+            for (std::size_t i = queueDepth; i > 0; --i) {
+                freeSlots_.push_back(i - 1);
+            }
+        }
+
+        bool setup() {
+            wakeFd_ = ::eventfd(0, EFD_CLOEXEC);
+            if (wakeFd_ < 0) {
+                return false;
+            }
+            io_uring_params params;
+            std::memset(&params, 0, sizeof(params));
+            ringFd_ = ioUringSetup(static_cast<unsigned>(slots_.size() + 1), &params);
+            if (ringFd_ < 0) {
+                return false;     // Kernel without io_uring, or disabled by policy
+            }
+            if (!supportsOperations()) {
+                return false;
+            }
+
+            sqRingSize_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            cqRingSize_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+            bool singleMapping = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+            if (singleMapping) {
+                sqRingSize_ = cqRingSize_ = std::max(sqRingSize_, cqRingSize_);
+            }
+            sqRing_ = map(sqRingSize_, IORING_OFF_SQ_RING);
+            if (sqRing_ == nullptr) {
+                return false;
+            }
+            cqRing_ = singleMapping ? sqRing_ : map(cqRingSize_, IORING_OFF_CQ_RING);
+            sqesSize_ = params.sq_entries * sizeof(io_uring_sqe);
+            sqes_ = static_cast<io_uring_sqe*>(map(sqesSize_, IORING_OFF_SQES));
+            if (cqRing_ == nullptr || sqes_ == nullptr) {
+                return false;
+            }
+
+            char* sq = static_cast<char*>(sqRing_);
+            sqHead_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+            sqTail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+            sqMask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+            sqArray_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+            char* cq = static_cast<char*>(cqRing_);
+            cqHead_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+            cqTail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+            cqMask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+            cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+            return true;
+        }
+
+        bool supportsOperations() {
+            const unsigned maxOps = 256;
+            std::vector<char> buffer(sizeof(io_uring_probe) + maxOps * sizeof(io_uring_probe_op), 0);
+            auto* probe = reinterpret_cast<io_uring_probe*>(buffer.data());
+            if (ioUringRegister(ringFd_, IORING_REGISTER_PROBE, probe, maxOps) < 0) {
+                return false;
+            }
+            for (unsigned op : {IORING_OP_OPENAT, IORING_OP_READ, IORING_OP_WRITE, IORING_OP_CLOSE}) {
+                if (op > probe->last_op || (probe->ops[op].flags & IO_URING_OP_SUPPORTED) == 0) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        void* map(std::size_t size, off_t offset) {
+            void* mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                   ringFd_, offset);
+            return mapping == MAP_FAILED ? nullptr : mapping;
+        }
+
+        void wake() {
+            std::uint64_t one = 1;
+            while (::write(wakeFd_, &one, sizeof(one)) < 0 && errno == EINTR) {
+            }
+        }
+
+        void run() {
+            bool wakeArmed = false;
+            try {
+                for (;;) {
+                    bool stopping;
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        stopping = stopping_;
+                        if (stopping) {
+                            incoming_.clear();     // Not started; the caller is gone
+                        }
+                        while (!incoming_.empty() && !freeSlots_.empty()) {
+                            start(std::move(incoming_.front()));
+                            incoming_.pop_front();
+                        }
+                    }
+                    // The kernel may still write into slot buffers and the wake value
+                    if (stopping && freeSlots_.size() == slots_.size() && !wakeArmed) {
+                        return;
+                    }
+                    if (!wakeArmed && !stopping) {
+                        io_uring_sqe* sqe = nextSqe(kWakeTag);
+                        sqe->opcode = IORING_OP_READ;
+                        sqe->fd = wakeFd_;
+                        sqe->addr = reinterpret_cast<std::uint64_t>(&wakeValue_);
+                        sqe->len = sizeof(wakeValue_);
+                        wakeArmed = true;
+                    }
+                    enter(1);
+                    reap(wakeArmed);
+                }
+            } catch (const std::exception& e) {
+                // The ring is unusable; fail everything that has not completed
+                std::lock_guard<std::mutex> lock(mutex_);
+                failure_ = e.what();
+                for (auto& slot : slots_) {
+                    if (slot.fd != -1 || !slot.request.path.empty()) {
+                        slot.error = e.what();
+                        finish(slot);
+                    }
+                }
+                for (auto& request : incoming_) {
+                    IoCompletion completion;
+                    completion.tag = request.tag;
+                    completion.write = request.write;
+                    completion.error = e.what();
+                    complete(std::move(completion));
+                }
+                incoming_.clear();
+            }
+        }
+
+        // At most one operation per slot plus the wake read is queued, so the
+        // ring never fills up
+        io_uring_sqe* nextSqe(std::uint64_t userData) {
+            unsigned tail = *sqTail_;
+            unsigned index = tail & sqMask_;
+            io_uring_sqe* sqe = &sqes_[index];
+            std::memset(sqe, 0, sizeof(*sqe));
+            sqe->user_data = userData;
+            sqArray_[index] = index;
+            __atomic_store_n(sqTail_, tail + 1, __ATOMIC_RELEASE);
+            return sqe;
+        }
+
+        void enter(unsigned minComplete) {
+            for (;;) {
+                unsigned pending = *sqTail_ - __atomic_load_n(sqHead_, __ATOMIC_ACQUIRE);
+                int result = ioUringEnter(ringFd_, pending, minComplete,
+                                          minComplete > 0 ? IORING_ENTER_GETEVENTS : 0);
+                if (result >= 0) {
+                    return;
+                }
+                if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+                    throw std::runtime_error(std::string("io_uring_enter failed: ") + std::strerror(errno));
+                }
+            }
+        }
+
+        void reap(bool& wakeArmed) {
+            unsigned head = *cqHead_;
+            unsigned tail = __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE);
+            while (head != tail) {
+                const io_uring_cqe& cqe = cqes_[head & cqMask_];
+                std::uint64_t userData = cqe.user_data;
+                int result = cqe.res;
+                ++head;
+                __atomic_store_n(cqHead_, head, __ATOMIC_RELEASE);
+                if (userData == kWakeTag) {
+                    wakeArmed = false;
+                } else {
+                    advance(slots_[static_cast<std::size_t>(userData)], result);
+                }
+            }
+        }
+
+        void start(IoRequest request) {
+            std::size_t index = freeSlots_.back();
+            freeSlots_.pop_back();
+            Slot& slot = slots_[index];
+            slot.request = std::move(request);
+            slot.error.clear();
+            slot.fd = -1;
+            slot.done = 0;
+            slot.stage = Stage::Open;
+
+            bool write = slot.request.write;
+            io_uring_sqe* sqe = nextSqe(index);
+            sqe->opcode = IORING_OP_OPENAT;
+            sqe->fd = AT_FDCWD;
+            sqe->addr = reinterpret_cast<std::uint64_t>(slot.request.path.c_str());
+            sqe->len = write ? kWriteMode : 0;
+            sqe->open_flags = static_cast<std::uint32_t>(write ? kWriteFlags : kReadFlags);
+        }
+
+        void advance(Slot& slot, int result) {
+            const IoRequest& request = slot.request;
+            switch (slot.stage) {
+            case Stage::Open:
+                if (result < 0) {
+                    slot.error = ioError(request.write ? "create" : "open", request.path, -result);
+                    finishLocked(slot);
+                    return;
+                }
+                slot.fd = result;
+                if (!request.write) {
+                    struct stat info;
+                    if (::fstat(slot.fd, &info) != 0) {
+                        slot.error = ioError("read", request.path, errno);
+                        close(slot);
+                        return;
+                    }
+                    slot.request.data.resize(static_cast<std::size_t>(info.st_size));
+                }
+                slot.stage = Stage::Transfer;
+                transfer(slot);
+                return;
+            case Stage::Transfer:
+                if (result == -EINTR || result == -EAGAIN) {
+                    transfer(slot);
+                    return;
+                }
+                if (result < 0) {
+                    slot.error = ioError(request.write ? "write" : "read", request.path, -result);
+                    close(slot);
+                    return;
+                }
+                if (result == 0 && !request.write) {
+                    slot.request.data.resize(slot.done);     // Truncated while reading
+                }
+                slot.done += static_cast<std::size_t>(result);
+                transfer(slot);
+                return;
+            case Stage::Close:
+                if (result < 0 && slot.error.empty()) {
+                    slot.error = ioError(request.write ? "write" : "read", request.path, -result);
+                }
+                slot.fd = -1;
+                finishLocked(slot);
+                return;
+            }
+        }
+
+        std::size_t slotIndex(const Slot& slot) const {
+            return static_cast<std::size_t>(&slot - slots_.data());
+        }
+
+        void transfer(Slot& slot) {
+            std::string& data = slot.request.data;
+            if (slot.done >= data.size()) {
+                close(slot);
+                return;
+            }
+            io_uring_sqe* sqe = nextSqe(slotIndex(slot));
+            sqe->opcode = slot.request.write ? IORING_OP_WRITE : IORING_OP_READ;
+            sqe->fd = slot.fd;
+            sqe->addr = reinterpret_cast<std::uint64_t>(&data[slot.done]);
+            sqe->len = static_cast<std::uint32_t>(std::min(data.size() - slot.done, kMaxTransfer));
+            sqe->off = slot.done;
+        }
+
+        void close(Slot& slot) {
+            slot.stage = Stage::Close;
+            io_uring_sqe* sqe = nextSqe(slotIndex(slot));
+            sqe->opcode = IORING_OP_CLOSE;
+            sqe->fd = slot.fd;
+        }
+
+        void finishLocked(Slot& slot) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            finish(slot);
+        }
+
+        // Called with mutex_ held
+        void finish(Slot& slot) {
+            IoCompletion completion;
+            completion.tag = slot.request.tag;
+            completion.write = slot.request.write;
+            completion.error = std::move(slot.error);
+            if (!slot.request.write) {
+                completion.data = std::move(slot.request.data);
+            }
+            slot.request = IoRequest();
+            complete(std::move(completion));
+            freeSlots_.push_back(slotIndex(slot));
+        }
+
+        int ringFd_ = -1;
+        int wakeFd_ = -1;
+        std::uint64_t wakeValue_ = 0;
+        void* sqRing_ = nullptr;
+        void* cqRing_ = nullptr;
+        std::size_t sqRingSize_ = 0;
+        std::size_t cqRingSize_ = 0;
+        io_uring_sqe* sqes_ = nullptr;
+        std::size_t sqesSize_ = 0;
+        unsigned* sqHead_ = nullptr;
+        unsigned* sqTail_ = nullptr;
+        unsigned* sqArray_ = nullptr;
+        unsigned sqMask_ = 0;
+        unsigned* cqHead_ = nullptr;
+        unsigned* cqTail_ = nullptr;
+        unsigned cqMask_ = 0;
+        io_uring_cqe* cqes_ = nullptr;
+
+        // Owned by the I/O thread
+        std::vector<Slot> slots_;
+        std::vector<std::size_t> freeSlots_;
+        // Shared with the caller under mutex_
+        std::deque<IoRequest> incoming_;
+        std::string failure_;
+        bool stopping_ = false;
+        std::thread thread_;
+    };
+#endif
+
+    std::unique_ptr<AsyncFileIO::Backend> createIoUring(std::size_t queueDepth) {
+#ifdef PRICING_HAVE_IO_URING
+        return UringBackend::create(queueDepth);
+#else
+        (void)queueDepth;
+        return nullptr;
+#endif
+    }
+}
+
+void AsyncIoSettings::validate() const {
+    if (queueDepth == 0 || queueDepth > kMaxQueueDepth) {
+        throw std::invalid_argument("Queue depth must be between 1 and 4096");
+    }
+    if (ioThreads == 0) {
+        throw std::invalid_argument("At least one I/O thread is required");
+    }
+}
+
+AsyncFileIO::AsyncFileIO(const AsyncIoSettings& settings) {
+    settings.validate();
+    if (settings.backend != IoBackend::Threads) {
+        backend_ = createIoUring(settings.queueDepth);
+        if (!backend_ && settings.backend == IoBackend::IoUring) {
+            throw std::runtime_error("io_uring is not available on this system");
+        }
+    }
+    if (!backend_) {
+        backend_.reset(new ThreadBackend(settings.ioThreads));
+    }
+}
+
+AsyncFileIO::~AsyncFileIO() = default;
+
+void AsyncFileIO::read(const std::string& path, std::uint64_t tag) {
+    backend_->submit(tag, false, path, std::string());
+}
+
+void AsyncFileIO::write(const std::string& path, std::string data, std::uint64_t tag) {
+    backend_->submit(tag, true, path, std::move(data));
+}
+
+bool AsyncFileIO::next(IoCompletion& completion) {
+    return backend_->next(completion, true);
+}
+
+bool AsyncFileIO::poll(IoCompletion& completion) {
+    return backend_->next(completion, false);
+}
+
+std::size_t AsyncFileIO::outstanding() const {
+    return backend_->outstanding();
+}
+
+IoBackend AsyncFileIO::backend() const {
+    return backend_->kind();
+}
+
+bool AsyncFileIO::ioUringAvailable() {
+    static const bool available = createIoUring(1) != nullptr;
+    return available;
+}
+
+} // namespace util
+} // namespace pricing
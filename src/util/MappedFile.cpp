@@ -0,0 +1,77 @@
+#include <stdexcept>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../../include/pricing/util/MappedFile.hpp"
+
+namespace pricing {
+namespace util {
+
+MappedFile::MappedFile(const std::string& path, const MemoryPolicy& policy) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open file: " + path);
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot read file: " + path);
+    }
+    size_ = static_cast<std::size_t>(info.st_size);
+    if (size_ > 0) {
+        int flags = MAP_PRIVATE;
+        bool populated = false;
+#ifdef MAP_POPULATE
+        if (policy.prefault) {
+            flags |= MAP_POPULATE;
+            populated = true;
+        }
+#endif
+        void* mapping = ::mmap(nullptr, size_, PROT_READ, flags, fd, 0);
+        if (mapping == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error("Cannot map file: " + path);
+        }
+#ifdef MADV_HUGEPAGE
+        if (policy.hugePages) {
+            ::madvise(mapping, size_, MADV_HUGEPAGE);   // Advisory; most file systems ignore it
+        }
+#endif
+        if (policy.prefault && !populated) {
+            prefaultPages(mapping, size_, false);
+        }
+        data_ = static_cast<const char*>(mapping);
+    }
+    ::close(fd);
+}
+
+MappedFile::~MappedFile() {
+    release();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        release();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+}
+
+void MappedFile::release() {
+    if (data_ != nullptr) {
+        ::munmap(const_cast<char*>(data_), size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+}
+
+} // namespace util
+} // namespace pricing
@@ -0,0 +1,114 @@
+#include <atomic>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "../../include/pricing/util/PageAllocator.hpp"
+
+namespace pricing {
+namespace util {
+
+namespace {
+    std::atomic<bool> hugePagesPolicy{false};
+    std::atomic<bool> prefaultPolicy{false};
+
+    std::atomic<std::size_t> hugeTlbCount{0};
+    std::atomic<std::size_t> transparentCount{0};
+    std::atomic<std::size_t> regularCount{0};
+
+    std::size_t mappingLength(std::size_t bytes) {
+        return (bytes + kLargeAllocation - 1) / kLargeAllocation * kLargeAllocation;
+    }
+}
+
+void setMemoryPolicy(const MemoryPolicy& policy) {
+    hugePagesPolicy = policy.hugePages;
+    prefaultPolicy = policy.prefault;
+}
+
+MemoryPolicy memoryPolicy() {
+    MemoryPolicy policy;
+    policy.hugePages = hugePagesPolicy;
+    policy.prefault = prefaultPolicy;
+    return policy;
+}
+
+void prefaultPages(const void* data, std::size_t bytes, bool write) {
+    static const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    if (write) {
+        volatile char* bytesOut = static_cast<volatile char*>(const_cast<void*>(data));
+        for (std::size_t offset = 0; offset < bytes; offset += page) {
+            bytesOut[offset] = 0;
+        }
+        return;
+    }
+    const volatile char* bytesIn = static_cast<const volatile char*>(data);
+    char sink = 0;
+    for (std::size_t offset = 0; offset < bytes; offset += page) {
+        sink ^= bytesIn[offset];
+    }
+    (void)sink;
+}
+
+void* allocateLarge(std::size_t bytes) {
+    MemoryPolicy policy = memoryPolicy();
+    std::size_t length = mappingLength(bytes);
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+#ifdef MAP_HUGETLB
+    // Needs pages reserved in /proc/sys/vm/nr_hugepages; fails otherwise
+    if (policy.hugePages) {
+        int hugeFlags = flags | MAP_HUGETLB;
+#ifdef MAP_POPULATE
+        hugeFlags |= policy.prefault ? MAP_POPULATE : 0;
+#endif
+        void* mapping = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, hugeFlags, -1, 0);
+        if (mapping != MAP_FAILED) {
+            ++hugeTlbCount;
+            return mapping;
+        }
+    }
+#endif
+
+    // Populating before madvise would fault in small pages, so with huge
+    // pages requested the range is advised first and touched afterwards
+    bool populated = false;
+#ifdef MAP_POPULATE
+    if (policy.prefault && !policy.hugePages) {
+        flags |= MAP_POPULATE;
+        populated = true;
+    }
+#endif
+    void* mapping = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (mapping == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+    bool transparent = false;
+#ifdef MADV_HUGEPAGE
+    if (policy.hugePages) {
+        transparent = ::madvise(mapping, length, MADV_HUGEPAGE) == 0;
+    }
+#endif
+    ++(transparent ? transparentCount : regularCount);
+    if (policy.prefault && !populated) {
+        prefaultPages(mapping, length, true);
+    }
+    return mapping;
+}
+
+void deallocateLarge(void* pointer, std::size_t bytes) noexcept {
+    if (pointer != nullptr) {
+        ::munmap(pointer, mappingLength(bytes));
+    }
+}
+
+LargeAllocationStats largeAllocationStats() {
+    LargeAllocationStats stats;
+    stats.hugeTlb = hugeTlbCount;
+    stats.transparent = transparentCount;
+    stats.regular = regularCount;
+    return stats;
+}
+
+} // namespace util
+} // namespace pricing
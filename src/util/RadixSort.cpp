@@ -0,0 +1,92 @@
+#include <algorithm>
+
+#include "../../include/pricing/util/Parallel.hpp"
+#include "../../include/pricing/util/RadixSort.hpp"
+
+namespace pricing {
+namespace util {
+
+namespace {
+    const unsigned digitBits = 11;
+    const std::size_t bucketCount = std::size_t(1) << digitBits;
+    const unsigned passCount = (64 + digitBits - 1) / digitBits;
+    const std::size_t minChunk = 16384;
+}
+
+void radixSortIndices(std::vector<std::uint32_t>& order, const std::vector<std::uint64_t>& keys,
+                      unsigned numThreads) {
+    std::size_t n = order.size();
+    if (n < 2) {
+        return;
+    }
+    std::size_t chunks = std::min<std::size_t>(resolveThreadCount(numThreads), (n + minChunk - 1) / minChunk);
+    std::size_t chunkSize = (n + chunks - 1) / chunks;
+
+    // Sort (key, index) pairs so every pass streams through contiguous keys
+    std::vector<std::uint64_t> current(n), nextKeys(n);
+    std::vector<std::uint32_t> nextOrder(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        current[i] = keys[order[i]];
+    }
+
+    // Histograms of all digits in one read find the passes that can be skipped
+    std::vector<std::size_t> digitCounts(chunks * passCount * bucketCount, 0);
+    parallelFor(chunks, numThreads, [&](std::size_t c) {
+        std::size_t* counts = digitCounts.data() + c * passCount * bucketCount;
+        std::size_t end = std::min(n, (c + 1) * chunkSize);
+        for (std::size_t i = c * chunkSize; i < end; ++i) {
+            for (unsigned pass = 0; pass < passCount; ++pass) {
+                ++counts[pass * bucketCount + ((current[i] >> (pass * digitBits)) & (bucketCount - 1))];
+            }
+        }
+    });
+
+    std::vector<std::size_t> histograms(chunks * bucketCount);
+    std::vector<std::size_t> offsets(chunks * bucketCount);
+    for (unsigned pass = 0; pass < passCount; ++pass) {
+        std::size_t shift = pass * digitBits;
+        bool trivial = false;
+        for (std::size_t b = 0; b < bucketCount && !trivial; ++b) {
+            std::size_t total = 0;
+            for (std::size_t c = 0; c < chunks; ++c) {
+                total += digitCounts[(c * passCount + pass) * bucketCount + b];
+            }
+            trivial = total == n;
+        }
+        if (trivial) {
+            continue;
+        }
+
+        // Chunk histograms of this digit in the current arrangement
+        parallelFor(chunks, numThreads, [&](std::size_t c) {
+            std::size_t* counts = histograms.data() + c * bucketCount;
+            std::fill(counts, counts + bucketCount, 0);
+            std::size_t end = std::min(n, (c + 1) * chunkSize);
+            for (std::size_t i = c * chunkSize; i < end; ++i) {
+                ++counts[(current[i] >> shift) & (bucketCount - 1)];
+            }
+        });
+        std::size_t running = 0;
+        for (std::size_t b = 0; b < bucketCount; ++b) {
+            for (std::size_t c = 0; c < chunks; ++c) {
+                offsets[c * bucketCount + b] = running;
+                running += histograms[c * bucketCount + b];
+            }
+        }
+
+        parallelFor(chunks, numThreads, [&](std::size_t c) {
+            std::size_t* position = offsets.data() + c * bucketCount;
+            std::size_t end = std::min(n, (c + 1) * chunkSize);
+            for (std::size_t i = c * chunkSize; i < end; ++i) {
+                std::size_t target = position[(current[i] >> shift) & (bucketCount - 1)]++;
+                nextKeys[target] = current[i];
+                nextOrder[target] = order[i];
+            }
+        });
+        current.swap(nextKeys);
+        order.swap(nextOrder);
+    }
+}
+
+} // namespace util
+} // namespace pricing
@@ -0,0 +1,106 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../include/pricing/util/AsyncFileIO.hpp"
+
+using namespace pricing;
+using namespace pricing::util;
+
+namespace {
+    std::vector<IoBackend> availableBackends() {
+        std::vector<IoBackend> backends = {IoBackend::Threads};
+        if (AsyncFileIO::ioUringAvailable()) {
+            backends.push_back(IoBackend::IoUring);
+        }
+        return backends;
+    }
+
+    std::string contents(std::size_t index) {
+        std::size_t length = index == 0 ? 0 : index == 1 ? (3u << 20) + 17 : 100 * index;
+        std::string text(length, ' ');
+        for (std::size_t i = 0; i < length; ++i) {
+            text[i] = static_cast<char>('a' + (i * 7 + index) % 26);
+        }
+        return text;
+    }
+}
+
+TEST_CASE("Async file I/O: Writes and reads back more files than the queue depth", "[util]") {
+    const std::size_t files = 20;
+    for (IoBackend backend : availableBackends()) {
+        AsyncIoSettings settings;
+        settings.backend = backend;
+        settings.queueDepth = 4;
+        settings.ioThreads = 2;
+        AsyncFileIO io(settings);
+        REQUIRE(io.backend() == backend);
+
+        auto path = [](std::size_t i) { return "test_async_io_" + std::to_string(i) + ".txt"; };
+        for (std::size_t i = 0; i < files; ++i) {
+            io.write(path(i), contents(i), i);
+        }
+        std::size_t written = 0;
+        IoCompletion completion;
+        while (io.next(completion)) {
+            REQUIRE(completion.write);
+            REQUIRE(completion.error.empty());
+            ++written;
+        }
+        REQUIRE(written == files);
+
+        for (std::size_t i = 0; i < files; ++i) {
+            io.read(path(i), i);
+        }
+        std::map<std::uint64_t, std::string> read;
+        while (io.next(completion)) {
+            REQUIRE_FALSE(completion.write);
+            REQUIRE(completion.error.empty());
+            read[completion.tag] = std::move(completion.data);
+        }
+        REQUIRE(io.outstanding() == 0);
+        REQUIRE(read.size() == files);
+        for (std::size_t i = 0; i < files; ++i) {
+            REQUIRE(read[i] == contents(i));
+            std::remove(path(i).c_str());
+        }
+    }
+}
+
+TEST_CASE("Async file I/O: Failed requests complete with an error", "[util]") {
+    for (IoBackend backend : availableBackends()) {
+        AsyncIoSettings settings;
+        settings.backend = backend;
+        AsyncFileIO io(settings);
+
+        io.read("test_async_io_missing.txt", 1);
+        io.write("test_async_io_missing_dir/out.txt", "data", 2);
+        IoCompletion completion;
+        std::size_t failures = 0;
+        while (io.next(completion)) {
+            REQUIRE_FALSE(completion.error.empty());
+            REQUIRE(completion.data.empty());
+            ++failures;
+        }
+        REQUIRE(failures == 2);
+    }
+}
+
+TEST_CASE("Async file I/O: Validation", "[validation]") {
+    AsyncIoSettings settings;
+    settings.queueDepth = 0;
+    REQUIRE_THROWS_AS(AsyncFileIO(settings), std::invalid_argument);
+
+    settings = AsyncIoSettings();
+    settings.ioThreads = 0;
+    REQUIRE_THROWS_AS(AsyncFileIO(settings), std::invalid_argument);
+
+    if (!AsyncFileIO::ioUringAvailable()) {
+        settings = AsyncIoSettings();
+        settings.backend = IoBackend::IoUring;
+        REQUIRE_THROWS_AS(AsyncFileIO(settings), std::runtime_error);
+    }
+}
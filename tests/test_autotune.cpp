@@ -0,0 +1,100 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include "../include/pricing/batch/AutoTuner.hpp"
+
+using namespace pricing;
+using namespace pricing::batch;
+
+namespace {
+    std::string temporaryPath(const std::string& name) {
+        std::string path = "test_autotune_" + name;
+        std::remove(path.c_str());
+        return path;
+    }
+}
+
+TEST_CASE("Autotune: Kernels give identical results", "[batch]") {
+    core::OptionBatch batch = AutoTuner::syntheticBatch(5000, 9);
+    BatchSettings grouped;
+    grouped.withGreeks = true;
+    grouped.reorder = true;
+    BatchSettings perRow = grouped;
+    perRow.kernel = BatchKernel::PerRow;
+
+    auto a = BatchEngine(grouped).price(batch);
+    auto b = BatchEngine(perRow).price(batch);
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        REQUIRE(a[i].price == b[i].price);
+        REQUIRE(a[i].gamma == b[i].gamma);
+        REQUIRE(a[i].theta == b[i].theta);
+    }
+}
+
+TEST_CASE("Autotune: Calibration picks a valid configuration for this host", "[batch]") {
+    AutotuneSettings settings;
+    settings.rows = 20000;
+    settings.repetitions = 1;
+    TuningProfile profile = AutoTuner(settings).calibrate();
+
+    REQUIRE(profile.numThreads >= 1);
+    REQUIRE(profile.numThreads <= profile.hardwareThreads);
+    REQUIRE(profile.chunkSize > 0);
+    REQUIRE(profile.rowsPerSecond > 0.0);
+    REQUIRE(profile.matchesHost());
+
+    BatchSettings batchSettings;
+    batchSettings.withGreeks = true;
+    profile.apply(batchSettings);
+    REQUIRE(batchSettings.chunkSize == profile.chunkSize);
+    REQUIRE(batchSettings.withGreeks);
+}
+
+TEST_CASE("Autotune: Profile round trip", "[batch]") {
+    std::string path = temporaryPath("roundtrip.profile");
+    TuningProfile profile;
+    profile.numThreads = 6;
+    profile.chunkSize = 16384;
+    profile.kernel = BatchKernel::PerRow;
+    profile.reorder = true;
+    profile.rowsPerSecond = 1234567.0;
+    profile.host = "pricer-07";
+    profile.hardwareThreads = 12;
+    profile.save(path);
+
+    TuningProfile loaded = TuningProfile::load(path);
+    REQUIRE(loaded.numThreads == 6);
+    REQUIRE(loaded.chunkSize == 16384);
+    REQUIRE(loaded.kernel == BatchKernel::PerRow);
+    REQUIRE(loaded.reorder);
+    REQUIRE(loaded.rowsPerSecond == 1234567.0);
+    REQUIRE(loaded.host == "pricer-07");
+    REQUIRE(loaded.hardwareThreads == 12);
+    REQUIRE_FALSE(loaded.matchesHost());
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Autotune: Validation", "[validation]") {
+    AutotuneSettings settings;
+    settings.rows = 0;
+    REQUIRE_THROWS_AS(AutoTuner(settings), std::invalid_argument);
+
+    REQUIRE_THROWS_AS(TuningProfile::load(temporaryPath("missing.profile")), std::runtime_error);
+
+    std::string path = temporaryPath("invalid.profile");
+    {
+        std::ofstream file(path);
+        file << "# option-pricing tuning profile v1\nkernel=simd\n";
+    }
+    REQUIRE_THROWS_AS(TuningProfile::load(path), std::runtime_error);
+    {
+        std::ofstream file(path);
+        file << "threads=4\n";
+    }
+    REQUIRE_THROWS_AS(TuningProfile::load(path), std::runtime_error);
+    std::remove(path.c_str());
+}
@@ -1,4 +1,6 @@
 #include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+#include <cstdlib>
 #include <filesystem>
 #include <fstream>
 #include <sstream>
@@ -99,3 +101,29 @@ TEST_CASE("Batch processing: Output CSV with Greeks", "[batch]") {
     REQUIRE(outputRows[0][10] == "theta");
     REQUIRE(outputRows[0][11] == "rho");
 }
+
+TEST_CASE("Batch processing: Input read from a pipe", "[batch]") {
+    std::string input = "test_pipe_input.csv", piped = "test_pipe_output.csv", mapped = "test_mapped_output.csv";
+    {
+        std::ofstream inputFile(input);
+        inputFile << "type,spot,strike,rate,vol,maturity\n";
+        inputFile << "call,100.0,105.0,0.05,0.2,0.5\n";
+        inputFile << "put,100.0,95.0,0.05,0.2,0.25\n";
+    }
+    std::string cli = PRICING_CLI_PATH;
+    REQUIRE(std::system(("cat " + input + " | " + cli + " --batch-input /dev/stdin --batch-output " + piped
+                         + " > /dev/null").c_str()) == 0);
+    REQUIRE(std::system((cli + " --batch-input " + input + " --batch-output " + mapped + " > /dev/null").c_str()) == 0);
+
+    std::ifstream pipedFile(piped), mappedFile(mapped);
+    std::stringstream pipedText, mappedText;
+    pipedText << pipedFile.rdbuf();
+    mappedText << mappedFile.rdbuf();
+    REQUIRE(parseCSV(pipedText.str()).size() == 3);
+    REQUIRE(pipedText.str() == mappedText.str());
+
+    for (const auto& path : {input, piped, mapped}) {
+        std::remove(path.c_str());
+        std::remove((path + ".rowhash").c_str());
+    }
+}
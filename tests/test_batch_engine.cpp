@@ -0,0 +1,126 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include "../include/pricing/batch/BatchEngine.hpp"
+#include "../include/pricing/models/BlackScholesModel.hpp"
+#include "../include/pricing/util/RadixSort.hpp"
+
+using namespace pricing;
+using namespace pricing::batch;
+using namespace pricing::core;
+
+namespace {
+    // Option chains on a few underlyings, shuffled like an unsorted input file
+    OptionBatch randomBatch(std::size_t count, std::uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> pick(0, 7);
+        const double spots[] = {42.0, 100.0, 250.0};
+        const double maturities[] = {0.0, 0.25, 0.5, 1.0, 2.0};
+
+        OptionBatch batch;
+        for (std::size_t i = 0; i < count; ++i) {
+            double spot = spots[pick(rng) % 3];
+            double strike = spot * (0.7 + 0.05 * pick(rng));
+            double maturity = maturities[pick(rng) % 5];
+            double vol = pick(rng) == 0 ? 0.0 : 0.2;
+            OptionType type = pick(rng) % 2 == 0 ? OptionType::Call : OptionType::Put;
+            batch.add(Option(type, strike, maturity), MarketData(spot, 0.03, vol));
+        }
+        return batch;
+    }
+
+    bool sameResult(const PricingResult& a, const PricingResult& b) {
+        return a.price == b.price && a.delta == b.delta && a.gamma == b.gamma
+            && a.vega == b.vega && a.theta == b.theta && a.rho == b.rho;
+    }
+}
+
+TEST_CASE("Batch engine: Radix sort matches a stable sort", "[batch]") {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> pick(-50, 50);
+    std::vector<double> values(100000);
+    for (auto& value : values) {
+        value = pick(rng) * 0.25;
+    }
+    values[3] = -0.0;
+    values[4] = 0.0;
+
+    std::vector<std::uint64_t> keys(values.size());
+    std::vector<std::uint32_t> expected(values.size());
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        keys[i] = util::sortableKey(values[i]);
+        expected[i] = static_cast<std::uint32_t>(i);
+    }
+    std::stable_sort(expected.begin(), expected.end(),
+                     [&](std::uint32_t a, std::uint32_t b) { return values[a] < values[b]; });
+
+    for (unsigned threads : {1u, 4u}) {
+        std::vector<std::uint32_t> order(values.size());
+        for (std::size_t i = 0; i < order.size(); ++i) {
+            order[i] = static_cast<std::uint32_t>(i);
+        }
+        util::radixSortIndices(order, keys, threads);
+        REQUIRE(order == expected);
+    }
+}
+
+TEST_CASE("Batch engine: Locality order groups underlying and maturity", "[batch]") {
+    OptionBatch batch = randomBatch(5000, 3);
+    auto order = BatchEngine::localityOrder(batch, 2);
+
+    REQUIRE(order.size() == batch.size());
+    for (std::size_t k = 1; k < order.size(); ++k) {
+        std::uint32_t a = order[k - 1], b = order[k];
+        auto lhs = std::make_tuple(batch.spots[a], batch.maturities[a], batch.strikes[a], a);
+        auto rhs = std::make_tuple(batch.spots[b], batch.maturities[b], batch.strikes[b], b);
+        REQUIRE(lhs < rhs);
+    }
+}
+
+TEST_CASE("Batch engine: Results match single-option pricing in input order", "[batch]") {
+    OptionBatch batch = randomBatch(20000, 11);
+    models::BlackScholesModel model;
+
+    for (bool reorder : {false, true}) {
+        BatchSettings settings;
+        settings.reorder = reorder;
+        settings.withGreeks = true;
+        settings.chunkSize = 1000;
+        auto results = BatchEngine(settings).price(batch);
+
+        REQUIRE(results.size() == batch.size());
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            Option option(batch.types[i], batch.strikes[i], batch.maturities[i]);
+            MarketData marketData(batch.spots[i], batch.rates[i], batch.volatilities[i]);
+            REQUIRE(sameResult(results[i], model.priceWithGreeks(option, marketData)));
+        }
+    }
+}
+
+TEST_CASE("Batch engine: Result does not depend on thread count", "[batch]") {
+    OptionBatch batch = randomBatch(30000, 5);
+    BatchSettings single;
+    single.reorder = true;
+    single.numThreads = 1;
+    BatchSettings multi = single;
+    multi.numThreads = 4;
+
+    auto a = BatchEngine(single).price(batch);
+    auto b = BatchEngine(multi).price(batch);
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        REQUIRE(sameResult(a[i], b[i]));
+    }
+}
+
+TEST_CASE("Batch engine: Validation", "[validation]") {
+    BatchSettings settings;
+    settings.chunkSize = 0;
+    REQUIRE_THROWS_AS(BatchEngine(settings), std::invalid_argument);
+    REQUIRE(BatchEngine().price(OptionBatch()).empty());
+}
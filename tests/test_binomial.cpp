@@ -0,0 +1,121 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <cmath>
+
+#include "../include/pricing/core/MarketData.hpp"
+#include "../include/pricing/core/Option.hpp"
+#include "../include/pricing/models/BinomialTreeModel.hpp"
+
+using namespace pricing;
+using namespace pricing::core;
+using namespace pricing::models;
+using Catch::Matchers::WithinAbs;
+
+namespace {
+    double blackScholes(bool isCall, double S, double K, double r, double sigma, double T) {
+        auto cdf = [](double x) { return 0.5 * std::erfc(-x / std::sqrt(2.0)); };
+        double volSqrtT = sigma * std::sqrt(T);
+        double d1 = (std::log(S / K) + (r + 0.5 * sigma * sigma) * T) / volSqrtT;
+        double d2 = d1 - volSqrtT;
+        double discountFactor = std::exp(-r * T);
+        if (isCall) {
+            return S * cdf(d1) - K * discountFactor * cdf(d2);
+        }
+        return K * discountFactor * cdf(-d2) - S * cdf(-d1);
+    }
+
+    BinomialTreeModel tree(BinomialTree type, std::size_t steps) {
+        BinomialTreeSettings settings;
+        settings.tree = type;
+        settings.steps = steps;
+        return BinomialTreeModel(settings);
+    }
+}
+
+TEST_CASE("Binomial: Leisen-Reimer with 100 steps matches a 2000-step CRR tree", "[binomial]") {
+    MarketData marketData(100.0, 0.05, 0.25);
+    auto leisenReimer = tree(BinomialTree::LeisenReimer, 100);
+    auto fineCrr = tree(BinomialTree::CoxRossRubinstein, 2000);
+    auto coarseCrr = tree(BinomialTree::CoxRossRubinstein, 100);
+
+    for (double K : {90.0, 100.0, 115.0}) {
+        for (auto type : {OptionType::Call, OptionType::Put}) {
+            Option option(type, K, 0.75);
+            double expected = blackScholes(type == OptionType::Call, 100.0, K, 0.05, 0.25, 0.75);
+            double lrError = std::abs(leisenReimer.price(option, marketData).price - expected);
+            double fineError = std::abs(fineCrr.price(option, marketData).price - expected);
+            double coarseError = std::abs(coarseCrr.price(option, marketData).price - expected);
+
+            REQUIRE(lrError < 1e-3);
+            REQUIRE(lrError < fineError + 1e-4);
+            REQUIRE(lrError * 5.0 < coarseError);
+        }
+    }
+}
+
+TEST_CASE("Binomial: Leisen-Reimer converges smoothly", "[binomial]") {
+    Option option(OptionType::Put, 100.0, 1.0);
+    MarketData marketData(100.0, 0.05, 0.2);
+    double expected = blackScholes(false, 100.0, 100.0, 0.05, 0.2, 1.0);
+
+    // Second order: doubling the steps cuts the error roughly by four
+    double previous = std::abs(tree(BinomialTree::LeisenReimer, 51).price(option, marketData).price - expected);
+    for (std::size_t steps : {101, 201, 401}) {
+        double error = std::abs(tree(BinomialTree::LeisenReimer, steps).price(option, marketData).price - expected);
+        REQUIRE(error * 3.0 < previous);
+        previous = error;
+    }
+}
+
+TEST_CASE("Binomial: American put", "[binomial]") {
+    // Converged reference values (K = 40, r = 0.06, sigma = 0.2, T = 1)
+    auto model = tree(BinomialTree::LeisenReimer, 201);
+    const double spots[] = {36.0, 40.0, 44.0};
+    const double expected[] = {4.4867, 2.3196, 1.1130};
+    for (int k = 0; k < 3; ++k) {
+        Option option(OptionType::Put, 40.0, 1.0, ExerciseStyle::American);
+        MarketData marketData(spots[k], 0.06, 0.2);
+        REQUIRE_THAT(model.price(option, marketData).price, WithinAbs(expected[k], 3e-3));
+    }
+}
+
+TEST_CASE("Binomial: Greeks from the first tree nodes", "[binomial][greeks]") {
+    double S = 100.0, K = 105.0, r = 0.04, sigma = 0.3, T = 0.5;
+    MarketData marketData(S, r, sigma);
+    auto model = tree(BinomialTree::LeisenReimer, 201);
+
+    for (auto type : {OptionType::Call, OptionType::Put}) {
+        bool isCall = type == OptionType::Call;
+        auto result = model.price(Option(type, K, T), marketData);
+
+        double h = 0.01 * S;
+        double up = blackScholes(isCall, S + h, K, r, sigma, T);
+        double mid = blackScholes(isCall, S, K, r, sigma, T);
+        double down = blackScholes(isCall, S - h, K, r, sigma, T);
+        double delta = (up - down) / (2.0 * h);
+        double gamma = (up - 2.0 * mid + down) / (h * h);
+        double theta = r * mid - r * S * delta - 0.5 * sigma * sigma * S * S * gamma;
+
+        REQUIRE_THAT(result.delta, WithinAbs(delta, 2e-3));
+        REQUIRE_THAT(result.gamma, WithinAbs(gamma, 2e-4));
+        REQUIRE_THAT(result.theta, WithinAbs(theta, 0.05));
+    }
+
+    // American Greeks agree with bumping the same tree
+    Option american(OptionType::Put, K, T, ExerciseStyle::American);
+    auto result = model.price(american, marketData);
+    double h = 0.5;
+    double up = model.price(american, MarketData(S + h, r, sigma)).price;
+    double down = model.price(american, MarketData(S - h, r, sigma)).price;
+    REQUIRE_THAT(result.delta, WithinAbs((up - down) / (2.0 * h), 5e-3));
+    REQUIRE_THAT(result.gamma, WithinAbs((up - 2.0 * result.price + down) / (h * h), 2e-3));
+}
+
+TEST_CASE("Binomial: Validation", "[validation]") {
+    BinomialTreeSettings settings;
+    settings.steps = 1;
+    REQUIRE_THROWS_AS(BinomialTreeModel(settings), std::invalid_argument);
+    REQUIRE_THROWS_AS(BinomialTreeModel().price(Option(OptionType::Call, 100.0, 1.0), MarketData(100.0, 0.05, 0.0)),
+                      std::invalid_argument);
+}
@@ -177,6 +177,14 @@ TEST_CASE("Black-Scholes: Validation - negative volatility", "[validation]") {
     );
 }
 
+TEST_CASE("Black-Scholes: Validation - American exercise", "[validation]") {
+    BlackScholesModel model;
+    Option option(OptionType::Put, 100.0, 1.0, ExerciseStyle::American);
+    MarketData marketData(100.0, 0.05, 0.2);
+    REQUIRE_THROWS_AS(model.price(option, marketData), std::invalid_argument);
+    REQUIRE_THROWS_AS(model.priceWithGreeks(option, marketData), std::invalid_argument);
+}
+
 TEST_CASE("Black-Scholes: Known reference values", "[black_scholes]") {
     // Reference values from standard Black-Scholes calculators
     // S=100, K=105, r=0.05, σ=0.2, T=0.5, Call
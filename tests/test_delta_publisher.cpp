@@ -0,0 +1,100 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+
+#include "../include/pricing/batch/DeltaPublisher.hpp"
+
+using namespace pricing;
+using namespace pricing::batch;
+
+namespace {
+    core::PricingResult result(double price, double delta = 0.5) {
+        core::PricingResult value;
+        value.price = price;
+        value.delta = delta;
+        return value;
+    }
+}
+
+TEST_CASE("Delta publication: Only material changes are published", "[batch]") {
+    PublicationSettings settings;
+    settings.threshold = 0.01;
+    DeltaPublisher publisher(settings);
+    auto instrument = util::contentKey("call|100|0.5");
+
+    REQUIRE(publisher.update(instrument, result(5.0)));
+    REQUIRE_FALSE(publisher.update(instrument, result(5.005)));
+    REQUIRE_FALSE(publisher.update(instrument, result(5.0, 0.505)));
+    REQUIRE(publisher.update(instrument, result(5.0, 0.52)));
+    REQUIRE(publisher.size() == 1);
+}
+
+TEST_CASE("Delta publication: Slow drift is published once it adds up", "[batch]") {
+    PublicationSettings settings;
+    settings.threshold = 0.01;
+    DeltaPublisher publisher(settings);
+    auto instrument = util::contentKey("put|95|0.25");
+
+    REQUIRE(publisher.update(instrument, result(2.0)));
+    int publications = 0;
+    for (int step = 1; step <= 10; ++step) {
+        publications += publisher.update(instrument, result(2.0 + 0.004 * step)) ? 1 : 0;
+    }
+    // Compared with the last published value, not the previous run
+    REQUIRE(publications == 3);
+}
+
+TEST_CASE("Delta publication: Greeks can be ignored", "[batch]") {
+    PublicationSettings settings;
+    settings.threshold = 0.01;
+    settings.trackGreeks = false;
+    DeltaPublisher publisher(settings);
+    auto instrument = util::contentKey("call|100|1");
+
+    REQUIRE(publisher.update(instrument, result(5.0, 0.5)));
+    REQUIRE_FALSE(publisher.update(instrument, result(5.0, 0.9)));
+}
+
+TEST_CASE("Delta publication: State persists across runs", "[batch]") {
+    std::string path = "test_publication.state";
+    std::remove(path.c_str());
+
+    DeltaPublisher first;
+    first.load(path);   // Missing file: start empty
+    for (int i = 0; i < 3000; ++i) {
+        REQUIRE(first.update(util::contentKey("instrument-" + std::to_string(i)), result(i)));
+    }
+    first.save(path);
+
+    DeltaPublisher second;
+    second.load(path);
+    std::remove(path.c_str());
+
+    REQUIRE(second.size() == 3000);
+    REQUIRE_FALSE(second.update(util::contentKey("instrument-7"), result(7.0)));
+    REQUIRE(second.update(util::contentKey("instrument-7"), result(8.0)));
+    REQUIRE(second.update(util::contentKey("instrument-new"), result(1.0)));
+}
+
+TEST_CASE("Delta publication: A failed save keeps the previous state", "[batch]") {
+    std::string path = "test_publication_keep.state";
+    DeltaPublisher publisher;
+    REQUIRE(publisher.update(util::contentKey("instrument"), result(1.0)));
+    publisher.save(path);
+
+    // The temporary file cannot be created where a directory is in the way
+    std::string temporary = path + ".tmp";
+    std::filesystem::remove(temporary);
+    REQUIRE(std::filesystem::create_directory(temporary));
+    REQUIRE(publisher.update(util::contentKey("other"), result(2.0)));
+    REQUIRE_THROWS_AS(publisher.save(path), std::runtime_error);
+    std::filesystem::remove(temporary);
+
+    DeltaPublisher restored;
+    restored.load(path);
+    std::remove(path.c_str());
+    REQUIRE(restored.size() == 1);
+}
@@ -0,0 +1,338 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "../include/pricing/batch/DistributedBatch.hpp"
+
+using namespace pricing;
+using namespace pricing::batch;
+using namespace pricing::core;
+
+namespace {
+    // A worker served on its own thread for the lifetime of the test
+    struct LocalWorker {
+        ShardWorker worker;
+        std::thread thread;
+
+        explicit LocalWorker(const BatchSettings& settings = BatchSettings())
+            : worker(WorkerAddress{"127.0.0.1", 0}, settings) {
+            thread = std::thread([this]() { worker.serve(); });
+        }
+
+        ~LocalWorker() {
+            worker.stop();
+            thread.join();
+        }
+
+        WorkerAddress address() const { return WorkerAddress{"127.0.0.1", worker.port()}; }
+    };
+
+    // Accepts one connection, reads the start of the first shard and hangs up
+    struct CrashingWorker {
+        int listener = -1;
+        std::uint16_t port = 0;
+        std::thread thread;
+
+        CrashingWorker() {
+            listener = ::socket(AF_INET, SOCK_STREAM, 0);
+            sockaddr_in address{};
+            address.sin_family = AF_INET;
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            ::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+            ::listen(listener, 1);
+            socklen_t length = sizeof(address);
+            ::getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length);
+            port = ntohs(address.sin_port);
+            thread = std::thread([this]() {
+                int connection = ::accept(listener, nullptr, nullptr);
+                char header[16];
+                ::recv(connection, header, sizeof(header), MSG_WAITALL);
+                ::close(connection);
+            });
+        }
+
+        ~CrashingWorker() {
+            thread.join();
+            ::close(listener);
+        }
+
+        WorkerAddress address() const { return WorkerAddress{"127.0.0.1", port}; }
+    };
+
+    // Accepts one connection and reads whatever arrives without ever
+    // answering, until the coordinator hangs up
+    struct SilentWorker {
+        int listener = -1;
+        std::uint16_t port = 0;
+        std::thread thread;
+
+        SilentWorker() {
+            listener = ::socket(AF_INET, SOCK_STREAM, 0);
+            sockaddr_in address{};
+            address.sin_family = AF_INET;
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            ::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+            ::listen(listener, 1);
+            socklen_t length = sizeof(address);
+            ::getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length);
+            port = ntohs(address.sin_port);
+            thread = std::thread([this]() {
+                int connection = ::accept(listener, nullptr, nullptr);
+                char buffer[4096];
+                while (::recv(connection, buffer, sizeof(buffer), 0) > 0) {
+                }
+                ::close(connection);
+            });
+        }
+
+        ~SilentWorker() {
+            thread.join();
+            ::close(listener);
+        }
+
+        WorkerAddress address() const { return WorkerAddress{"127.0.0.1", port}; }
+    };
+
+    // Connects to a worker and sends one frame header (magic, version, type,
+    // length) followed by payload; returns the socket
+    int sendFrame(std::uint16_t port, std::uint16_t type, std::uint64_t length, const std::string& payload) {
+        int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons(port);
+        REQUIRE(::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0);
+        std::string frame("PRSH", 4);
+        std::uint16_t version = 3;
+        frame.append(reinterpret_cast<const char*>(&version), sizeof(version));
+        frame.append(reinterpret_cast<const char*>(&type), sizeof(type));
+        frame.append(reinterpret_cast<const char*>(&length), sizeof(length));
+        frame += payload;
+        REQUIRE(::send(fd, frame.data(), frame.size(), 0) == static_cast<ssize_t>(frame.size()));
+        return fd;
+    }
+
+    // Type of the worker's answer, or 0 if it hung up
+    std::uint16_t answerType(int fd) {
+        char header[16];
+        if (::recv(fd, header, sizeof(header), MSG_WAITALL) != static_cast<ssize_t>(sizeof(header))) {
+            return 0;
+        }
+        std::uint16_t type;
+        std::memcpy(&type, header + 6, sizeof(type));
+        return type;
+    }
+
+    void makeBatch(std::size_t rows, OptionBatch& batch, std::vector<RowRequest>& requests) {
+        for (std::size_t i = 0; i < rows; ++i) {
+            batch.add(Option(i % 2 == 0 ? OptionType::Call : OptionType::Put, 80.0 + static_cast<double>(i % 41),
+                             0.25 + static_cast<double>(i % 4) * 0.25),
+                      MarketData(100.0, 0.05, 0.15 + static_cast<double>(i % 5) * 0.05));
+            RowRequest request;
+            request.model = i % 7 == 0 ? "binomial" : "black_scholes";
+            request.outputs = i % 3 == 0 ? OutputAll : OutputPrice;
+            requests.push_back(request);
+        }
+    }
+
+    void requireSame(const std::vector<PricingResult>& actual, const std::vector<PricingResult>& expected) {
+        REQUIRE(actual.size() == expected.size());
+        for (std::size_t i = 0; i < actual.size(); ++i) {
+            REQUIRE(actual[i].price == expected[i].price);
+            REQUIRE(actual[i].delta == expected[i].delta);
+            REQUIRE(actual[i].rho == expected[i].rho);
+        }
+    }
+}
+
+TEST_CASE("Distributed batch: Shards priced by workers merge in input order", "[batch]") {
+    OptionBatch batch;
+    std::vector<RowRequest> requests;
+    makeBatch(1050, batch, requests);
+    auto expected = ModelDispatcher().price(batch, requests);
+
+    LocalWorker first;
+    LocalWorker second;
+    DistributedSettings settings;
+    settings.shardRows = 100;
+    ShardCoordinator coordinator({first.address(), second.address()}, settings);
+    requireSame(coordinator.price(batch, requests), expected);
+    REQUIRE(first.worker.shardsPriced() + second.worker.shardsPriced() == 11);
+    REQUIRE(first.worker.shardsPriced() > 0);
+    REQUIRE(second.worker.shardsPriced() > 0);
+    REQUIRE(coordinator.reassignedShards() == 0);
+
+    // Workers serve the next coordinator connection
+    requireSame(coordinator.price(batch, requests), expected);
+    REQUIRE(coordinator.price(OptionBatch(), {}).empty());
+}
+
+TEST_CASE("Distributed batch: Shards of failed workers are reassigned", "[batch]") {
+    OptionBatch batch;
+    std::vector<RowRequest> requests;
+    makeBatch(500, batch, requests);
+    auto expected = ModelDispatcher().price(batch, requests);
+
+    LocalWorker good;
+    std::unique_ptr<ShardWorker> closed(new ShardWorker(WorkerAddress{"127.0.0.1", 0}));
+    WorkerAddress unreachable{"127.0.0.1", closed->port()};
+    closed.reset();                     // Nothing listens there any more
+    CrashingWorker crashing;
+
+    DistributedSettings settings;
+    settings.shardRows = 64;
+    ShardCoordinator coordinator({unreachable, crashing.address(), good.address()}, settings);
+    requireSame(coordinator.price(batch, requests), expected);
+    REQUIRE(coordinator.failedWorkers() == 2);
+    REQUIRE(coordinator.reassignedShards() == 1);
+    REQUIRE(good.worker.shardsPriced() == 8);
+}
+
+TEST_CASE("Distributed batch: Rows a worker rejects come back with their message", "[batch]") {
+    OptionBatch batch;
+    std::vector<RowRequest> requests;
+    makeBatch(200, batch, requests);
+    OptionBatch rejecting;
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        rejecting.add(Option(batch.types[i], batch.strikes[i], batch.maturities[i]),
+                      MarketData(batch.spots[i], batch.rates[i], i == 133 ? 0.0 : batch.volatilities[i]));
+    }
+    requests[133].model = "binomial";
+    std::vector<std::string> expectedErrors;
+    auto expected = ModelDispatcher().price(rejecting, requests, &expectedErrors);
+    REQUIRE_FALSE(expectedErrors[133].empty());
+
+    LocalWorker worker;
+    DistributedSettings settings;
+    settings.shardRows = 64;
+    ShardCoordinator coordinator({worker.address()}, settings);
+    std::vector<std::string> errors;
+    requireSame(coordinator.price(rejecting, requests, &errors), expected);
+    REQUIRE(errors == expectedErrors);
+}
+
+TEST_CASE("Distributed batch: Workers that stop answering are retired", "[batch]") {
+    REQUIRE(DistributedSettings().timeoutSeconds > 0.0);
+
+    OptionBatch batch;
+    std::vector<RowRequest> requests;
+    makeBatch(300, batch, requests);
+    auto expected = ModelDispatcher().price(batch, requests);
+
+    LocalWorker good;
+    SilentWorker silent;
+    DistributedSettings settings;
+    settings.shardRows = 64;
+    settings.timeoutSeconds = 0.2;
+    ShardCoordinator coordinator({silent.address(), good.address()}, settings);
+    requireSame(coordinator.price(batch, requests), expected);
+    REQUIRE(coordinator.failedWorkers() == 1);
+    REQUIRE(coordinator.reassignedShards() == 1);
+    REQUIRE(good.worker.shardsPriced() == 5);
+}
+
+TEST_CASE("Distributed batch: Shards longer than the timeout finish while the worker reports progress", "[batch]") {
+    OptionBatch batch;
+    std::vector<RowRequest> requests;
+    makeBatch(100, batch, requests);
+    for (auto& request : requests) {
+        request.model = "monte_carlo";
+    }
+
+    // The timeout is a fifth of what the shard takes on one thread
+    BatchSettings oneThread;
+    oneThread.numThreads = 1;
+    auto start = std::chrono::steady_clock::now();
+    auto expected = ModelDispatcher(oneThread).price(batch, requests);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    LocalWorker worker(oneThread);
+    DistributedSettings settings;
+    settings.timeoutSeconds = elapsed.count() / 5.0;
+    ShardCoordinator coordinator({worker.address()}, settings);
+    auto results = coordinator.price(batch, requests);
+    REQUIRE(coordinator.failedWorkers() == 0);
+    REQUIRE(results.size() == expected.size());
+    REQUIRE(results[0].price > 0.0);
+}
+
+TEST_CASE("Distributed batch: Failures that cannot be recovered", "[batch]") {
+    OptionBatch batch;
+    std::vector<RowRequest> requests;
+    makeBatch(10, batch, requests);
+
+    {
+        CrashingWorker crashing;
+        ShardCoordinator coordinator({crashing.address()});
+        REQUIRE_THROWS_AS(coordinator.price(batch, requests), std::runtime_error);
+    }
+
+    // A pricing error is reported, not retried
+    LocalWorker worker;
+    requests[3].model = "no_such_model";
+    ShardCoordinator coordinator({worker.address()});
+    REQUIRE_THROWS_AS(coordinator.price(batch, requests), std::runtime_error);
+    REQUIRE(coordinator.reassignedShards() == 0);
+}
+
+TEST_CASE("Distributed batch: Oversized and inconsistent frames are refused", "[batch]") {
+    LocalWorker worker;
+
+    // A length beyond any shard ends the connection before a payload is read
+    int oversized = sendFrame(worker.worker.port(), 1, std::uint64_t(1) << 40, "");
+    REQUIRE(answerType(oversized) == 0);
+    ::close(oversized);
+
+    // Shard 0 claiming more rows than its payload holds gets an error frame
+    std::string payload;
+    std::uint64_t shard = 0, rows = 100000;
+    std::uint32_t progress = 0, models = 1, nameLength = 13;
+    payload.append(reinterpret_cast<const char*>(&shard), sizeof(shard));
+    payload.append(reinterpret_cast<const char*>(&progress), sizeof(progress));
+    payload.append(reinterpret_cast<const char*>(&rows), sizeof(rows));
+    payload.append(reinterpret_cast<const char*>(&models), sizeof(models));
+    payload.append(reinterpret_cast<const char*>(&nameLength), sizeof(nameLength));
+    payload += "black_scholes";
+    int inconsistent = sendFrame(worker.worker.port(), 1, payload.size(), payload);
+    REQUIRE(answerType(inconsistent) == 3);
+    ::close(inconsistent);
+
+    // The worker keeps serving
+    OptionBatch batch;
+    std::vector<RowRequest> requests;
+    makeBatch(10, batch, requests);
+    requireSame(ShardCoordinator({worker.address()}).price(batch, requests), ModelDispatcher().price(batch, requests));
+    REQUIRE(worker.worker.shardsPriced() == 1);
+}
+
+TEST_CASE("Distributed batch: Validation", "[validation]") {
+    WorkerAddress address = parseWorkerAddress("node7:7100");
+    REQUIRE(address.host == "node7");
+    REQUIRE(address.port == 7100);
+    REQUIRE(parseWorkerAddress("7100", "0.0.0.0").host == "0.0.0.0");
+    REQUIRE(parseWorkerAddress("[::1]:80").host == "::1");
+    REQUIRE_THROWS_AS(parseWorkerAddress("node7:"), std::invalid_argument);
+    REQUIRE_THROWS_AS(parseWorkerAddress("node7:99999"), std::invalid_argument);
+    REQUIRE_THROWS_AS(parseWorkerAddress("node7:http"), std::invalid_argument);
+
+    REQUIRE_THROWS_AS(ShardCoordinator({}), std::invalid_argument);
+    DistributedSettings settings;
+    settings.shardRows = 0;
+    REQUIRE_THROWS_AS(ShardCoordinator({address}, settings), std::invalid_argument);
+    settings.shardRows = DistributedSettings::kMaxShardRows + 1;
+    REQUIRE_THROWS_AS(ShardCoordinator({address}, settings), std::invalid_argument);
+
+    ShardCoordinator coordinator({address});
+    OptionBatch batch;
+    std::vector<RowRequest> requests(1);
+    REQUIRE_THROWS_AS(coordinator.price(batch, requests), std::invalid_argument);
+}
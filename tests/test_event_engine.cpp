@@ -0,0 +1,162 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <map>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "../include/pricing/batch/EventEngine.hpp"
+#include "../include/pricing/models/BlackScholesModel.hpp"
+#include "../include/pricing/util/SpscQueue.hpp"
+
+using namespace pricing;
+using namespace pricing::batch;
+using namespace pricing::core;
+using Catch::Matchers::WithinAbs;
+
+namespace {
+    Option position(std::size_t i) {
+        return Option(i % 2 == 0 ? OptionType::Call : OptionType::Put,
+                      80.0 + static_cast<double>(i % 9) * 5.0, 0.25 + static_cast<double>(i % 4) * 0.25);
+    }
+
+    EventEngineSettings engineSettings(unsigned shards) {
+        EventEngineSettings settings;
+        settings.shards = shards;
+        settings.maxBatch = 16;
+        return settings;
+    }
+}
+
+TEST_CASE("SPSC queue: Transfers values in order between two threads", "[util]") {
+    util::SpscQueue<std::size_t> queue(100);
+    REQUIRE(queue.capacity() == 128);
+    REQUIRE(queue.empty());
+
+    for (std::size_t i = 0; i < queue.capacity(); ++i) {
+        REQUIRE(queue.tryPush(i));
+    }
+    REQUIRE_FALSE(queue.tryPush(0));
+    std::size_t value = 0;
+    for (std::size_t i = 0; i < queue.capacity(); ++i) {
+        REQUIRE(queue.tryPop(value));
+        REQUIRE(value == i);
+    }
+    REQUIRE_FALSE(queue.tryPop(value));
+
+    const std::size_t count = 200000;
+    std::thread producer([&]() {
+        for (std::size_t i = 0; i < count; ++i) {
+            while (!queue.tryPush(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    bool ordered = true;
+    for (std::size_t i = 0; i < count; ++i) {
+        while (!queue.tryPop(value)) {
+            std::this_thread::yield();
+        }
+        ordered = ordered && value == i;
+    }
+    producer.join();
+    REQUIRE(ordered);
+    REQUIRE(queue.empty());
+}
+
+TEST_CASE("Event engine: Last quote of every option prices the last tick", "[batch]") {
+    const std::size_t underlyings = 10;
+    const std::size_t options = 60;
+    EventEngine engine(engineSettings(4));
+    REQUIRE(engine.shards() == 4);
+    MarketData initial(100.0, 0.05, 0.2);
+    for (std::size_t i = 0; i < options; ++i) {
+        REQUIRE(engine.addOption(static_cast<std::uint32_t>(i % underlyings), position(i), initial) == i);
+    }
+    engine.start();
+
+    std::map<std::uint32_t, std::pair<double, std::uint64_t>> lastTick;
+    std::map<std::size_t, QuoteUpdate> lastQuote;
+    bool ordered = true;
+    auto drain = [&]() {
+        QuoteUpdate update;
+        while (engine.poll(update)) {
+            auto found = lastQuote.find(update.option);
+            ordered = ordered && (found == lastQuote.end() || found->second.sequence < update.sequence);
+            lastQuote[update.option] = update;
+        }
+    };
+
+    const std::size_t ticks = 3000;
+    for (std::size_t t = 0; t < ticks; ++t) {
+        std::uint32_t underlying = static_cast<std::uint32_t>((t * 7) % (underlyings + 2));  // Two have no options
+        double spot = 90.0 + static_cast<double>((t * 13) % 200) * 0.1;
+        engine.publish(Tick{underlying, spot});
+        lastTick[underlying] = {spot, t + 1};
+        if (t % 500 == 0) {
+            drain();
+        }
+    }
+    engine.flush();
+    REQUIRE(engine.ticksProcessed() == ticks);
+    drain();
+    engine.stop();
+    REQUIRE(engine.droppedQuotes() == 0);
+
+    REQUIRE(ordered);
+    REQUIRE(lastQuote.size() == options);
+    models::BlackScholesModel model;
+    for (std::size_t i = 0; i < options; ++i) {
+        std::uint32_t underlying = static_cast<std::uint32_t>(i % underlyings);
+        const QuoteUpdate& quote = lastQuote[i];
+        REQUIRE(quote.sequence == lastTick[underlying].second);
+        REQUIRE(quote.spot == lastTick[underlying].first);
+        PricingResult expected = model.priceWithGreeks(position(i), MarketData(quote.spot, 0.05, 0.2));
+        REQUIRE_THAT(quote.result.price, WithinAbs(expected.price, 1e-12));
+        REQUIRE_THAT(quote.result.delta, WithinAbs(expected.delta, 1e-12));
+        REQUIRE_THAT(quote.result.vega, WithinAbs(expected.vega, 1e-12));
+    }
+}
+
+TEST_CASE("Event engine: Stop drops quotes that no longer fit", "[batch]") {
+    EventEngineSettings settings = engineSettings(1);
+    settings.quoteCapacity = 2;
+    EventEngine engine(settings);
+    for (std::size_t i = 0; i < 10; ++i) {
+        engine.addOption(7, position(i), MarketData(100.0, 0.05, 0.2));
+    }
+    engine.start();
+    engine.publish(Tick{7, 101.0});
+    engine.stop();
+    REQUIRE(engine.ticksProcessed() == 1);
+    REQUIRE(engine.droppedQuotes() == 8);
+
+    QuoteUpdate update;
+    std::size_t queued = 0;
+    while (engine.poll(update)) {
+        REQUIRE(update.spot == 101.0);
+        ++queued;
+    }
+    REQUIRE(queued == 2);
+}
+
+TEST_CASE("Event engine: Validation", "[validation]") {
+    EventEngineSettings settings;
+    settings.tickCapacity = 0;
+    REQUIRE_THROWS_AS(EventEngine(settings), std::invalid_argument);
+    settings = EventEngineSettings();
+    settings.maxBatch = 0;
+    REQUIRE_THROWS_AS(EventEngine(settings), std::invalid_argument);
+
+    EventEngine engine(engineSettings(2));
+    MarketData marketData(100.0, 0.05, 0.2);
+    REQUIRE_THROWS_AS(engine.publish(Tick{0, 100.0}), std::logic_error);
+    REQUIRE_THROWS_AS(engine.addOption(0, Option(OptionType::Put, 100.0, 1.0, ExerciseStyle::American), marketData),
+                      std::invalid_argument);
+    engine.addOption(0, position(0), marketData);
+    engine.start();
+    REQUIRE_THROWS_AS(engine.start(), std::logic_error);
+    REQUIRE_THROWS_AS(engine.addOption(1, position(1), marketData), std::logic_error);
+    REQUIRE_THROWS_AS(engine.publish(Tick{0, 0.0}), std::invalid_argument);
+}
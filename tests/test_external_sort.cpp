@@ -0,0 +1,139 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include "../include/pricing/batch/BatchEngine.hpp"
+#include "../include/pricing/batch/ExternalSorter.hpp"
+
+using namespace pricing;
+using namespace pricing::batch;
+using namespace pricing::core;
+
+namespace {
+    std::vector<SortRecord> randomRecords(std::size_t count, std::uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> pick(0, 9);
+        const double spots[] = {42.0, 100.0, 250.0};
+        std::vector<SortRecord> records;
+        for (std::size_t i = 0; i < count; ++i) {
+            double spot = spots[pick(rng) % 3];
+            Option option(pick(rng) % 2 == 0 ? OptionType::Call : OptionType::Put,
+                          spot * (0.75 + 0.05 * pick(rng)), 0.25 * (1 + pick(rng) % 4));
+            records.push_back(ExternalSorter::localityRecord(i, option, MarketData(spot, 0.03, 0.25)));
+        }
+        return records;
+    }
+
+    std::vector<std::uint64_t> sortedRows(std::vector<SortRecord> records) {
+        std::sort(records.begin(), records.end(), [](const SortRecord& a, const SortRecord& b) {
+            return std::make_tuple(a.spot, a.maturity, a.strike, a.row)
+                < std::make_tuple(b.spot, b.maturity, b.strike, b.row);
+        });
+        std::vector<std::uint64_t> rows;
+        for (const auto& record : records) {
+            rows.push_back(record.row);
+        }
+        return rows;
+    }
+
+    std::vector<std::uint64_t> drain(ExternalSorter& sorter) {
+        std::vector<std::uint64_t> rows;
+        SortRecord record;
+        while (sorter.next(record)) {
+            rows.push_back(record.row);
+        }
+        return rows;
+    }
+}
+
+TEST_CASE("External sort: Input that fits in memory is not spilled", "[batch]") {
+    auto records = randomRecords(1000, 1);
+    ExternalSorter sorter;
+    for (const auto& record : records) {
+        sorter.add(record);
+    }
+    sorter.finish();
+
+    REQUIRE(sorter.spilledRuns() == 0);
+    REQUIRE(drain(sorter) == sortedRows(records));
+}
+
+TEST_CASE("External sort: Spilled runs merge into the full order", "[batch]") {
+    auto records = randomRecords(50000, 2);
+    auto expected = sortedRows(records);
+
+    // 500 records per run; a fan-in of 4 forces cascaded merges and a final
+    // merge of runs from several levels
+    for (std::size_t fanIn : {2u, 3u, 4u, 64u}) {
+        ExternalSortSettings settings;
+        settings.memoryLimit = 500 * sizeof(SortRecord);
+        settings.mergeFanIn = fanIn;
+        ExternalSorter sorter(settings);
+        for (const auto& record : records) {
+            sorter.add(record);
+        }
+        sorter.finish();
+
+        REQUIRE(sorter.spilledRuns() == 100);
+        REQUIRE(drain(sorter) == expected);
+    }
+}
+
+TEST_CASE("External sort: Sorted stream prices like the in-memory engine", "[batch]") {
+    auto records = randomRecords(20000, 3);
+    ExternalSortSettings settings;
+    settings.memoryLimit = 1000 * sizeof(SortRecord);
+    ExternalSorter sorter(settings);
+    OptionBatch batch;
+    for (const auto& record : records) {
+        sorter.add(record);
+        batch.add(record.option(), record.marketData());
+    }
+    sorter.finish();
+
+    BatchSettings batchSettings;
+    batchSettings.withGreeks = true;
+    batchSettings.chunkSize = 512;
+    BatchEngine engine(batchSettings);
+    auto expected = engine.price(batch);
+
+    std::vector<PricingResult> results(records.size());
+    std::vector<std::uint64_t> rows;
+    engine.priceSorted(sorter, [&](std::uint64_t row, const PricingResult& result) {
+        results[row] = result;
+        rows.push_back(row);
+    });
+
+    REQUIRE(rows == sortedRows(records));
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        REQUIRE(results[i].price == expected[i].price);
+        REQUIRE(results[i].delta == expected[i].delta);
+    }
+}
+
+TEST_CASE("External sort: Validation", "[validation]") {
+    ExternalSortSettings settings;
+    settings.mergeFanIn = 1;
+    REQUIRE_THROWS_AS(ExternalSorter(settings), std::invalid_argument);
+    settings = ExternalSortSettings();
+    settings.memoryLimit = 16;
+    REQUIRE_THROWS_AS(ExternalSorter(settings), std::invalid_argument);
+    settings = ExternalSortSettings();
+    settings.memoryLimit = 100 * sizeof(SortRecord);
+    settings.tempDirectory = "/nonexistent/directory";
+    ExternalSorter sorter(settings);
+    for (std::size_t i = 0; i < 99; ++i) {
+        sorter.add(ExternalSorter::localityRecord(i, Option(OptionType::Call, 100.0, 1.0), MarketData(100.0, 0.0, 0.2)));
+    }
+    REQUIRE_THROWS_AS(sorter.add(ExternalSorter::localityRecord(99, Option(OptionType::Call, 100.0, 1.0),
+                                                                 MarketData(100.0, 0.0, 0.2))),
+                      std::runtime_error);
+
+    ExternalSorter unfinished;
+    SortRecord record;
+    REQUIRE_THROWS_AS(unfinished.next(record), std::runtime_error);
+}
@@ -0,0 +1,217 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <cmath>
+#include <vector>
+
+#include "../include/pricing/core/HestonParameters.hpp"
+#include "../include/pricing/core/MarketData.hpp"
+#include "../include/pricing/core/Option.hpp"
+#include "../include/pricing/models/FiniteDifferenceModel.hpp"
+#include "../include/pricing/models/HestonAdiModel.hpp"
+#include "../include/pricing/models/HestonModel.hpp"
+#include "../include/pricing/numerics/Grid.hpp"
+#include "../include/pricing/numerics/TridiagonalSolver.hpp"
+
+using namespace pricing;
+using namespace pricing::core;
+using namespace pricing::models;
+using Catch::Matchers::WithinAbs;
+
+namespace {
+    double blackScholes(bool isCall, double S, double K, double r, double sigma, double T) {
+        auto cdf = [](double x) { return 0.5 * std::erfc(-x / std::sqrt(2.0)); };
+        double volSqrtT = sigma * std::sqrt(T);
+        double d1 = (std::log(S / K) + (r + 0.5 * sigma * sigma) * T) / volSqrtT;
+        double d2 = d1 - volSqrtT;
+        double discountFactor = std::exp(-r * T);
+        if (isCall) {
+            return S * cdf(d1) - K * discountFactor * cdf(d2);
+        }
+        return K * discountFactor * cdf(-d2) - S * cdf(-d1);
+    }
+}
+
+TEST_CASE("Numerics: Tridiagonal solve", "[finite_difference]") {
+    std::vector<double> lower = {0.0, -1.0, -1.0, -1.0};
+    std::vector<double> diag = {2.0, 2.0, 2.0, 2.0};
+    std::vector<double> upper = {-1.0, -1.0, -1.0, 0.0};
+    std::vector<double> expected = {1.0, 2.0, 3.0, 4.0};
+    std::vector<double> rhs = {0.0, 0.0, 0.0, 5.0};
+
+    numerics::TridiagonalSolver solver(4);
+    std::vector<double> x(4);
+    solver.solve(lower.data(), diag.data(), upper.data(), rhs.data(), x.data());
+
+    for (std::size_t k = 0; k < 4; ++k) {
+        REQUIRE_THAT(x[k], WithinAbs(expected[k], 1e-12));
+    }
+}
+
+TEST_CASE("Numerics: Sinh grid concentrates around the center", "[finite_difference]") {
+    auto grid = numerics::sinhGrid(0.0, 800.0, 100.0, 20.0, 100);
+
+    REQUIRE(grid.size() == 101);
+    REQUIRE(grid.front() == 0.0);
+    REQUIRE(grid.back() == 800.0);
+
+    auto stencil = numerics::interpolationStencil(grid, 100.0);
+    double spacingAtCenter = grid[stencil.first + 2] - grid[stencil.first + 1];
+    REQUIRE(spacingAtCenter < 0.5 * 800.0 / 100.0);
+    REQUIRE(grid[100] - grid[99] > 800.0 / 100.0);
+}
+
+TEST_CASE("Numerics: Grid concentrated around several centers", "[finite_difference]") {
+    auto grid = numerics::concentratedGrid(0.0, 4.0, {1.0, 1.5}, 0.1, 200);
+
+    REQUIRE(grid.size() == 201);
+    REQUIRE(grid.front() == 0.0);
+    REQUIRE(grid.back() == 4.0);
+    auto spacingAt = [&](double x) {
+        auto stencil = numerics::interpolationStencil(grid, x);
+        return grid[stencil.first + 2] - grid[stencil.first];
+    };
+    REQUIRE(spacingAt(1.0) * 3.0 < spacingAt(3.5));
+    REQUIRE(spacingAt(1.5) * 3.0 < spacingAt(3.5));
+}
+
+TEST_CASE("Finite difference: European prices match Black-Scholes", "[finite_difference]") {
+    FiniteDifferenceModel model;
+    for (double S : {80.0, 100.0, 125.0}) {
+        MarketData marketData(S, 0.05, 0.3);
+        for (auto type : {OptionType::Call, OptionType::Put}) {
+            Option option(type, 100.0, 0.5);
+            double expected = blackScholes(type == OptionType::Call, S, 100.0, 0.05, 0.3, 0.5);
+            REQUIRE_THAT(model.price(option, marketData).price, WithinAbs(expected, 2e-3));
+        }
+    }
+}
+
+TEST_CASE("Finite difference: Rannacher start-up smooths the payoff kink", "[finite_difference]") {
+    // Short-dated at-the-money option with large Crank-Nicolson steps
+    Option option(OptionType::Call, 100.0, 0.05);
+    MarketData marketData(100.0, 0.05, 0.2);
+    double expected = blackScholes(true, 100.0, 100.0, 0.05, 0.2, 0.05);
+
+    FiniteDifferenceSettings plain;
+    plain.timeSteps = 10;
+    plain.rannacherSteps = 0;
+    plain.concentration = 0.02;
+    FiniteDifferenceSettings smoothed = plain;
+    smoothed.rannacherSteps = 2;
+
+    double plainError = std::abs(FiniteDifferenceModel(plain).price(option, marketData).price - expected);
+    double smoothedError = std::abs(FiniteDifferenceModel(smoothed).price(option, marketData).price - expected);
+    REQUIRE(smoothedError < 2e-3);
+    REQUIRE(smoothedError * 2.0 < plainError);
+}
+
+TEST_CASE("Finite difference: American put", "[finite_difference]") {
+    // Converged reference values (K = 40, r = 0.06, sigma = 0.2, T = 1)
+    FiniteDifferenceModel model;
+    const double spots[] = {36.0, 40.0, 44.0};
+    const double expected[] = {4.4867, 2.3196, 1.1130};
+    for (int k = 0; k < 3; ++k) {
+        Option option(OptionType::Put, 40.0, 1.0, ExerciseStyle::American);
+        MarketData marketData(spots[k], 0.06, 0.2);
+        REQUIRE_THAT(model.price(option, marketData).price, WithinAbs(expected[k], 1e-3));
+    }
+}
+
+TEST_CASE("Finite difference: Strike chain reuses one grid", "[finite_difference]") {
+    MarketData marketData(100.0, 0.04, 0.25);
+    FiniteDifferenceModel model;
+    std::vector<double> strikes = {85.0, 95.0, 100.0, 105.0, 120.0};
+
+    for (auto exercise : {ExerciseStyle::European, ExerciseStyle::American}) {
+        auto chain = model.priceStrikes(OptionType::Put, exercise, strikes, 0.75, marketData);
+        REQUIRE(chain.size() == strikes.size());
+        for (std::size_t k = 0; k < strikes.size(); ++k) {
+            double single = model.price(Option(OptionType::Put, strikes[k], 0.75, exercise), marketData).price;
+            REQUIRE_THAT(chain[k].price, WithinAbs(single, 5e-3));
+            if (exercise == ExerciseStyle::European) {
+                double expected = blackScholes(false, 100.0, strikes[k], 0.04, 0.25, 0.75);
+                REQUIRE_THAT(chain[k].price, WithinAbs(expected, 5e-3));
+            }
+        }
+    }
+}
+
+TEST_CASE("Heston ADI: European prices match the analytic model", "[finite_difference][heston]") {
+    HestonParameters parameters(0.04, 1.5, 0.04, 0.5, -0.6);
+    MarketData marketData(100.0, 0.03, 0.2);
+    HestonModel analytic(parameters);
+
+    for (auto scheme : {numerics::AdiScheme::Douglas, numerics::AdiScheme::CraigSneyd,
+                        numerics::AdiScheme::HundsdorferVerwer}) {
+        HestonAdiSettings settings;
+        settings.scheme = scheme;
+        HestonAdiModel model(parameters, settings);
+
+        for (auto type : {OptionType::Call, OptionType::Put}) {
+            Option option(type, 100.0, 1.0);
+            REQUIRE_THAT(model.price(option, marketData).price,
+                         WithinAbs(analytic.price(option, marketData).price, 0.02));
+        }
+    }
+}
+
+TEST_CASE("Heston ADI: American put benchmark", "[finite_difference][heston]") {
+    // Ikonen & Toivanen reference values at v = 0.0625
+    HestonParameters parameters(0.0625, 5.0, 0.16, 0.9, 0.1);
+    HestonAdiSettings settings;
+    settings.spotSteps = 120;
+    settings.varianceSteps = 60;
+    settings.timeSteps = 60;
+    HestonAdiModel model(parameters, settings);
+
+    const double spots[] = {8.0, 9.0, 10.0, 11.0, 12.0};
+    const double expected[] = {2.0000, 1.1076, 0.5200, 0.2137, 0.0820};
+    for (int k = 0; k < 5; ++k) {
+        Option option(OptionType::Put, 10.0, 0.25, ExerciseStyle::American);
+        MarketData marketData(spots[k], 0.1, 0.25);
+        REQUIRE_THAT(model.price(option, marketData).price, WithinAbs(expected[k], 0.005));
+    }
+}
+
+TEST_CASE("Heston ADI: Early exercise premium", "[finite_difference][heston]") {
+    HestonParameters parameters(0.04, 1.5, 0.04, 0.5, -0.6);
+    MarketData marketData(100.0, 0.05, 0.2);
+    HestonAdiModel model(parameters);
+
+    double europeanPut = model.price(Option(OptionType::Put, 110.0, 1.0), marketData).price;
+    double americanPut = model.price(Option(OptionType::Put, 110.0, 1.0, ExerciseStyle::American), marketData).price;
+    double europeanCall = model.price(Option(OptionType::Call, 110.0, 1.0), marketData).price;
+    double americanCall = model.price(Option(OptionType::Call, 110.0, 1.0, ExerciseStyle::American), marketData).price;
+
+    REQUIRE(americanPut > europeanPut + 0.1);
+    REQUIRE(americanPut >= 10.0);
+    // Without dividends early exercise of a call is never optimal
+    REQUIRE_THAT(americanCall, WithinAbs(europeanCall, 1e-3));
+}
+
+TEST_CASE("Heston ADI: Result does not depend on thread count", "[finite_difference][heston]") {
+    HestonParameters parameters(0.04, 1.5, 0.04, 0.5, -0.6);
+    MarketData marketData(100.0, 0.03, 0.2);
+    Option option(OptionType::Put, 100.0, 1.0, ExerciseStyle::American);
+
+    HestonAdiSettings single;
+    single.numThreads = 1;
+    HestonAdiSettings multi = single;
+    multi.numThreads = 4;
+
+    REQUIRE(HestonAdiModel(parameters, single).price(option, marketData).price ==
+            HestonAdiModel(parameters, multi).price(option, marketData).price);
+}
+
+TEST_CASE("Finite difference: Validation", "[validation]") {
+    FiniteDifferenceSettings settings;
+    settings.spotSteps = 1;
+    REQUIRE_THROWS_AS(FiniteDifferenceModel(settings), std::invalid_argument);
+    settings = FiniteDifferenceSettings();
+    settings.maxSpotMultiple = 1.0;
+    REQUIRE_THROWS_AS(FiniteDifferenceModel(settings), std::invalid_argument);
+    REQUIRE_THROWS_AS(FiniteDifferenceModel().priceStrikes(OptionType::Call, ExerciseStyle::European,
+                                                           {100.0, -5.0}, 1.0, MarketData(100.0, 0.05, 0.2)),
+                      std::invalid_argument);
+}
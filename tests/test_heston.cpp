@@ -0,0 +1,138 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <cmath>
+
+#include "../include/pricing/core/HestonParameters.hpp"
+#include "../include/pricing/core/MarketData.hpp"
+#include "../include/pricing/core/Option.hpp"
+#include "../include/pricing/models/HestonModel.hpp"
+#include "../include/pricing/models/HestonMonteCarloModel.hpp"
+
+using namespace pricing;
+using namespace pricing::core;
+using namespace pricing::models;
+using Catch::Matchers::WithinAbs;
+
+namespace {
+    double standardNormalCDF(double x) {
+        return 0.5 * std::erfc(-x / std::sqrt(2.0));
+    }
+
+    double blackScholesCall(double S, double K, double r, double sigma, double T) {
+        double volSqrtT = sigma * std::sqrt(T);
+        double d1 = (std::log(S / K) + (r + 0.5 * sigma * sigma) * T) / volSqrtT;
+        return S * standardNormalCDF(d1) - K * std::exp(-r * T) * standardNormalCDF(d1 - volSqrtT);
+    }
+
+    // Feller condition violated: variance often hits zero, which is hard for Euler
+    HestonParameters stressedParameters() {
+        return HestonParameters(0.04, 1.5, 0.04, 0.8, -0.7);
+    }
+
+    HestonMonteCarloSettings coarseSettings(HestonScheme scheme) {
+        HestonMonteCarloSettings settings;
+        settings.numPaths = 200000;
+        settings.numSteps = 8;
+        settings.scheme = scheme;
+        return settings;
+    }
+}
+
+TEST_CASE("Heston: Analytic price reduces to Black-Scholes for tiny vol of variance", "[heston]") {
+    HestonParameters parameters(0.04, 2.0, 0.04, 1e-4, 0.0);
+    Option option(OptionType::Call, 105.0, 0.5);
+    MarketData marketData(100.0, 0.05, 0.2);
+
+    auto result = HestonModel(parameters).price(option, marketData);
+
+    REQUIRE_THAT(result.price, WithinAbs(blackScholesCall(100.0, 105.0, 0.05, 0.2, 0.5), 1e-4));
+}
+
+TEST_CASE("Heston: Analytic put-call parity", "[heston]") {
+    HestonModel model(stressedParameters());
+    MarketData marketData(100.0, 0.03, 0.2);
+
+    auto call = model.price(Option(OptionType::Call, 95.0, 1.0), marketData);
+    auto put = model.price(Option(OptionType::Put, 95.0, 1.0), marketData);
+
+    REQUIRE_THAT(call.price - put.price, WithinAbs(100.0 - 95.0 * std::exp(-0.03), 1e-10));
+}
+
+TEST_CASE("Heston: QE simulation matches the analytic price on a coarse grid", "[heston][monte_carlo]") {
+    MarketData marketData(100.0, 0.03, 0.2);
+    HestonModel analytic(stressedParameters());
+    HestonMonteCarloModel simulation(stressedParameters(), coarseSettings(HestonScheme::QuadraticExponential));
+
+    for (double strike : {80.0, 100.0, 120.0}) {
+        Option option(OptionType::Call, strike, 1.0);
+        double expected = analytic.price(option, marketData).price;
+        auto result = simulation.price(option, marketData);
+
+        REQUIRE_THAT(result.price, WithinAbs(expected, 4.0 * result.standardError + 0.02));
+    }
+}
+
+TEST_CASE("Heston: QE is less biased than Euler full truncation", "[heston][monte_carlo]") {
+    MarketData marketData(100.0, 0.03, 0.2);
+    Option option(OptionType::Put, 90.0, 1.0);
+    double expected = HestonModel(stressedParameters()).price(option, marketData).price;
+
+    auto qe = HestonMonteCarloModel(stressedParameters(), coarseSettings(HestonScheme::QuadraticExponential))
+        .price(option, marketData);
+    auto euler = HestonMonteCarloModel(stressedParameters(), coarseSettings(HestonScheme::EulerFullTruncation))
+        .price(option, marketData);
+
+    REQUIRE(std::abs(qe.price - expected) < std::abs(euler.price - expected));
+}
+
+TEST_CASE("Heston: Path payoffs for exotics", "[heston][monte_carlo]") {
+    MarketData marketData(100.0, 0.03, 0.2);
+    HestonMonteCarloSettings settings = coarseSettings(HestonScheme::QuadraticExponential);
+    settings.numPaths = 20000;
+    settings.numSteps = 12;
+    HestonMonteCarloModel model(stressedParameters(), settings);
+
+    auto asian = model.pricePayoff([](const PathBlock& block, std::vector<double>& payoffs) {
+        for (std::size_t i = 0; i < block.numPaths; ++i) {
+            double sum = 0.0;
+            for (std::size_t step = 1; step <= block.numSteps; ++step) {
+                sum += block.step(step)[i];
+            }
+            payoffs[i] = std::max(sum / block.numSteps - 100.0, 0.0);
+        }
+    }, marketData, 1.0);
+    auto vanilla = model.price(Option(OptionType::Call, 100.0, 1.0), marketData);
+
+    REQUIRE(asian.price > 0.0);
+    REQUIRE(asian.price < vanilla.price);
+}
+
+TEST_CASE("Heston: Simulation does not depend on thread count", "[heston][monte_carlo]") {
+    MarketData marketData(100.0, 0.03, 0.2);
+    Option option(OptionType::Call, 100.0, 1.0);
+    HestonMonteCarloSettings single = coarseSettings(HestonScheme::QuadraticExponential);
+    single.numPaths = 20000;
+    single.numThreads = 1;
+    HestonMonteCarloSettings multi = single;
+    multi.numThreads = 4;
+
+    auto a = HestonMonteCarloModel(stressedParameters(), single).price(option, marketData);
+    auto b = HestonMonteCarloModel(stressedParameters(), multi).price(option, marketData);
+
+    REQUIRE(a.price == b.price);
+}
+
+TEST_CASE("Heston: Validation", "[validation]") {
+    REQUIRE_THROWS_AS(HestonParameters(-0.01, 1.0, 0.04, 0.5, 0.0), std::invalid_argument);
+    REQUIRE_THROWS_AS(HestonParameters(0.04, 0.0, 0.04, 0.5, 0.0), std::invalid_argument);
+    REQUIRE_THROWS_AS(HestonParameters(0.04, 1.0, 0.04, 0.0, 0.0), std::invalid_argument);
+    REQUIRE_THROWS_AS(HestonParameters(0.04, 1.0, 0.04, 0.5, 1.5), std::invalid_argument);
+
+    // American options go to the ADI solver
+    Option american(OptionType::Put, 100.0, 1.0, ExerciseStyle::American);
+    MarketData marketData(100.0, 0.03, 0.2);
+    REQUIRE_THROWS_AS(HestonModel(stressedParameters()).price(american, marketData), std::invalid_argument);
+    REQUIRE_THROWS_AS(HestonMonteCarloModel(stressedParameters()).price(american, marketData),
+                      std::invalid_argument);
+}
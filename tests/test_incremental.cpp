@@ -0,0 +1,125 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <fstream>
+#include <string>
+
+#include "../include/pricing/batch/RowHashIndex.hpp"
+#include "../include/pricing/util/MappedFile.hpp"
+
+using namespace pricing;
+using namespace pricing::batch;
+
+namespace {
+    std::string readFile(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    void writeFile(const std::string& path, const std::string& text) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << text;
+    }
+
+    // Runs the CLI with the given arguments; returns its standard output
+    std::string runCli(const std::string& arguments) {
+        std::string log = "test_since_cli.log";
+        int status = std::system((std::string(PRICING_CLI_PATH) + " " + arguments + " > " + log + " 2>&1").c_str());
+        std::string output = readFile(log);
+        std::remove(log.c_str());
+        REQUIRE(status == 0);
+        return output;
+    }
+}
+
+TEST_CASE("Incremental batch: Row hash index round trip", "[batch]") {
+    std::string path = "test_rows.csv.rowhash";
+    util::ContentKey configuration = util::contentKey("csv-v1|greeks");
+
+    RowHashIndex index(configuration);
+    index.add(util::contentKey("call|100|105"), 40, 30);
+    index.add(util::contentKey("put|100|95"), 70, 28);
+    index.add(util::contentKey("call|100|105"), 98, 30);   // Duplicate rows keep the first line
+    std::string described = "type,price\ncall,1\n";
+    index.setOutput(described.size(), util::fnv1a(described));
+    index.save(path);
+
+    auto loaded = RowHashIndex::load(path);
+    std::remove(path.c_str());
+
+    REQUIRE(loaded.size() == 3);
+    REQUIRE(loaded.configuration() == configuration);
+    REQUIRE(loaded.describes(described.data(), described.size()));
+    std::string edited = "type,price\ncall,2\n";
+    REQUIRE_FALSE(loaded.describes(edited.data(), edited.size()));
+    REQUIRE_FALSE(loaded.describes(described.data(), described.size() - 1));
+    const RowLocation* first = loaded.find(util::contentKey("call|100|105"));
+    REQUIRE(first != nullptr);
+    REQUIRE(first->offset == 40);
+    REQUIRE(first->length == 30);
+    REQUIRE(loaded.find(util::contentKey("put|100|95"))->offset == 70);
+    REQUIRE(loaded.find(util::contentKey("put|100|96")) == nullptr);
+}
+
+TEST_CASE("Incremental batch: Damaged sidecar is rejected", "[batch]") {
+    std::string path = "test_damaged.rowhash";
+    {
+        RowHashIndex index;
+        index.add(util::contentKey("row"), 0, 10);
+        index.save(path);
+        std::ofstream append(path, std::ios::binary | std::ios::app);
+        append << "junk";
+    }
+    REQUIRE_THROWS_AS(RowHashIndex::load(path), std::runtime_error);
+    std::remove(path.c_str());
+    REQUIRE_THROWS_AS(RowHashIndex::load(path), std::runtime_error);
+}
+
+TEST_CASE("Incremental batch: Mapped file exposes the bytes", "[batch]") {
+    std::string path = "test_mapped.txt";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "header\nline one\n";
+    }
+    util::MappedFile mapped(path);
+    REQUIRE(mapped.size() == 16);
+    REQUIRE(std::string(mapped.data() + 7, 9) == "line one\n");
+
+    util::MappedFile moved(std::move(mapped));
+    REQUIRE(mapped.data() == nullptr);
+    REQUIRE(moved.size() == 16);
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Incremental batch: --since reuses only lines of the output its index describes", "[batch]") {
+    std::string input = "test_since_in.csv", output = "test_since_out.csv", fresh = "test_since_fresh.csv";
+    writeFile(input, "type,spot,strike,rate,vol,maturity\n"
+                     "call,100,105,0.05,0.2,0.5\n"
+                     "put,100,95,0.05,0.2,0.25\n");
+    runCli("--batch-input " + input + " --batch-output " + output);
+    std::string first = readFile(output);
+
+    // Unchanged rows are copied from the previous output
+    writeFile(input, "type,spot,strike,rate,vol,maturity\n"
+                     "call,100,105,0.05,0.2,0.5\n"
+                     "put,101,95,0.05,0.2,0.25\n");
+    REQUIRE(runCli("--batch-input " + input + " --batch-output " + output + " --since " + output)
+                .find("Reused 1 unchanged rows") != std::string::npos);
+    runCli("--batch-input " + input + " --batch-output " + fresh);
+    REQUIRE(readFile(output) == readFile(fresh));
+    REQUIRE(readFile(output).substr(0, first.find("put")) == first.substr(0, first.find("put")));
+
+    // An output replaced behind the index is not trusted, whatever it holds
+    writeFile(output, std::string(first.size(), 'X'));
+    std::string log = runCli("--batch-input " + input + " --batch-output " + output + " --since " + output);
+    REQUIRE(log.find("repricing all rows") != std::string::npos);
+    REQUIRE(log.find("Reused 0 unchanged rows") != std::string::npos);
+    REQUIRE(readFile(output) == readFile(fresh));
+
+    for (const auto& path : {input, output, fresh}) {
+        std::remove(path.c_str());
+        std::remove(RowHashIndex::sidecarPath(path).c_str());
+    }
+}
@@ -0,0 +1,233 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "../include/pricing/batch/LiveBookStore.hpp"
+#include "../include/pricing/models/BlackScholesModel.hpp"
+
+using namespace pricing;
+using namespace pricing::batch;
+using namespace pricing::core;
+using Catch::Matchers::WithinAbs;
+
+namespace {
+    Option position(std::size_t i) {
+        return Option(i % 2 == 0 ? OptionType::Call : OptionType::Put, 80.0 + static_cast<double>(i % 41),
+                      0.25 + static_cast<double>(i % 8) * 0.25,
+                      i % 5 == 0 ? ExerciseStyle::American : ExerciseStyle::European);
+    }
+
+    MarketData market(std::size_t i) {
+        return MarketData(90.0 + static_cast<double>(i % 7) * 5.0, 0.05, 0.15 + static_cast<double>(i % 3) * 0.05);
+    }
+
+    // Stored results come from Black-Scholes, which has no early exercise
+    PricingResult priced(std::size_t i) {
+        Option option = position(i);
+        Option european(option.getType(), option.getStrike(), option.getTimeToExpiration());
+        return models::BlackScholesModel().priceWithGreeks(european, market(i));
+    }
+
+    void fillBook(LiveBookStore& book, std::size_t rows) {
+        book.setMarketVersion(7);
+        for (std::size_t i = 0; i < rows; ++i) {
+            REQUIRE(book.add(static_cast<std::uint32_t>(i % 13), position(i), market(i), static_cast<double>(i) - 50.0) == i);
+            book.storeResult(i, priced(i));
+        }
+    }
+}
+
+TEST_CASE("Live book: Reopening restores positions, invariants and results", "[batch]") {
+    const std::string path = "test_live_book.bin";
+    std::remove(path.c_str());
+    const std::size_t rows = 2500;
+    {
+        LiveBookStore book(path, 16);
+        REQUIRE_FALSE(book.restored());
+        fillBook(book, rows);
+        REQUIRE(book.capacity() >= rows);
+        book.setQuantity(3, 12.5);
+        book.setMarketData(4, MarketData(101.0, 0.04, 0.3));
+    }
+
+    LiveBookStore book(path);
+    REQUIRE(book.restored());
+    REQUIRE(book.cleanShutdown());
+    REQUIRE(book.tornRows().empty());
+    REQUIRE(book.size() == rows);
+    REQUIRE(book.marketVersion() == 7);
+
+    for (std::size_t i = 0; i < rows; ++i) {
+        REQUIRE(book.underlying(i) == i % 13);
+        Option option = book.option(i);
+        REQUIRE(option.getType() == position(i).getType());
+        REQUIRE(option.getStrike() == position(i).getStrike());
+        REQUIRE(option.getTimeToExpiration() == position(i).getTimeToExpiration());
+        REQUIRE(option.getExerciseStyle() == position(i).getExerciseStyle());
+        if (i == 3 || i == 4) {
+            continue;
+        }
+        REQUIRE(book.quantity(i) == static_cast<double>(i) - 50.0);
+        REQUIRE(book.marketData(i).getSpot() == market(i).getSpot());
+        PricingResult stored;
+        std::uint64_t version = 0;
+        REQUIRE(book.result(i, stored, &version));
+        REQUIRE(version == 7);
+        PricingResult expected = priced(i);
+        REQUIRE(stored.price == expected.price);
+        REQUIRE(stored.rho == expected.rho);
+    }
+    REQUIRE(book.quantity(3) == 12.5);
+
+    PricingResult stored;
+    REQUIRE_FALSE(book.result(4, stored));          // Market data changed after pricing
+    RowInvariants invariants = book.invariants(4);
+    double maturity = position(4).getTimeToExpiration();
+    REQUIRE_THAT(invariants.volSqrtT, WithinAbs(0.3 * std::sqrt(maturity), 1e-15));
+    REQUIRE_THAT(invariants.drift, WithinAbs((0.04 + 0.045) * maturity, 1e-15));
+    REQUIRE_THAT(invariants.discount, WithinAbs(std::exp(-0.04 * maturity), 1e-15));
+
+    OptionBatch batch = book.batch(10, 20);
+    REQUIRE(batch.size() == 10);
+    REQUIRE(batch.strikes[0] == position(10).getStrike());
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Live book: Crashed writers are detected on open", "[batch]") {
+    const std::string path = "test_live_book_crash.bin";
+    std::remove(path.c_str());
+    {
+        LiveBookStore book(path);
+        fillBook(book, 10);
+    }
+
+    // A process that exits without closing the book
+    pid_t child = ::fork();
+    REQUIRE(child >= 0);
+    if (child == 0) {
+        LiveBookStore book(path);
+        book.setQuantity(1, 99.0);
+        ::_exit(0);
+    }
+    int status = 0;
+    ::waitpid(child, &status, 0);
+
+    // Leave row 2 mid-write: the sequence number is the first field of a
+    // row, and 144-byte rows start after the 64-byte header
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        std::uint64_t sequence = 0;
+        file.seekg(64 + 2 * 144);
+        file.read(reinterpret_cast<char*>(&sequence), sizeof(sequence));
+        sequence += 1;
+        file.seekp(64 + 2 * 144);
+        file.write(reinterpret_cast<const char*>(&sequence), sizeof(sequence));
+    }
+
+    LiveBookStore book(path);
+    REQUIRE(book.restored());
+    REQUIRE_FALSE(book.cleanShutdown());
+    REQUIRE(book.quantity(1) == 99.0);
+    REQUIRE(book.tornRows() == std::vector<std::size_t>{2});
+    PricingResult stored;
+    REQUIRE_FALSE(book.result(2, stored));
+    REQUIRE(book.result(3, stored));
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Live book: Growth interrupted before the capacity is recorded", "[batch]") {
+    const std::string path = "test_live_book_grow.bin";
+    std::remove(path.c_str());
+    {
+        LiveBookStore book(path, 4);
+        fillBook(book, 4);
+    }
+
+    // The file already has room for 8 rows, the header still says 4
+    REQUIRE(::truncate(path.c_str(), 64 + 8 * 144) == 0);
+    {
+        LiveBookStore book(path);
+        REQUIRE(book.restored());
+        REQUIRE(book.size() == 4);
+        REQUIRE(book.capacity() == 8);
+        REQUIRE(book.quantity(3) == 3.0 - 50.0);
+        book.add(0, position(4), market(4), 1.0);
+    }
+    LiveBookStore book(path);
+    REQUIRE(book.size() == 5);
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Live book: A failed growth keeps the book", "[batch]") {
+    const std::string path = "test_live_book_failed_grow.bin";
+    const std::string moved = path + ".moved";
+    std::remove(path.c_str());
+    LiveBookStore book(path, 4);
+    fillBook(book, 4);
+
+    // With the file gone from its path the book cannot grow
+    REQUIRE(std::rename(path.c_str(), moved.c_str()) == 0);
+    REQUIRE_THROWS_AS(book.add(0, position(4), market(4), 1.0), std::runtime_error);
+    REQUIRE(book.size() == 4);
+    REQUIRE(book.capacity() == 4);
+    REQUIRE(book.quantity(3) == 3.0 - 50.0);
+    PricingResult stored;
+    REQUIRE(book.result(3, stored));
+
+    REQUIRE(std::rename(moved.c_str(), path.c_str()) == 0);
+    REQUIRE(book.add(0, position(4), market(4), 1.0) == 4);
+    REQUIRE(book.capacity() == 8);
+    REQUIRE(book.quantity(0) == -50.0);
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Live book: Layout versions and foreign files", "[batch]") {
+    const std::string path = "test_live_book_layout.bin";
+    {
+        std::ofstream foreign(path, std::ios::binary);
+        foreign << "not a live book";
+    }
+    REQUIRE_THROWS_AS(LiveBookStore(path), std::runtime_error);
+    {
+        std::ifstream kept(path, std::ios::binary);
+        std::string content;
+        std::getline(kept, content);
+        REQUIRE(content == "not a live book");
+    }
+
+    std::remove(path.c_str());
+    {
+        LiveBookStore book(path);
+        REQUIRE_FALSE(book.restored());
+        REQUIRE(book.size() == 0);
+        fillBook(book, 3);
+    }
+
+    // Layout version follows the 8-byte magic
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        std::uint32_t version = LiveBookStore::kLayoutVersion + 1;
+        file.seekp(8);
+        file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    }
+    REQUIRE_THROWS_AS(LiveBookStore(path), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Live book: Validation", "[validation]") {
+    const std::string path = "test_live_book_validation.bin";
+    REQUIRE_THROWS_AS(LiveBookStore(path, 0), std::invalid_argument);
+    LiveBookStore book(path);
+    REQUIRE_THROWS_AS(book.quantity(0), std::out_of_range);
+    REQUIRE_THROWS_AS(book.batch(0, 1), std::out_of_range);
+    std::remove(path.c_str());
+    REQUIRE_THROWS_AS(LiveBookStore("test_live_book_missing_dir/book.bin"), std::runtime_error);
+}
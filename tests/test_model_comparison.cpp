@@ -0,0 +1,79 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <cmath>
+#include <stdexcept>
+
+#include "../include/pricing/batch/ModelComparison.hpp"
+#include "../include/pricing/models/BinomialTreeModel.hpp"
+#include "../include/pricing/models/BlackScholesModel.hpp"
+#include "../include/pricing/models/HestonModel.hpp"
+
+using namespace pricing;
+using namespace pricing::batch;
+using namespace pricing::core;
+using Catch::Matchers::WithinAbs;
+
+namespace {
+    OptionBatch putChain() {
+        OptionBatch batch;
+        for (int i = 0; i < 25; ++i) {
+            batch.add(Option(OptionType::Put, 80.0 + 2.0 * i, 0.5 + 0.25 * (i % 3)), MarketData(100.0, 0.05, 0.25));
+        }
+        return batch;
+    }
+}
+
+TEST_CASE("Model comparison: Columns match the models priced alone", "[batch]") {
+    HestonParameters heston(0.0625, 1.5, 0.0625, 0.4, -0.6);
+    std::vector<ComparedModel> models = {
+        ModelComparison::fromSpec("black_scholes"),
+        ModelComparison::fromSpec("binomial"),
+        ModelComparison::fromSpec("binomial:american"),
+        ModelComparison::fromSpec("heston", &heston)};
+    REQUIRE(models[2].label == "binomial_american");
+
+    OptionBatch batch = putChain();
+    BatchSettings settings;
+    settings.numThreads = 3;
+    ModelComparison comparison(models, settings);
+    auto results = comparison.price(batch);
+
+    REQUIRE(results.size() == 4);
+    models::BlackScholesModel blackScholes;
+    models::BinomialTreeModel binomial;
+    models::HestonModel hestonModel(heston);
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        Option european(batch.types[i], batch.strikes[i], batch.maturities[i]);
+        Option american(batch.types[i], batch.strikes[i], batch.maturities[i], ExerciseStyle::American);
+        MarketData marketData(batch.spots[i], batch.rates[i], batch.volatilities[i]);
+
+        REQUIRE(results[0][i].price == blackScholes.price(european, marketData).price);
+        REQUIRE(results[1][i].price == binomial.price(european, marketData).price);
+        REQUIRE(results[2][i].price == binomial.price(american, marketData).price);
+        REQUIRE(results[3][i].price == hestonModel.price(european, marketData).price);
+        // Early exercise premium of a put is never negative
+        REQUIRE(results[2][i].price >= results[1][i].price - 1e-12);
+    }
+}
+
+TEST_CASE("Model comparison: Rejected rows get a NaN price", "[batch]") {
+    OptionBatch batch = putChain();
+    batch.add(Option(OptionType::Call, 100.0, 1.0), MarketData(100.0, 0.05, 0.0));
+
+    ModelComparison comparison({ModelComparison::fromSpec("black_scholes"), ModelComparison::fromSpec("binomial")});
+    auto results = comparison.price(batch);
+    std::size_t last = batch.size() - 1;
+
+    REQUIRE_THAT(results[0][last].price, WithinAbs(100.0 - 100.0 * std::exp(-0.05), 1e-12));
+    REQUIRE(std::isnan(results[1][last].price));
+    REQUIRE_FALSE(std::isnan(results[1][0].price));
+}
+
+TEST_CASE("Model comparison: Validation", "[validation]") {
+    REQUIRE_THROWS_AS(ModelComparison({}), std::invalid_argument);
+    REQUIRE_THROWS_AS(ModelComparison::fromSpec("heston"), std::invalid_argument);
+    REQUIRE_THROWS_AS(ModelComparison::fromSpec("black_scholes:american"), std::invalid_argument);
+    REQUIRE_THROWS_AS(ModelComparison::fromSpec("binomial:bermudan"), std::invalid_argument);
+    REQUIRE_THROWS_AS(ModelComparison::fromSpec("sabr"), std::invalid_argument);
+}
@@ -0,0 +1,133 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "../include/pricing/batch/ModelDispatcher.hpp"
+#include "../include/pricing/models/BinomialTreeModel.hpp"
+#include "../include/pricing/models/BlackScholesModel.hpp"
+#include "../include/pricing/models/ModelFactory.hpp"
+
+using namespace pricing;
+using namespace pricing::batch;
+using namespace pricing::core;
+
+namespace {
+    double standardNormalCDF(double x) {
+        return 0.5 * std::erfc(-x / std::sqrt(2.0));
+    }
+
+    double blackScholesPut(double S, double K, double r, double sigma, double T) {
+        double volSqrtT = sigma * std::sqrt(T);
+        double d1 = (std::log(S / K) + (r + 0.5 * sigma * sigma) * T) / volSqrtT;
+        double d2 = d1 - volSqrtT;
+        return K * std::exp(-r * T) * standardNormalCDF(-d2) - S * standardNormalCDF(-d1);
+    }
+
+    RowRequest request(const std::string& model, unsigned outputs) {
+        RowRequest value;
+        value.model = model;
+        value.outputs = outputs;
+        return value;
+    }
+}
+
+TEST_CASE("Model dispatch: Output selection", "[batch]") {
+    REQUIRE(parseOutputs("price") == OutputPrice);
+    REQUIRE(parseOutputs("delta") == (OutputPrice | OutputDelta));
+    REQUIRE(parseOutputs("price|gamma|rho") == (OutputPrice | OutputGamma | OutputRho));
+    REQUIRE(parseOutputs("greeks") == OutputAll);
+    REQUIRE(parseOutputs("all") == OutputAll);
+    REQUIRE_FALSE(request("black_scholes", OutputPrice).needsGreeks());
+    REQUIRE(request("black_scholes", OutputPrice | OutputVega).needsGreeks());
+
+    REQUIRE_THROWS_AS(parseOutputs("delta|speed"), std::invalid_argument);
+    REQUIRE_THROWS_AS(parseOutputs(""), std::invalid_argument);
+}
+
+TEST_CASE("Model dispatch: Factory creates every listed model", "[batch]") {
+    Option option(OptionType::Put, 100.0, 0.5);
+    MarketData marketData(100.0, 0.05, 0.2);
+    double reference = blackScholesPut(100.0, 100.0, 0.05, 0.2, 0.5);
+
+    for (const auto& name : models::modelNames()) {
+        REQUIRE(models::isModelName(name));
+        auto model = models::createModel(name, 1);
+        REQUIRE(model->price(option, marketData).price > 0.0);
+        if (name != "black_scholes") {
+            REQUIRE(std::abs(model->price(option, marketData).price - reference) < 0.1);
+        }
+    }
+    REQUIRE_FALSE(models::isModelName("heston"));
+    REQUIRE_THROWS_AS(models::createModel("heston"), std::invalid_argument);
+}
+
+TEST_CASE("Model dispatch: Mixed book priced in one pass", "[batch]") {
+    OptionBatch batch;
+    std::vector<RowRequest> requests;
+    for (int i = 0; i < 40; ++i) {
+        OptionType type = i % 2 == 0 ? OptionType::Call : OptionType::Put;
+        batch.add(Option(type, 80.0 + i, 0.25 + 0.05 * (i % 4)), MarketData(100.0, 0.03, 0.25));
+        if (i % 3 == 0) {
+            requests.push_back(request("binomial", OutputPrice | OutputDelta));
+        } else {
+            requests.push_back(request("black_scholes", i % 3 == 1 ? OutputPrice : OutputAll));
+        }
+    }
+
+    BatchSettings settings;
+    settings.numThreads = 2;
+    auto results = ModelDispatcher(settings).price(batch, requests);
+
+    models::BlackScholesModel blackScholes;
+    models::BinomialTreeModel binomial;
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        Option option(batch.types[i], batch.strikes[i], batch.maturities[i]);
+        MarketData marketData(batch.spots[i], batch.rates[i], batch.volatilities[i]);
+        PricingResult expected;
+        if (requests[i].model == "binomial") {
+            expected = binomial.priceWithGreeks(option, marketData);
+        } else if (requests[i].needsGreeks()) {
+            expected = blackScholes.priceWithGreeks(option, marketData);
+        } else {
+            expected = blackScholes.price(option, marketData);
+        }
+        REQUIRE(results[i].price == expected.price);
+        REQUIRE(results[i].delta == expected.delta);
+        REQUIRE(results[i].rho == expected.rho);
+    }
+}
+
+TEST_CASE("Model dispatch: Rows a model rejects do not fail the batch", "[batch]") {
+    OptionBatch batch;
+    batch.add(Option(OptionType::Put, 95.0, 0.25), MarketData(100.0, 0.05, 0.2));
+    batch.add(Option(OptionType::Put, 95.0, 0.25), MarketData(100.0, 0.05, 0.0));   // Trees need volatility
+    batch.add(Option(OptionType::Call, 90.0, 0.5), MarketData(100.0, 0.05, 0.2));
+    batch.add(Option(OptionType::Call, 90.0, 0.5), MarketData(100.0, 0.05, 0.0));
+    std::vector<RowRequest> requests = {request("binomial", OutputPrice), request("binomial", OutputPrice),
+                                        request("black_scholes", OutputPrice), request("black_scholes", OutputPrice)};
+
+    std::vector<std::string> errors;
+    auto results = ModelDispatcher().price(batch, requests, &errors);
+    REQUIRE(errors.size() == 4);
+    REQUIRE(errors[0].empty());
+    REQUIRE_FALSE(errors[1].empty());
+    REQUIRE(errors[2].empty());
+    REQUIRE(errors[3].empty());
+    REQUIRE(results[0].price > 0.0);
+    REQUIRE(results[1].price == 0.0);
+    REQUIRE(results[2].price > 0.0);
+    REQUIRE(results[3].price > 0.0);
+
+    // Without an error list the row is still skipped
+    REQUIRE(ModelDispatcher().price(batch, requests)[1].price == 0.0);
+}
+
+TEST_CASE("Model dispatch: Validation", "[validation]") {
+    OptionBatch batch;
+    batch.add(Option(OptionType::Call, 100.0, 1.0), MarketData(100.0, 0.05, 0.2));
+
+    REQUIRE_THROWS_AS(ModelDispatcher().price(batch, {}), std::invalid_argument);
+    REQUIRE_THROWS_AS(ModelDispatcher().price(batch, {request("sabr", OutputPrice)}), std::invalid_argument);
+}
@@ -0,0 +1,230 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <cmath>
+
+#include "../include/pricing/core/Barrier.hpp"
+#include "../include/pricing/core/MarketData.hpp"
+#include "../include/pricing/core/Option.hpp"
+#include "../include/pricing/models/MonteCarloModel.hpp"
+
+using namespace pricing;
+using namespace pricing::core;
+using namespace pricing::models;
+using Catch::Matchers::WithinAbs;
+
+namespace {
+    double standardNormalCDF(double x) {
+        return 0.5 * std::erfc(-x / std::sqrt(2.0));
+    }
+
+    double blackScholes(bool isCall, double S, double K, double r, double sigma, double T) {
+        double volSqrtT = sigma * std::sqrt(T);
+        double d1 = (std::log(S / K) + (r + 0.5 * sigma * sigma) * T) / volSqrtT;
+        double d2 = d1 - volSqrtT;
+        double discountFactor = std::exp(-r * T);
+        if (isCall) {
+            return S * standardNormalCDF(d1) - K * discountFactor * standardNormalCDF(d2);
+        }
+        return K * discountFactor * standardNormalCDF(-d2) - S * standardNormalCDF(-d1);
+    }
+
+    // Closed-form continuously monitored down-and-out call (barrier below strike)
+    double downAndOutCall(double S, double K, double B, double r, double sigma, double T) {
+        double vanilla = blackScholes(true, S, K, r, sigma, T);
+
+        double lambda = (r + 0.5 * sigma * sigma) / (sigma * sigma);
+        double volSqrtT = sigma * std::sqrt(T);
+        double y = std::log(B * B / (S * K)) / volSqrtT + lambda * volSqrtT;
+        double knockIn = S * std::pow(B / S, 2.0 * lambda) * standardNormalCDF(y)
+            - K * std::exp(-r * T) * std::pow(B / S, 2.0 * lambda - 2.0) * standardNormalCDF(y - volSqrtT);
+        return vanilla - knockIn;
+    }
+
+    MonteCarloSettings coarseSettings(std::size_t steps, bool brownianBridge) {
+        MonteCarloSettings settings;
+        settings.numPaths = 100000;
+        settings.numSteps = steps;
+        settings.brownianBridge = brownianBridge;
+        return settings;
+    }
+}
+
+TEST_CASE("Monte Carlo: Vanilla price matches Black-Scholes", "[monte_carlo]") {
+    Option option(OptionType::Call, 105.0, 0.5);
+    MarketData marketData(100.0, 0.05, 0.2);
+
+    double expected = blackScholes(true, 100.0, 105.0, 0.05, 0.2, 0.5);
+    auto result = MonteCarloModel().price(option, marketData);
+
+    REQUIRE(result.standardError > 0.0);
+    REQUIRE_THAT(result.price, WithinAbs(expected, 4.0 * result.standardError));
+}
+
+TEST_CASE("Monte Carlo: Greeks from a single simulation", "[monte_carlo][greeks]") {
+    double S = 100.0, K = 110.0, r = 0.05, sigma = 0.25, T = 0.75;
+    MarketData marketData(S, r, sigma);
+    MonteCarloSettings settings;
+    settings.numPaths = 400000;
+    MonteCarloModel model(settings);
+
+    for (OptionType type : {OptionType::Call, OptionType::Put}) {
+        Option option(type, K, T);
+        auto result = model.priceWithGreeks(option, marketData);
+
+        // Central differences of the closed form as reference
+        bool isCall = type == OptionType::Call;
+        double hS = 0.01 * S, hV = 1e-4, hR = 1e-4;
+        double up = blackScholes(isCall, S + hS, K, r, sigma, T);
+        double mid = blackScholes(isCall, S, K, r, sigma, T);
+        double down = blackScholes(isCall, S - hS, K, r, sigma, T);
+        double delta = (up - down) / (2.0 * hS);
+        double gamma = (up - 2.0 * mid + down) / (hS * hS);
+        double vega = (blackScholes(isCall, S, K, r, sigma + hV, T)
+                       - blackScholes(isCall, S, K, r, sigma - hV, T)) / (2.0 * hV);
+        double rho = (blackScholes(isCall, S, K, r + hR, sigma, T)
+                      - blackScholes(isCall, S, K, r - hR, sigma, T)) / (2.0 * hR);
+        double theta = r * mid - r * S * delta - 0.5 * sigma * sigma * S * S * gamma;
+
+        REQUIRE_THAT(result.price, WithinAbs(mid, 4.0 * result.standardError));
+        REQUIRE_THAT(result.delta, WithinAbs(delta, 0.005));
+        REQUIRE_THAT(result.gamma, WithinAbs(gamma, 0.0015));
+        REQUIRE_THAT(result.vega, WithinAbs(vega, 0.4));
+        REQUIRE_THAT(result.rho, WithinAbs(rho, 0.4));
+        REQUIRE_THAT(result.theta, WithinAbs(theta, 0.2));
+    }
+}
+
+TEST_CASE("Monte Carlo: Greeks without volatility follow the closed form", "[monte_carlo][greeks]") {
+    MarketData marketData(110.0, 0.05, 0.0);
+    MonteCarloModel model;
+
+    auto call = model.priceWithGreeks(Option(OptionType::Call, 100.0, 1.0), marketData);
+    REQUIRE_THAT(call.price, WithinAbs(110.0 - 100.0 * std::exp(-0.05), 1e-12));
+    REQUIRE(call.delta == 1.0);
+    REQUIRE(call.gamma == 0.0);
+    REQUIRE(call.vega == 0.0);
+    REQUIRE(call.theta == 0.0);
+
+    auto put = model.priceWithGreeks(Option(OptionType::Put, 100.0, 1.0), marketData);
+    REQUIRE(put.price == 0.0);
+    REQUIRE(put.delta == 0.0);
+    REQUIRE(put.gamma == 0.0);
+}
+
+TEST_CASE("Monte Carlo: Importance sampling for deep out-of-the-money options", "[monte_carlo]") {
+    MarketData marketData(100.0, 0.03, 0.2);
+    MonteCarloSettings plain;
+    plain.numPaths = 50000;
+    MonteCarloSettings shifted = plain;
+    shifted.importanceSampling = true;
+
+    for (auto type : {OptionType::Call, OptionType::Put}) {
+        bool isCall = type == OptionType::Call;
+        Option option(type, isCall ? 170.0 : 60.0, 0.5);
+        double expected = blackScholes(isCall, 100.0, option.getStrike(), 0.03, 0.2, 0.5);
+
+        auto naive = MonteCarloModel(plain).price(option, marketData);
+        auto sampled = MonteCarloModel(shifted).price(option, marketData);
+
+        REQUIRE_THAT(sampled.price, WithinAbs(expected, 4.0 * sampled.standardError));
+        REQUIRE(sampled.standardError * 20.0 < naive.standardError);
+    }
+}
+
+TEST_CASE("Monte Carlo: Stratified terminal sampling", "[monte_carlo]") {
+    Option option(OptionType::Call, 100.0, 1.0);
+    MarketData marketData(100.0, 0.05, 0.2);
+    double expected = blackScholes(true, 100.0, 100.0, 0.05, 0.2, 1.0);
+
+    MonteCarloSettings plain;
+    plain.numPaths = 50000;
+    plain.blockSize = 2048;
+    MonteCarloSettings stratified = plain;
+    stratified.stratified = true;
+
+    auto naive = MonteCarloModel(plain).price(option, marketData);
+    auto result = MonteCarloModel(stratified).price(option, marketData);
+    auto greeks = MonteCarloModel(stratified).priceWithGreeks(option, marketData);
+
+    REQUIRE_THAT(result.price, WithinAbs(expected, 0.01));
+    REQUIRE(result.standardError * 10.0 < naive.standardError);
+    REQUIRE_THAT(greeks.price, WithinAbs(result.price, 1e-12));
+}
+
+TEST_CASE("Monte Carlo: Result does not depend on thread count", "[monte_carlo]") {
+    Option option(OptionType::Put, 100.0, 1.0);
+    MarketData marketData(100.0, 0.05, 0.2);
+    Barrier barrier(BarrierType::DownAndOut, 85.0);
+
+    MonteCarloSettings single = coarseSettings(10, true);
+    single.numThreads = 1;
+    MonteCarloSettings multi = single;
+    multi.numThreads = 4;
+
+    auto a = MonteCarloModel(single).priceBarrier(option, barrier, marketData);
+    auto b = MonteCarloModel(multi).priceBarrier(option, barrier, marketData);
+
+    REQUIRE(a.price == b.price);
+}
+
+TEST_CASE("Monte Carlo: Brownian bridge removes coarse-step barrier bias", "[monte_carlo]") {
+    double S = 100.0, K = 100.0, B = 90.0, r = 0.05, sigma = 0.25, T = 1.0;
+    Option option(OptionType::Call, K, T);
+    MarketData marketData(S, r, sigma);
+    Barrier barrier(BarrierType::DownAndOut, B);
+    double expected = downAndOutCall(S, K, B, r, sigma, T);
+
+    auto corrected = MonteCarloModel(coarseSettings(10, true)).priceBarrier(option, barrier, marketData);
+    auto uncorrected = MonteCarloModel(coarseSettings(10, false)).priceBarrier(option, barrier, marketData);
+
+    REQUIRE_THAT(corrected.price, WithinAbs(expected, 4.0 * corrected.standardError));
+    // Checking only at 10 dates misses crossings and overprices the knock-out
+    REQUIRE(uncorrected.price - expected > 10.0 * uncorrected.standardError);
+}
+
+TEST_CASE("Monte Carlo: Discrete barrier priced on a coarse grid with BGK shift", "[monte_carlo]") {
+    double S = 100.0, K = 100.0, B = 90.0, r = 0.05, sigma = 0.25, T = 1.0;
+    std::size_t dates = 50;
+    Option option(OptionType::Call, K, T);
+    MarketData marketData(S, r, sigma);
+    Barrier barrier(BarrierType::DownAndOut, B, BarrierMonitoring::Discrete, dates);
+
+    auto exact = MonteCarloModel(coarseSettings(dates, true)).priceBarrier(option, barrier, marketData);
+    auto coarse = MonteCarloModel(coarseSettings(5, true)).priceBarrier(option, barrier, marketData);
+
+    double tolerance = 4.0 * std::hypot(exact.standardError, coarse.standardError);
+    REQUIRE_THAT(coarse.price, WithinAbs(exact.price, tolerance));
+}
+
+TEST_CASE("Monte Carlo: Knock-in and knock-out sum to vanilla", "[monte_carlo]") {
+    Option option(OptionType::Call, 100.0, 1.0);
+    MarketData marketData(100.0, 0.05, 0.2);
+    MonteCarloModel model(coarseSettings(20, true));
+
+    auto knockOut = model.priceBarrier(option, Barrier(BarrierType::UpAndOut, 130.0), marketData);
+    auto knockIn = model.priceBarrier(option, Barrier(BarrierType::UpAndIn, 130.0), marketData);
+    double vanilla = blackScholes(true, 100.0, 100.0, 0.05, 0.2, 1.0);
+
+    double tolerance = 4.0 * (knockOut.standardError + knockIn.standardError);
+    REQUIRE_THAT(knockOut.price + knockIn.price, WithinAbs(vanilla, tolerance));
+}
+
+TEST_CASE("Monte Carlo: Validation", "[validation]") {
+    REQUIRE_THROWS_AS(Barrier(BarrierType::UpAndOut, -1.0), std::invalid_argument);
+    REQUIRE_THROWS_AS(Barrier(BarrierType::UpAndOut, 120.0, BarrierMonitoring::Discrete, 0),
+                      std::invalid_argument);
+
+    MonteCarloSettings settings;
+    settings.numSteps = 0;
+    REQUIRE_THROWS_AS(MonteCarloModel(settings), std::invalid_argument);
+
+    // No early exercise in the simulation
+    MonteCarloModel model;
+    Option american(OptionType::Put, 100.0, 1.0, ExerciseStyle::American);
+    MarketData marketData(100.0, 0.05, 0.2);
+    REQUIRE_THROWS_AS(model.price(american, marketData), std::invalid_argument);
+    REQUIRE_THROWS_AS(model.priceWithGreeks(american, marketData), std::invalid_argument);
+    REQUIRE_THROWS_AS(model.priceBarrier(american, Barrier(BarrierType::DownAndOut, 80.0), marketData),
+                      std::invalid_argument);
+}
@@ -0,0 +1,76 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <numeric>
+#include <string>
+
+#include "../include/pricing/core/OptionBatch.hpp"
+#include "../include/pricing/util/MappedFile.hpp"
+#include "../include/pricing/util/PageAllocator.hpp"
+
+using namespace pricing;
+using namespace pricing::util;
+
+namespace {
+    // Restores the default policy when a test ends
+    struct PolicyGuard {
+        explicit PolicyGuard(const MemoryPolicy& policy) { setMemoryPolicy(policy); }
+        ~PolicyGuard() { setMemoryPolicy(MemoryPolicy()); }
+    };
+
+    std::size_t largeAllocations() {
+        auto stats = largeAllocationStats();
+        return stats.hugeTlb + stats.transparent + stats.regular;
+    }
+}
+
+TEST_CASE("Page allocator: Large buffers under every policy", "[util]") {
+    for (bool hugePages : {false, true}) {
+        for (bool prefault : {false, true}) {
+            MemoryPolicy policy;
+            policy.hugePages = hugePages;
+            policy.prefault = prefault;
+            PolicyGuard guard(policy);
+
+            std::size_t before = largeAllocations();
+            BatchVector<double> values(1000000);
+            std::iota(values.begin(), values.end(), 0.0);
+
+            REQUIRE(largeAllocations() == before + 1);
+            REQUIRE(values[999999] == 999999.0);
+            values.push_back(1.0);   // Grows into a new mapping
+            REQUIRE(values[123456] == 123456.0);
+        }
+    }
+}
+
+TEST_CASE("Page allocator: Small buffers stay on the heap", "[util]") {
+    PolicyGuard guard(MemoryPolicy{true, true});
+    std::size_t before = largeAllocations();
+    core::OptionBatch batch;
+    batch.add(core::Option(core::OptionType::Call, 100.0, 1.0), core::MarketData(100.0, 0.05, 0.2));
+
+    REQUIRE(largeAllocations() == before);
+    REQUIRE(batch.spots[0] == 100.0);
+}
+
+TEST_CASE("Page allocator: Mapped file with prefault and huge pages", "[util]") {
+    std::string path = "test_page_allocator.bin";
+    std::string content(3 << 20, 'x');
+    content.back() = 'y';
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << content;
+    }
+
+    MemoryPolicy policy;
+    policy.hugePages = true;
+    policy.prefault = true;
+    MappedFile mapped(path, policy);
+
+    REQUIRE(mapped.size() == content.size());
+    REQUIRE(mapped.data()[0] == 'x');
+    REQUIRE(mapped.data()[content.size() - 1] == 'y');
+    std::remove(path.c_str());
+}
@@ -0,0 +1,131 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "../include/pricing/core/HestonParameters.hpp"
+#include "../include/pricing/core/MarketData.hpp"
+#include "../include/pricing/models/HestonMonteCarloModel.hpp"
+#include "../include/pricing/models/MonteCarloModel.hpp"
+#include "../include/pricing/models/PayoffScript.hpp"
+
+using namespace pricing;
+using namespace pricing::core;
+using namespace pricing::models;
+using Catch::Matchers::WithinAbs;
+
+namespace {
+    // Three paths over two steps: rows are steps 0, 1, 2
+    PathBlock samplePaths() {
+        PathBlock block;
+        block.numPaths = 3;
+        block.numSteps = 2;
+        block.timeStep = 0.5;
+        block.spots = {100.0, 100.0, 100.0,
+                        90.0, 110.0, 120.0,
+                        95.0, 130.0, 105.0};
+        return block;
+    }
+
+    std::vector<double> run(const PayoffScript& script) {
+        std::vector<double> payoffs(3, 0.0);
+        script(samplePaths(), payoffs);
+        return payoffs;
+    }
+
+    double standardNormalCDF(double x) {
+        return 0.5 * std::erfc(-x / std::sqrt(2.0));
+    }
+}
+
+TEST_CASE("Payoff script: Path observations", "[payoff_script]") {
+    REQUIRE(run(PayoffScript("spot")) == std::vector<double>{95.0, 130.0, 105.0});
+    REQUIRE(run(PayoffScript("initial")) == std::vector<double>{100.0, 100.0, 100.0});
+    REQUIRE(run(PayoffScript("at(1)")) == std::vector<double>{90.0, 110.0, 120.0});
+    REQUIRE(run(PayoffScript("average")) == std::vector<double>{92.5, 120.0, 112.5});
+    REQUIRE(run(PayoffScript("maximum")) == std::vector<double>{100.0, 130.0, 120.0});
+    REQUIRE(run(PayoffScript("minimum")) == std::vector<double>{90.0, 100.0, 100.0});
+}
+
+TEST_CASE("Payoff script: Operators and functions", "[payoff_script]") {
+    REQUIRE(run(PayoffScript("max(spot - K, 0)", {{"K", 100.0}})) == std::vector<double>{0.0, 30.0, 5.0});
+    REQUIRE(run(PayoffScript("(maximum < 125) * max(spot - 100, 0)")) == std::vector<double>{0.0, 0.0, 5.0});
+    REQUIRE(run(PayoffScript("if(minimum <= 90 || spot > 120, 1, -1)")) == std::vector<double>{1.0, 1.0, -1.0});
+    REQUIRE(run(PayoffScript("!(spot >= 100 && at(1) != 110)")) == std::vector<double>{1.0, 1.0, 0.0});
+    REQUIRE(run(PayoffScript("min(spot, at(1), 100) / 10")) == std::vector<double>{9.0, 10.0, 10.0});
+    REQUIRE(run(PayoffScript("-abs(spot - 100) + 2 * 3")) == std::vector<double>{1.0, -24.0, 1.0});
+
+    auto logs = run(PayoffScript("sqrt(exp(2 * log(spot)))"));
+    REQUIRE_THAT(logs[1], WithinAbs(130.0, 1e-9));
+}
+
+TEST_CASE("Payoff script: Constant subexpressions are folded", "[payoff_script]") {
+    REQUIRE(PayoffScript("max(2 * 3, 1) + sqrt(K)", {{"K", 16.0}}).instructionCount() == 1);
+    REQUIRE(PayoffScript("spot - (K + 1) * 2", {{"K", 4.0}}).instructionCount() == 3);
+}
+
+TEST_CASE("Payoff script: Compile errors", "[payoff_script][validation]") {
+    REQUIRE_THROWS_AS(PayoffScript("max(spot, 1"), std::invalid_argument);
+    REQUIRE_THROWS_AS(PayoffScript("spot +"), std::invalid_argument);
+    REQUIRE_THROWS_AS(PayoffScript("strike - spot"), std::invalid_argument);
+    REQUIRE_THROWS_AS(PayoffScript("max(spot)"), std::invalid_argument);
+    REQUIRE_THROWS_AS(PayoffScript("if(spot > 1, 1)"), std::invalid_argument);
+    REQUIRE_THROWS_AS(PayoffScript("at(spot)"), std::invalid_argument);
+    REQUIRE_THROWS_AS(PayoffScript("at(1.5)"), std::invalid_argument);
+    REQUIRE_THROWS_AS(PayoffScript("spot 100"), std::invalid_argument);
+    REQUIRE_THROWS_AS(PayoffScript("spot", {{"max", 1.0}}), std::invalid_argument);
+
+    std::vector<double> payoffs(3);
+    REQUIRE_THROWS_AS(PayoffScript("at(3)")(samplePaths(), payoffs), std::invalid_argument);
+}
+
+TEST_CASE("Payoff script: Matches hand-coded payoffs in Monte Carlo", "[payoff_script][monte_carlo]") {
+    MarketData marketData(100.0, 0.05, 0.2);
+    MonteCarloSettings settings;
+    settings.numPaths = 20000;
+    settings.numSteps = 12;
+    MonteCarloModel model(settings);
+
+    auto asian = model.pricePayoff([](const PathBlock& block, std::vector<double>& payoffs) {
+        for (std::size_t i = 0; i < block.numPaths; ++i) {
+            double sum = 0.0;
+            for (std::size_t step = 1; step <= block.numSteps; ++step) {
+                sum += block.step(step)[i];
+            }
+            payoffs[i] = std::max(sum / block.numSteps - 100.0, 0.0);
+        }
+    }, marketData, 1.0);
+    auto scripted = model.pricePayoff(PayoffScript("max(average - K, 0)", {{"K", 100.0}}), marketData, 1.0);
+    REQUIRE_THAT(scripted.price, WithinAbs(asian.price, 1e-12));
+
+    HestonMonteCarloSettings hestonSettings;
+    hestonSettings.numPaths = 20000;
+    hestonSettings.numSteps = 12;
+    HestonMonteCarloModel heston(HestonParameters(0.04, 1.5, 0.04, 0.5, -0.6), hestonSettings);
+    auto lookback = heston.pricePayoff([](const PathBlock& block, std::vector<double>& payoffs) {
+        for (std::size_t i = 0; i < block.numPaths; ++i) {
+            double low = block.step(0)[i];
+            for (std::size_t step = 1; step <= block.numSteps; ++step) {
+                low = std::min(low, block.step(step)[i]);
+            }
+            payoffs[i] = block.step(block.numSteps)[i] - low;
+        }
+    }, marketData, 1.0);
+    auto scriptedLookback = heston.pricePayoff(PayoffScript("spot - minimum"), marketData, 1.0);
+    REQUIRE_THAT(scriptedLookback.price, WithinAbs(lookback.price, 1e-12));
+}
+
+TEST_CASE("Payoff script: Vanilla call under geometric Brownian motion", "[payoff_script][monte_carlo]") {
+    double S = 100.0, K = 105.0, r = 0.05, sigma = 0.2, T = 0.5;
+    MarketData marketData(S, r, sigma);
+    MonteCarloSettings settings;
+    settings.numSteps = 4;
+    auto result = MonteCarloModel(settings).pricePayoff(PayoffScript("max(spot - 105, 0)"), marketData, T);
+
+    double volSqrtT = sigma * std::sqrt(T);
+    double d1 = (std::log(S / K) + (r + 0.5 * sigma * sigma) * T) / volSqrtT;
+    double expected = S * standardNormalCDF(d1) - K * std::exp(-r * T) * standardNormalCDF(d1 - volSqrtT);
+    REQUIRE_THAT(result.price, WithinAbs(expected, 4.0 * result.standardError));
+}
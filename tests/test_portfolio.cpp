@@ -0,0 +1,137 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+#include "../include/pricing/batch/VersionedPortfolio.hpp"
+
+using namespace pricing;
+using namespace pricing::batch;
+using namespace pricing::core;
+
+namespace {
+    Option position(std::size_t i) {
+        return Option(i % 2 == 0 ? OptionType::Call : OptionType::Put, 50.0 + static_cast<double>(i % 100), 1.0);
+    }
+
+    MarketData market(double spot) {
+        return MarketData(spot, 0.05, 0.2);
+    }
+}
+
+TEST_CASE("Versioned portfolio: Snapshots see committed versions only", "[batch]") {
+    VersionedPortfolio portfolio;
+    REQUIRE(portfolio.snapshot().size() == 0);
+    REQUIRE(portfolio.snapshot().version() == 0);
+
+    const std::size_t rows = 3 * VersionedPortfolio::kChunkRows + 17;
+    for (std::size_t i = 0; i < rows; ++i) {
+        REQUIRE(portfolio.append(position(i), market(100.0)) == i);
+    }
+    REQUIRE(portfolio.size() == rows);
+    REQUIRE(portfolio.snapshot().size() == 0);
+
+    REQUIRE(portfolio.commit() == 1);
+    REQUIRE(portfolio.commit() == 1);       // Nothing changed
+    auto first = portfolio.snapshot();
+    REQUIRE(first.version() == 1);
+    REQUIRE(first.size() == rows);
+
+    portfolio.amendMarketData(5, market(120.0));
+    portfolio.amend(rows - 1, position(7), market(90.0));
+    portfolio.append(position(0), market(80.0));
+    REQUIRE(portfolio.commit() == 2);
+    auto second = portfolio.snapshot();
+
+    // The pinned version is unchanged
+    REQUIRE(first.marketData(5).getSpot() == 100.0);
+    REQUIRE(first.option(rows - 1).getStrike() == position(rows - 1).getStrike());
+    REQUIRE(first.size() == rows);
+
+    REQUIRE(second.marketData(5).getSpot() == 120.0);
+    REQUIRE(second.option(rows - 1).getStrike() == position(7).getStrike());
+    REQUIRE(second.marketData(rows).getSpot() == 80.0);
+    REQUIRE(second.size() == rows + 1);
+
+    auto batch = second.batch(VersionedPortfolio::kChunkRows - 2, rows + 1);
+    REQUIRE(batch.size() == rows + 3 - VersionedPortfolio::kChunkRows);
+    for (std::size_t k = 0; k < batch.size(); ++k) {
+        std::size_t row = VersionedPortfolio::kChunkRows - 2 + k;
+        REQUIRE(batch.strikes[k] == second.option(row).getStrike());
+        REQUIRE(batch.spots[k] == second.marketData(row).getSpot());
+        REQUIRE(batch.types[k] == second.option(row).getType());
+    }
+}
+
+TEST_CASE("Versioned portfolio: Writes copy only the chunks they touch", "[batch]") {
+    VersionedPortfolio portfolio;
+    const std::size_t rows = 10 * VersionedPortfolio::kChunkRows;
+    for (std::size_t i = 0; i < rows; ++i) {
+        portfolio.append(position(i), market(100.0));
+    }
+    portfolio.commit();
+    REQUIRE(portfolio.copiedChunks() == 0);   // Appends fill fresh chunks
+
+    // One copy per chunk and version, however many rows of it change
+    portfolio.amendMarketData(0, market(101.0));
+    portfolio.amendMarketData(1, market(101.0));
+    portfolio.amendMarketData(rows - 1, market(101.0));
+    REQUIRE(portfolio.copiedChunks() == 2);
+    portfolio.commit();
+    portfolio.amendMarketData(2, market(102.0));
+    REQUIRE(portfolio.copiedChunks() == 3);
+
+    // Appending to a partly filled chunk that a snapshot can see copies it
+    portfolio.append(position(0), market(100.0));
+    portfolio.commit();
+    portfolio.append(position(1), market(100.0));
+    REQUIRE(portfolio.copiedChunks() == 4);
+}
+
+TEST_CASE("Versioned portfolio: Readers and a writer run concurrently", "[batch]") {
+    VersionedPortfolio portfolio;
+    const std::size_t rows = 4 * VersionedPortfolio::kChunkRows;
+    for (std::size_t i = 0; i < rows; ++i) {
+        portfolio.append(position(i), market(100.0));
+    }
+    portfolio.commit();
+
+    // Every version moves all spots together: a snapshot must never mix them
+    std::atomic<bool> done{false};
+    std::atomic<std::size_t> torn{0};
+    std::atomic<std::size_t> checked{0};
+    std::thread reader([&]() {
+        while (!done || checked == 0) {
+            auto snapshot = portfolio.snapshot();
+            auto batch = snapshot.batch(0, snapshot.size());
+            double expected = 100.0 + static_cast<double>(snapshot.version() - 1);
+            for (std::size_t k = 0; k < rows; ++k) {
+                torn += batch.spots[k] != expected ? 1 : 0;
+            }
+            ++checked;
+        }
+    });
+    for (int version = 2; version <= 20; ++version) {
+        for (std::size_t i = 0; i < rows; ++i) {
+            portfolio.amendMarketData(i, market(100.0 + version - 1));
+        }
+        portfolio.commit();
+    }
+    done = true;
+    reader.join();
+
+    REQUIRE(checked > 0);
+    REQUIRE(torn == 0);
+    REQUIRE(portfolio.snapshot().version() == 20);
+}
+
+TEST_CASE("Versioned portfolio: Validation", "[validation]") {
+    VersionedPortfolio portfolio;
+    portfolio.append(position(0), market(100.0));
+    REQUIRE_THROWS_AS(portfolio.amend(1, position(0), market(100.0)), std::out_of_range);
+    REQUIRE_THROWS_AS(portfolio.snapshot().option(0), std::out_of_range);
+    portfolio.commit();
+    REQUIRE_THROWS_AS(portfolio.snapshot().batch(0, 2), std::out_of_range);
+    REQUIRE_THROWS_AS(PortfolioSnapshot().marketData(0), std::out_of_range);
+}
@@ -0,0 +1,135 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "../include/pricing/core/HestonParameters.hpp"
+#include "../include/pricing/core/MarketData.hpp"
+#include "../include/pricing/core/Option.hpp"
+#include "../include/pricing/models/ChebyshevProxy.hpp"
+#include "../include/pricing/models/HestonModel.hpp"
+#include "../include/pricing/numerics/ChebyshevTensor.hpp"
+
+using namespace pricing;
+using namespace pricing::core;
+using namespace pricing::models;
+using Catch::Matchers::WithinAbs;
+
+TEST_CASE("Numerics: Chebyshev tensor reproduces a smooth function", "[proxy]") {
+    numerics::ChebyshevTensor tensor({-1.0, 0.5, 2.0}, {1.0, 2.5, 3.0}, {14, 16, 6});
+    auto f = [](double x, double y, double z) { return std::exp(0.5 * x) * std::sin(y) + z * z; };
+
+    auto xs = tensor.points(0), ys = tensor.points(1), zs = tensor.points(2);
+    std::vector<double> values;
+    for (double x : xs) {
+        for (double y : ys) {
+            for (double z : zs) {
+                values.push_back(f(x, y, z));
+            }
+        }
+    }
+    tensor.fit(values);
+
+    for (double x : {-0.9, 0.1, 0.77}) {
+        for (double y : {0.6, 1.3, 2.4}) {
+            for (double z : {2.0, 2.35, 3.0}) {
+                double point[] = {x, y, z};
+                REQUIRE_THAT(tensor.evaluate(point), WithinAbs(f(x, y, z), 1e-10));
+            }
+        }
+    }
+
+    // A smaller tensor evaluated in between does not disturb the larger one
+    numerics::ChebyshevTensor line({0.0}, {1.0}, {5});
+    std::vector<double> linear;
+    for (double x : line.points(0)) {
+        linear.push_back(3.0 * x - 1.0);
+    }
+    line.fit(linear);
+    double middle[] = {0.5};
+    REQUIRE_THAT(line.evaluate(middle), WithinAbs(0.5, 1e-12));
+    double point[] = {0.1, 1.3, 2.35};
+    REQUIRE_THAT(tensor.evaluate(point), WithinAbs(f(0.1, 1.3, 2.35), 1e-10));
+}
+
+TEST_CASE("Chebyshev proxy: Heston prices over spot and maturity", "[proxy][heston]") {
+    HestonParameters parameters(0.04, 1.5, 0.04, 0.5, -0.6);
+    HestonModel heston(parameters);
+    Option reference(OptionType::Call, 100.0, 1.0);
+    MarketData referenceMarket(100.0, 0.03, 0.2);
+
+    auto proxy = ChebyshevProxy::build(heston, reference, referenceMarket,
+                                       {{ProxyParameter::Spot, 70.0, 130.0, 24},
+                                        {ProxyParameter::Maturity, 0.25, 2.0, 12}});
+
+    for (double S : {75.0, 98.5, 112.0, 129.0}) {
+        for (double T : {0.3, 1.1, 1.9}) {
+            Option option(OptionType::Call, 100.0, T);
+            MarketData marketData(S, 0.03, 0.2);
+            REQUIRE_THAT(proxy.price(option, marketData).price,
+                         WithinAbs(heston.price(option, marketData).price, 1e-3));
+        }
+    }
+
+    REQUIRE_THROWS_AS(proxy.price(Option(OptionType::Call, 100.0, 1.0), MarketData(140.0, 0.03, 0.2)),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(proxy.price(Option(OptionType::Call, 95.0, 1.0), MarketData(100.0, 0.03, 0.2)),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(proxy.price(Option(OptionType::Put, 100.0, 1.0), MarketData(100.0, 0.03, 0.2)),
+                      std::invalid_argument);
+}
+
+TEST_CASE("Chebyshev proxy: Save and map from file", "[proxy]") {
+    HestonModel heston(HestonParameters(0.04, 1.5, 0.04, 0.5, -0.6));
+    auto proxy = ChebyshevProxy::build(heston, Option(OptionType::Put, 100.0, 0.5), MarketData(100.0, 0.03, 0.2),
+                                       {{ProxyParameter::Strike, 80.0, 120.0, 10},
+                                        {ProxyParameter::Rate, 0.0, 0.06, 4}});
+
+    std::string path = "test_proxy.cheb";
+    proxy.save(path);
+    auto loaded = ChebyshevProxy::load(path);
+
+    // Option type and exercise style are stored as 32-bit fields after the magic
+    for (std::streamoff offset : {8, 12}) {
+        std::string copy = "test_proxy_bad.cheb";
+        {
+            std::ifstream in(path, std::ios::binary);
+            std::ofstream out(copy, std::ios::binary);
+            out << in.rdbuf();
+            std::uint32_t unknown = 7;
+            out.seekp(offset);
+            out.write(reinterpret_cast<const char*>(&unknown), sizeof(unknown));
+        }
+        REQUIRE_THROWS_AS(ChebyshevProxy::load(copy), std::runtime_error);
+        std::remove(copy.c_str());
+    }
+    std::remove(path.c_str());
+
+    REQUIRE(loaded.getParameters() == proxy.getParameters());
+    for (double K : {82.0, 100.0, 117.0}) {
+        Option option(OptionType::Put, K, 0.5);
+        MarketData marketData(100.0, 0.045, 0.2);
+        REQUIRE(loaded.price(option, marketData).price == proxy.price(option, marketData).price);
+    }
+
+    REQUIRE_THROWS_AS(ChebyshevProxy::load("missing_proxy.cheb"), std::runtime_error);
+}
+
+TEST_CASE("Chebyshev proxy: Validation", "[validation]") {
+    HestonModel heston(HestonParameters(0.04, 1.5, 0.04, 0.5, -0.6));
+    Option option(OptionType::Call, 100.0, 1.0);
+    MarketData marketData(100.0, 0.03, 0.2);
+
+    REQUIRE_THROWS_AS(ChebyshevProxy::build(heston, option, marketData, {}), std::invalid_argument);
+    REQUIRE_THROWS_AS(ChebyshevProxy::build(heston, option, marketData, {{ProxyParameter::Spot, 120.0, 80.0, 8}}),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(ChebyshevProxy::build(heston, option, marketData,
+                                            {{ProxyParameter::Spot, 80.0, 120.0, 8},
+                                             {ProxyParameter::Spot, 80.0, 120.0, 8}}),
+                      std::invalid_argument);
+}
@@ -0,0 +1,173 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "../include/pricing/batch/ResultCache.hpp"
+
+using namespace pricing;
+using namespace pricing::batch;
+
+namespace {
+    core::PricingResult sampleResult(double price) {
+        core::PricingResult result;
+        result.price = price;
+        result.delta = 0.5;
+        result.gamma = 0.02;
+        result.vega = 30.0;
+        result.theta = -4.0;
+        result.rho = 20.0;
+        return result;
+    }
+
+    util::ContentKey keyOf(int index) {
+        return ResultCache::key("row-" + std::to_string(index));
+    }
+}
+
+TEST_CASE("Result cache: Results persist across runs", "[cache]") {
+    std::string path = "test_result_cache.bin";
+    std::remove(path.c_str());
+    {
+        ResultCache cache(path);
+        core::PricingResult result;
+        REQUIRE_FALSE(cache.find(keyOf(1), result));
+        cache.store(keyOf(1), sampleResult(6.5));
+        REQUIRE(cache.size() == 1);
+    }
+    {
+        ResultCache cache(path);
+        REQUIRE(cache.generation() == 2);
+        core::PricingResult result;
+        REQUIRE(cache.find(keyOf(1), result));
+        REQUIRE(result.price == 6.5);
+        REQUIRE(result.rho == 20.0);
+        REQUIRE_FALSE(cache.find(keyOf(2), result));
+        REQUIRE(cache.hits() == 1);
+        REQUIRE(cache.misses() == 1);
+    }
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Result cache: Table grows beyond its initial capacity", "[cache]") {
+    std::string path = "test_result_cache_grow.bin";
+    std::remove(path.c_str());
+    ResultCacheSettings settings;
+    settings.initialCapacity = 16;
+    {
+        ResultCache cache(path, settings);
+        for (int i = 0; i < 1000; ++i) {
+            cache.store(keyOf(i), sampleResult(i));
+        }
+        REQUIRE(cache.size() == 1000);
+        REQUIRE(cache.capacity() >= 1024);
+    }
+    ResultCache cache(path, settings);
+    core::PricingResult result;
+    for (int i = 0; i < 1000; ++i) {
+        REQUIRE(cache.find(keyOf(i), result));
+        REQUIRE(result.price == i);
+    }
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Result cache: Size limit evicts least recently used runs", "[cache]") {
+    std::string path = "test_result_cache_limit.bin";
+    std::remove(path.c_str());
+    ResultCacheSettings settings;
+    settings.maxEntries = 100;
+    {
+        ResultCache cache(path, settings);
+        for (int i = 0; i < 100; ++i) {
+            cache.store(keyOf(i), sampleResult(i));
+        }
+    }
+    {
+        // The next run touches the first ten rows and adds new ones
+        ResultCache cache(path, settings);
+        core::PricingResult result;
+        for (int i = 0; i < 10; ++i) {
+            REQUIRE(cache.find(keyOf(i), result));
+        }
+        cache.store(keyOf(1000), sampleResult(1000));
+        REQUIRE(cache.size() <= 100);
+        for (int i = 0; i < 10; ++i) {
+            REQUIRE(cache.find(keyOf(i), result));
+        }
+        REQUIRE(cache.find(keyOf(1000), result));
+    }
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Result cache: Compaction drops stale entries", "[cache]") {
+    std::string path = "test_result_cache_compact.bin";
+    std::remove(path.c_str());
+    {
+        ResultCache cache(path);
+        cache.store(keyOf(1), sampleResult(1.0));
+        cache.store(keyOf(2), sampleResult(2.0));
+    }
+    {
+        ResultCache cache(path);
+        core::PricingResult result;
+        REQUIRE(cache.find(keyOf(2), result));
+        cache.store(keyOf(3), sampleResult(3.0));
+        cache.compact(1);
+        REQUIRE(cache.size() == 2);
+        REQUIRE_FALSE(cache.find(keyOf(1), result));
+        REQUIRE(cache.find(keyOf(3), result));
+    }
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Result cache: Foreign or damaged files are refused", "[cache]") {
+    std::string path = "test_result_cache_damaged.bin";
+    std::string content = "type,spot,strike\ncall,100,105\n";
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << content;
+    }
+    REQUIRE_THROWS_AS(ResultCache(path), std::runtime_error);
+    {
+        std::ifstream file(path, std::ios::binary);
+        REQUIRE(std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()) == content);
+    }
+
+    // An empty file is a new cache
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    }
+    ResultCache cache(path);
+    core::PricingResult result;
+    REQUIRE(cache.size() == 0);
+    REQUIRE_FALSE(cache.find(keyOf(1), result));
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Result cache: A failed rebuild keeps the current table", "[cache]") {
+    std::string path = "test_result_cache_rebuild.bin";
+    std::string temporary = path + ".tmp";
+    std::remove(path.c_str());
+    {
+        ResultCache cache(path);
+        cache.store(keyOf(1), sampleResult(1.0));
+
+        // A directory in place of the temporary file makes the rebuild fail
+        std::filesystem::create_directory(temporary);
+        REQUIRE_THROWS_AS(cache.compact(), std::runtime_error);
+        std::filesystem::remove(temporary);
+
+        core::PricingResult result;
+        REQUIRE(cache.find(keyOf(1), result));
+        REQUIRE(result.price == 1.0);
+        cache.store(keyOf(2), sampleResult(2.0));
+        cache.compact();
+        REQUIRE(cache.size() == 2);
+    }
+    ResultCache reopened(path);
+    REQUIRE(reopened.size() == 2);
+    std::remove(path.c_str());
+}
@@ -0,0 +1,145 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "../include/pricing/batch/SpotLadderCache.hpp"
+#include "../include/pricing/models/BlackScholesModel.hpp"
+#include "../include/pricing/numerics/MonotoneSpline.hpp"
+
+using namespace pricing;
+using namespace pricing::batch;
+using namespace pricing::core;
+using Catch::Matchers::WithinAbs;
+
+namespace {
+    PricingResult exact(const Option& option, double spot, double volatility = 0.2) {
+        return models::BlackScholesModel().priceWithGreeks(option, MarketData(spot, 0.05, volatility));
+    }
+}
+
+TEST_CASE("Monotone spline: Interpolates knots and stays monotone", "[numerics]") {
+    std::vector<double> linear = {1.0, 3.0, 5.0, 7.0, 9.0};
+    numerics::MonotoneSpline line(0.0, 4.0, linear);
+    for (double x = -0.5; x <= 4.5; x += 0.125) {
+        REQUIRE_THAT(line(x), WithinAbs(1.0 + 2.0 * x, 1e-12));
+    }
+
+    // A step: a natural cubic would overshoot on both sides
+    std::vector<double> step = {0.0, 0.0, 0.0, 1.0, 1.0, 1.0};
+    numerics::MonotoneSpline monotone(10.0, 20.0, step);
+    for (std::size_t i = 0; i < step.size(); ++i) {
+        REQUIRE_THAT(monotone(10.0 + 2.0 * static_cast<double>(i)), WithinAbs(step[i], 1e-12));
+    }
+    double previous = monotone(10.0);
+    for (double x = 10.0; x <= 20.0; x += 0.01) {
+        double value = monotone(x);
+        REQUIRE(value >= previous - 1e-12);
+        REQUIRE(value >= -1e-12);
+        REQUIRE(value <= 1.0 + 1e-12);
+        previous = value;
+    }
+
+    REQUIRE(monotone.contains(15.0));
+    REQUIRE_FALSE(monotone.contains(20.5));
+    REQUIRE_THROWS_AS(numerics::MonotoneSpline(0.0, 1.0, {1.0}), std::invalid_argument);
+    REQUIRE_THROWS_AS(numerics::MonotoneSpline(1.0, 1.0, {1.0, 2.0}), std::invalid_argument);
+}
+
+TEST_CASE("Spot ladder cache: Quotes inside the band match Black-Scholes", "[batch]") {
+    for (OptionType type : {OptionType::Call, OptionType::Put}) {
+        Option option(type, 100.0, 0.5);
+        SpotLadderCache cache(option, MarketData(100.0, 0.05, 0.2));
+        for (double spot = 97.0; spot <= 103.0; spot += 0.37) {
+            PricingResult quote = cache.quote(spot);
+            PricingResult expected = exact(option, spot);
+            REQUIRE_THAT(quote.price, WithinAbs(expected.price, 1e-4));
+            REQUIRE_THAT(quote.delta, WithinAbs(expected.delta, 1e-4));
+            REQUIRE(quote.gamma == 0.0);
+        }
+        REQUIRE(cache.exactQuotes() == 0);
+        REQUIRE(cache.ladderQuotes() > 0);
+    }
+}
+
+TEST_CASE("Spot ladder cache: Recentres when the spot drifts", "[batch]") {
+    Option option(OptionType::Call, 100.0, 1.0);
+    SpotLadderCache cache(option, MarketData(100.0, 0.05, 0.2));
+    REQUIRE(cache.ladderCenter() == 100.0);
+
+    // Near the band edge: served from the old ladder, rebuilt around this spot
+    PricingResult quote = cache.quote(104.0);
+    REQUIRE(cache.ladderQuotes() == 1);
+    REQUIRE_THAT(quote.price, WithinAbs(exact(option, 104.0).price, 1e-4));
+    REQUIRE(cache.ladderCenter() == 104.0);
+
+    // A jump out of the band is priced exactly and recentres too
+    quote = cache.quote(120.0);
+    REQUIRE(cache.exactQuotes() == 1);
+    REQUIRE_THAT(quote.price, WithinAbs(exact(option, 120.0).price, 1e-12));
+    REQUIRE(cache.ladderCenter() == 120.0);
+    REQUIRE_THAT(cache.quote(121.0).price, WithinAbs(exact(option, 121.0).price, 1e-4));
+    REQUIRE(cache.exactQuotes() == 1);
+}
+
+TEST_CASE("Spot ladder cache: Background rebuild after a volatility change", "[batch]") {
+    auto rebuilder = std::make_shared<LadderRebuilder>();
+    std::vector<std::unique_ptr<SpotLadderCache>> caches;
+    for (std::size_t i = 0; i < 8; ++i) {
+        Option option(i % 2 == 0 ? OptionType::Call : OptionType::Put, 90.0 + 5.0 * static_cast<double>(i), 0.75);
+        caches.push_back(std::make_unique<SpotLadderCache>(option, MarketData(100.0, 0.05, 0.2),
+                                                           SpotLadderSettings(), rebuilder));
+    }
+
+    for (auto& cache : caches) {
+        Option option(OptionType::Call, 100.0, 0.75);
+        cache->update(option, MarketData(100.0, 0.05, 0.3));
+        // Until the new ladder arrives no quote comes from the retired one
+        PricingResult quote = cache->quote(100.5);
+        if (cache->exactQuotes() == 1) {
+            REQUIRE_THAT(quote.price, WithinAbs(exact(option, 100.5, 0.3).price, 1e-12));
+        } else {
+            REQUIRE_THAT(quote.price, WithinAbs(exact(option, 100.5, 0.3).price, 1e-4));
+        }
+    }
+    rebuilder->waitIdle();
+    REQUIRE(rebuilder->laddersBuilt() >= caches.size());
+
+    Option option(OptionType::Call, 100.0, 0.75);
+    for (auto& cache : caches) {
+        std::size_t exactBefore = cache->exactQuotes();
+        REQUIRE_THAT(cache->quote(101.0).price, WithinAbs(exact(option, 101.0, 0.3).price, 1e-4));
+        REQUIRE(cache->exactQuotes() == exactBefore);
+    }
+
+    // A spot-only update keeps the ladder
+    caches[0]->update(option, MarketData(102.0, 0.05, 0.3));
+    REQUIRE_THAT(caches[0]->quote(102.0).price, WithinAbs(exact(option, 102.0, 0.3).price, 1e-4));
+
+    caches.clear();                 // Destroying caches with rebuilds outstanding is safe
+}
+
+TEST_CASE("Spot ladder cache: Validation", "[validation]") {
+    Option option(OptionType::Call, 100.0, 1.0);
+    MarketData marketData(100.0, 0.05, 0.2);
+    SpotLadderSettings settings;
+    settings.bandWidth = 0.0;
+    REQUIRE_THROWS_AS(SpotLadderCache(option, marketData, settings), std::invalid_argument);
+
+    settings = SpotLadderSettings();
+    settings.nodes = 3;
+    REQUIRE_THROWS_AS(SpotLadderCache(option, marketData, settings), std::invalid_argument);
+
+    settings = SpotLadderSettings();
+    settings.recenterAt = 1.5;
+    REQUIRE_THROWS_AS(SpotLadderCache(option, marketData, settings), std::invalid_argument);
+
+    Option american(OptionType::Put, 100.0, 1.0, ExerciseStyle::American);
+    REQUIRE_THROWS_AS(SpotLadderCache(american, marketData), std::invalid_argument);
+
+    SpotLadderCache cache(option, marketData);
+    REQUIRE_THROWS_AS(cache.quote(-1.0), std::invalid_argument);
+}
@@ -0,0 +1,80 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+#include "../include/pricing/batch/WorkPlanner.hpp"
+
+using namespace pricing;
+using namespace pricing::batch;
+
+namespace {
+    // Every unit of every file is covered by exactly one span, in order
+    void requireCoverage(const std::vector<WorkFile>& files, const std::vector<WorkItem>& items) {
+        std::map<std::size_t, std::vector<WorkSpan>> spans;
+        for (const auto& item : items) {
+            for (const auto& span : item.spans) {
+                REQUIRE(span.begin < span.end);
+                spans[span.file].push_back(span);
+            }
+        }
+        for (std::size_t file = 0; file < files.size(); ++file) {
+            auto& fileSpans = spans[file];
+            std::sort(fileSpans.begin(), fileSpans.end(),
+                      [](const WorkSpan& a, const WorkSpan& b) { return a.begin < b.begin; });
+            std::size_t covered = 0;
+            for (const auto& span : fileSpans) {
+                REQUIRE(span.begin == covered);
+                covered = span.end;
+            }
+            REQUIRE(covered == files[file].units);
+        }
+    }
+}
+
+TEST_CASE("Work planner: Large files are split and small files packed", "[batch]") {
+    std::vector<WorkFile> files(10);
+    files[0].units = 10000;               // Split into three items
+    for (std::size_t i = 1; i < files.size(); ++i) {
+        files[i].units = 1000;            // Packed four to an item
+    }
+    files[5].units = 0;
+
+    auto items = planWork(files, 4000.0);
+    requireCoverage(files, items);
+
+    REQUIRE(items.size() == 5);
+    for (std::size_t k = 0; k + 1 < items.size(); ++k) {
+        REQUIRE(items[k].cost >= items[k + 1].cost);
+    }
+    std::size_t splitItems = 0;
+    for (const auto& item : items) {
+        REQUIRE(item.cost <= 4000.0);
+        splitItems += item.spans.size() == 1 && item.spans[0].file == 0 ? 1 : 0;
+    }
+    REQUIRE(splitItems == 3);
+}
+
+TEST_CASE("Work planner: Unit costs weight the split", "[batch]") {
+    std::vector<WorkFile> files(2);
+    files[0].units = 100;
+    files[0].unitCost = 1000.0;           // A numerical-model file: split by cost, not rows
+    files[1].units = 100;
+
+    auto items = planWork(files, 4096.0);
+    requireCoverage(files, items);
+
+    REQUIRE(items.size() == 26);
+    for (const auto& item : items) {
+        REQUIRE(item.cost <= 5000.0);
+    }
+    REQUIRE(items.back().spans.size() == 1);
+    REQUIRE(items.back().spans[0].file == 1);
+}
+
+TEST_CASE("Work planner: Validation", "[validation]") {
+    REQUIRE_THROWS_AS(planWork({WorkFile()}, 0.0), std::invalid_argument);
+    REQUIRE(planWork({}, 1.0).empty());
+}